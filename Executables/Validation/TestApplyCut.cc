@@ -18,7 +18,7 @@ using namespace std;
 int main()
 {
     KTDataPtr dataPtr(new KTData());
-    KTTestData& testData = dataPtr->Of< KTTestData >();
+    dataPtr->Of< KTTestData >();
 
     KTCutStatus& cutStatus = dataPtr->GetCutStatus();
     KTINFO(testlog, "Initial cut state: " << cutStatus.IsCut());
@@ -0,0 +1,86 @@
+/*
+ * TestApplyCuts.cc
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: nsoblath
+ */
+
+#include "KTTestCuts.hh"
+
+#include "KTApplyCuts.hh"
+#include "KTLogger.hh"
+
+KTLOGGER(testlog, "TestApplyCuts");
+
+using namespace Nymph;
+using namespace std;
+
+KTDataPtr MakeData(bool isAwesome)
+{
+    KTDataPtr dataPtr(new KTData());
+    dataPtr->Of< KTTestData >().SetIsAwesome(isAwesome);
+    return dataPtr;
+}
+
+int main()
+{
+    KTApplyCuts applyCuts;
+    applyCuts.AddCut(new KTAwesomeCut(), "awesome-cut");
+    applyCuts.AddCut(new KTNotAwesomeCut(), "not-awesome-cut");
+
+    KTINFO(testlog, "Applying both cuts");
+    KTDataPtr dataPtr = MakeData(false);
+    KTCutStatus& cutStatus = dataPtr->GetCutStatus();
+    bool isCut = applyCuts.Apply(dataPtr);
+    KTINFO(testlog, "Cuts present: " << cutStatus.CutResultsPresent());
+    KTINFO(testlog, "Is cut? " << isCut);
+    if (! isCut || ! cutStatus.HasCutResult("awesome-cut") || ! cutStatus.HasCutResult("not-awesome-cut"))
+    {
+        KTERROR(testlog, "Both cuts should have been applied, and the data cut");
+        return -1;
+    }
+
+    KTINFO(testlog, "Short-circuiting");
+    applyCuts.SetShortCircuit(true);
+    dataPtr = MakeData(false);
+    isCut = applyCuts.Apply(dataPtr);
+    KTINFO(testlog, "Cuts present: " << dataPtr->GetCutStatus().CutResultsPresent());
+    if (! isCut || dataPtr->GetCutStatus().HasCutResult("not-awesome-cut"))
+    {
+        KTERROR(testlog, "The not-awesome cut should not have been applied after the awesome cut failed");
+        return -1;
+    }
+
+    KTINFO(testlog, "Reordering");
+    KTApplyCuts reorderCuts;
+    reorderCuts.AddCut(new KTAwesomeCut(), "awesome-cut");
+    reorderCuts.AddCut(new KTNotAwesomeCut(), "not-awesome-cut");
+    reorderCuts.SetShortCircuit(true);
+    reorderCuts.SetReorderInterval(4);
+    for (unsigned iData = 0; iData < 4; ++iData)
+    {
+        reorderCuts.Apply(MakeData(true));
+    }
+    vector< string > order = reorderCuts.GetOrder();
+    KTINFO(testlog, "First cut is now <" << order.front() << ">");
+    if (order.front() != "not-awesome-cut")
+    {
+        KTERROR(testlog, "The cut that rejected all of the data should be applied first");
+        return -1;
+    }
+
+    // with the rejecting cut first, the other isn't applied any more
+    reorderCuts.Apply(MakeData(true));
+    vector< KTApplyCuts::CutStats > stats = reorderCuts.GetCutStats();
+    for (vector< KTApplyCuts::CutStats >::const_iterator it = stats.begin(); it != stats.end(); ++it)
+    {
+        KTINFO(testlog, it->fName << ": applied " << it->fNApplied << ", failed " << it->fNFailed);
+    }
+    if (stats[0].fNApplied != 4 || stats[1].fNApplied != 5)
+    {
+        KTERROR(testlog, "Unexpected number of applications after reordering");
+        return -1;
+    }
+
+    return 0;
+}
@@ -14,6 +14,38 @@ KTLOGGER(testlog, "TestCut");
 using namespace Nymph;
 using namespace std;
 
+namespace Nymph
+{
+    struct KTSecondTestData : public KTExtensibleData< KTSecondTestData >
+    {
+        static const std::string sName;
+    };
+    const std::string KTSecondTestData::sName("second-test-data");
+
+    struct KTThirdTestData : public KTExtensibleData< KTThirdTestData >
+    {
+        static const std::string sName;
+    };
+    const std::string KTThirdTestData::sName("third-test-data");
+
+    // Cuts data that is awesome; doesn't record a result, so the cut summary is unchanged
+    class KTThreeArgCut : public KTCutOnData< KTTestData, KTSecondTestData, KTThirdTestData >
+    {
+        public:
+            KTThreeArgCut() : KTCutOnData< KTTestData, KTSecondTestData, KTThirdTestData >("three-arg-cut"), fNApplied(0) {}
+
+            bool Configure(const scarab::param_node&) {return true;}
+
+            bool Apply(KTData&, KTTestData& testData, KTSecondTestData&, KTThirdTestData&)
+            {
+                ++fNApplied;
+                return testData.GetIsAwesome();
+            }
+
+            unsigned fNApplied;
+    };
+}
+
 int main()
 {
     KTData data;
@@ -57,5 +89,43 @@ int main()
     KTINFO(testlog, "Is cut with mask 2? " << cutStatus.IsCut(2));
     KTINFO(testlog, "Is cut with mask 3? " << cutStatus.IsCut(3));
 
+    KTINFO(testlog, "Applying the cuts in the opposite order to another data object");
+    KTData reversed;
+    KTTestData& reversedTestData = reversed.Of< KTTestData >();
+    naCut.Apply(reversed, reversedTestData);
+    cut.Apply(reversed, reversedTestData);
+    KTCutStatus& reversedStatus = reversed.GetCutStatus();
+    KTINFO(testlog, "Cuts present: " << reversedStatus.CutResultsPresent());
+    KTINFO(testlog, reversedStatus);
+    if (reversedStatus.IsCut(1) != cutStatus.IsCut(1) || reversedStatus.IsCut(2) != cutStatus.IsCut(2) ||
+            reversedStatus.CutResultsPresent() != cutStatus.CutResultsPresent())
+    {
+        KTERROR(testlog, "Cut bits depend on the order in which the cuts were applied");
+        return -1;
+    }
+    if (KTAwesomeCut::Result::Bit() != KTCutRegistry::get_instance()->GetBit("awesome-cut"))
+    {
+        KTERROR(testlog, "Cut bit by type and by name do not match");
+        return -1;
+    }
+
+    KTINFO(testlog, "Applying a cut on three data types");
+    KTThreeArgCut threeArgCut;
+    KTDataPtr threeDataPtr(new KTData());
+    threeDataPtr->Of< KTTestData >().SetIsAwesome(true);
+    threeDataPtr->Of< KTThirdTestData >();
+    KTCut& threeArgBase = threeArgCut;
+    if (threeArgBase.Apply(threeDataPtr) || threeArgCut.fNApplied != 0)
+    {
+        KTERROR(testlog, "Cut was applied with a data type missing");
+        return -1;
+    }
+    threeDataPtr->Of< KTSecondTestData >();
+    if (! threeArgBase.Apply(threeDataPtr) || threeArgCut.fNApplied != 1)
+    {
+        KTERROR(testlog, "Cut was not applied with all of its data types present");
+        return -1;
+    }
+
     return 0;
 }
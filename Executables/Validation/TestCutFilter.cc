@@ -19,7 +19,7 @@ using namespace std;
 int main()
 {
     KTDataPtr dataPtr(new KTData());
-    KTTestData& testData = dataPtr->Of< KTTestData >();
+    dataPtr->Of< KTTestData >();
 
     KTCutStatus& cutStatus = dataPtr->GetCutStatus();
     KTINFO(testlog, "Initial cut state: " << cutStatus.IsCut());
@@ -79,5 +79,62 @@ int main()
     cutFilter.SetCutMask(3);
     KTINFO(testlog, "Is cut with mask 3? " << cutFilter.Filter(data));
 
+    KTINFO(testlog, "Testing filter set with an expression");
+    struct ExpressionTest
+    {
+        const char* fExpression;
+        bool fIsCut;
+    };
+    const ExpressionTest expressionTests[] = {
+        {"awesome-cut", true},
+        {"not-awesome-cut", false},
+        {"awesome-cut && !not-awesome-cut", true},
+        {"awesome-cut && not-awesome-cut", false},
+        {"!(awesome-cut || not-awesome-cut)", false},
+        {"!awesome-cut || not-awesome-cut", false},
+        {"(awesome-cut || not-awesome-cut) && !(awesome-cut && not-awesome-cut)", true},
+        {"!!awesome-cut", true}
+    };
+    for (unsigned iTest = 0; iTest < sizeof(expressionTests) / sizeof(ExpressionTest); ++iTest)
+    {
+        if (! cutFilter.SetCutExpression(expressionTests[iTest].fExpression))
+        {
+            KTERROR(testlog, "Unable to set expression <" << expressionTests[iTest].fExpression << ">");
+            return -1;
+        }
+        bool isCut = cutFilter.Filter(data);
+        KTINFO(testlog, "Is cut with expression <" << expressionTests[iTest].fExpression << ">? " << isCut
+                << " (" << cutFilter.GetCutExpression().GetNInstructions() << " instructions)");
+        if (isCut != expressionTests[iTest].fIsCut)
+        {
+            KTERROR(testlog, "Expected " << expressionTests[iTest].fIsCut);
+            return -1;
+        }
+    }
+
+    cutFilter.SetCutExpression("awesome-cut && !(not-awesome-cut)");
+    if (cutFilter.GetCutExpression().GetNInstructions() != 3)
+    {
+        KTERROR(testlog, "Expression was not reduced to masks");
+        return -1;
+    }
+
+    KTINFO(testlog, "Testing invalid expressions (errors are expected)");
+    const char* invalidExpressions[] = {"awesome-cut &&", "(awesome-cut", "unknown-cut", "awesome-cut & not-awesome-cut", ""};
+    for (unsigned iTest = 0; iTest < sizeof(invalidExpressions) / sizeof(const char*); ++iTest)
+    {
+        if (cutFilter.SetCutExpression(invalidExpressions[iTest]))
+        {
+            KTERROR(testlog, "Invalid expression <" << invalidExpressions[iTest] << "> was accepted");
+            return -1;
+        }
+    }
+    if (cutFilter.GetCutExpression().GetExpression() != "awesome-cut && !(not-awesome-cut)")
+    {
+        KTERROR(testlog, "Invalid expression replaced the previous one");
+        return -1;
+    }
+
+    KTINFO(testlog, "Tests complete");
     return 0;
 }
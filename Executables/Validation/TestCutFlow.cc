@@ -0,0 +1,186 @@
+/*
+ * TestCutFlow.cc
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: nsoblath
+ */
+
+#include "KTTestCuts.hh"
+
+#include "KTCutFlow.hh"
+#include "KTLogger.hh"
+
+#include <boost/thread.hpp>
+
+#include <sstream>
+
+KTLOGGER(testlog, "TestCutFlow");
+
+using namespace Nymph;
+using namespace std;
+
+void ApplyCuts(bool isAwesome)
+{
+    KTData data;
+    KTTestData& testData = data.Of< KTTestData >();
+    testData.SetIsAwesome(isAwesome);
+    KTAwesomeCut cut;
+    cut.Apply(data, testData);
+    KTNotAwesomeCut naCut;
+    naCut.Apply(data, testData);
+    return;
+}
+
+void ApplyCutsRepeatedly(unsigned nData)
+{
+    for (unsigned iData = 0; iData < nData; ++iData)
+    {
+        ApplyCuts(true);
+    }
+    return;
+}
+
+bool CheckEntry(const KTCutFlow::Entry& entry, const string& name, uint64_t nApplied, uint64_t nFailed, uint64_t nExclusive, uint64_t nCumulative)
+{
+    KTINFO(testlog, entry.fName << ": applied " << entry.fNApplied << ", passed " << entry.fNPassed << ", failed " << entry.fNFailed
+            << ", exclusive " << entry.fNExclusive << ", cumulative " << entry.fNCumulative);
+    return entry.fName == name && entry.fNApplied == nApplied && entry.fNPassed == nApplied - nFailed && entry.fNFailed == nFailed &&
+            entry.fNExclusive == nExclusive && entry.fNCumulative == nCumulative;
+}
+
+int main()
+{
+    // the cut results are registered by KT_REGISTER_CUT
+    vector< string > order;
+    order.push_back("awesome-cut");
+    order.push_back("not-awesome-cut");
+    if (! KTCutFlow::SetOrder(order))
+    {
+        KTERROR(testlog, "Unable to set the order of the cut flow");
+        return -1;
+    }
+
+    KTINFO(testlog, "Applying cuts with the cut flow disabled");
+    ApplyCuts(true);
+    if (KTCutFlow::GetSummary().fNData != 0)
+    {
+        KTERROR(testlog, "Data was recorded while the cut flow was disabled");
+        return -1;
+    }
+
+    KTCutFlow::SetIsEnabled(true);
+
+    KTINFO(testlog, "Applying cuts to awesome and not-awesome data");
+    for (unsigned iData = 0; iData < 3; ++iData) ApplyCuts(true);
+    for (unsigned iData = 0; iData < 2; ++iData) ApplyCuts(false);
+    {
+        KTData data;
+        data.GetCutStatus().AddCutResult< KTAwesomeCut::Result >(true);
+        data.GetCutStatus().AddCutResult("not-awesome-cut", true);
+        // a copy isn't recorded unless cuts are applied to it
+        KTData copy(data);
+    }
+    {
+        // a copy that has a cut applied to it is recorded with only that cut; the inherited one is recorded with the original
+        KTData data;
+        data.GetCutStatus().AddCutResult< KTAwesomeCut::Result >(false);
+        KTData copy(data);
+        copy.GetCutStatus().AddCutResult("not-awesome-cut", true);
+    }
+    {
+        // resetting keeps the record of the data object, and the status can then be used again
+        KTData data;
+        data.GetCutStatus().AddCutResult< KTAwesomeCut::Result >(false);
+        data.GetCutStatus().Reset();
+    }
+
+    KTCutFlow::Summary summary = KTCutFlow::GetSummary();
+    KTINFO(testlog, "Data objects: " << summary.fNData << "; rejected: " << summary.fNRejected);
+    if (summary.fNData != 9 || summary.fNRejected != 7 || summary.fEntries.size() != 2)
+    {
+        KTERROR(testlog, "Unexpected number of data objects or cuts");
+        return -1;
+    }
+    if (! CheckEntry(summary.fEntries[0], "awesome-cut", 8, 3, 2, 3) || ! CheckEntry(summary.fEntries[1], "not-awesome-cut", 7, 5, 4, 7))
+    {
+        KTERROR(testlog, "Unexpected cut flow");
+        return -1;
+    }
+
+    stringstream table;
+    KTCutFlow::PrintTable(table);
+    KTINFO(testlog, "Cut flow:\n" << table.str());
+    stringstream json;
+    KTCutFlow::WriteJSON(json);
+    KTINFO(testlog, "Cut flow as JSON:\n" << json.str());
+
+    KTINFO(testlog, "Recording a data object that's still alive");
+    KTCutFlow::Reset();
+    {
+        KTData data;
+        data.GetCutStatus().AddCutResult< KTAwesomeCut::Result >(false);
+        summary = KTCutFlow::GetSummary();
+        if (summary.fNData != 1 || summary.fNRejected != 0 ||
+                ! CheckEntry(summary.fEntries[0], "awesome-cut", 1, 0, 0, 0) || ! CheckEntry(summary.fEntries[1], "not-awesome-cut", 0, 0, 0, 0))
+        {
+            KTERROR(testlog, "A data object that's still alive wasn't recorded");
+            return -1;
+        }
+
+        // changing a cut updates the record instead of adding a data object
+        data.GetCutStatus().SetCutState< KTAwesomeCut::Result >(true);
+        summary = KTCutFlow::GetSummary();
+        if (summary.fNData != 1 || summary.fNRejected != 1 ||
+                ! CheckEntry(summary.fEntries[0], "awesome-cut", 1, 1, 1, 1) || ! CheckEntry(summary.fEntries[1], "not-awesome-cut", 0, 0, 0, 1))
+        {
+            KTERROR(testlog, "Changing a cut didn't update the cut flow");
+            return -1;
+        }
+
+        // once the cut flow is reset, the data object is recorded afresh when its cuts change
+        KTCutFlow::Reset();
+        data.GetCutStatus().AddCutResult("not-awesome-cut", false);
+        summary = KTCutFlow::GetSummary();
+        if (summary.fNData != 1 || summary.fNRejected != 1 ||
+                ! CheckEntry(summary.fEntries[0], "awesome-cut", 1, 1, 1, 1) || ! CheckEntry(summary.fEntries[1], "not-awesome-cut", 1, 0, 0, 1))
+        {
+            KTERROR(testlog, "The data object wasn't recorded afresh after the cut flow was reset");
+            return -1;
+        }
+    }
+    if (KTCutFlow::GetSummary().fNData != 1)
+    {
+        KTERROR(testlog, "Destroying the data object changed the cut flow");
+        return -1;
+    }
+
+    KTINFO(testlog, "Recording from several threads");
+    KTCutFlow::Reset();
+    const unsigned nThreads = 4;
+    const unsigned nDataPerThread = 1000;
+    boost::thread_group threads;
+    for (unsigned iThread = 0; iThread < nThreads; ++iThread)
+    {
+        threads.create_thread(boost::bind(&ApplyCutsRepeatedly, nDataPerThread));
+    }
+    threads.join_all();
+    // the threads have exited, so their counters are reused by these
+    boost::thread_group moreThreads;
+    for (unsigned iThread = 0; iThread < nThreads; ++iThread)
+    {
+        moreThreads.create_thread(boost::bind(&ApplyCutsRepeatedly, nDataPerThread));
+    }
+    moreThreads.join_all();
+
+    summary = KTCutFlow::GetSummary();
+    const uint64_t nData = 2 * nThreads * nDataPerThread;
+    if (summary.fNData != nData || ! CheckEntry(summary.fEntries[0], "awesome-cut", nData, 0, 0, 0) ||
+            ! CheckEntry(summary.fEntries[1], "not-awesome-cut", nData, nData, nData, nData))
+    {
+        KTERROR(testlog, "Unexpected cut flow from several threads");
+        return -1;
+    }
+
+    KTINFO(testlog, "Tests complete");
+    return 0;
+}
@@ -0,0 +1,156 @@
+/*
+ * TestDataBatch.cc
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: nsoblath
+ */
+
+#include "KTTestCuts.hh"
+
+#include "KTBatchAccumulator.hh"
+#include "KTDataBatch.hh"
+#include "KTLogger.hh"
+#include "KTSlot.hh"
+
+KTLOGGER(testlog, "TestDataBatch");
+
+using namespace Nymph;
+
+namespace Nymph
+{
+    class KTTestBatchReceiver : public KTProcessor
+    {
+        public:
+            KTTestBatchReceiver() :
+                    KTProcessor("test-batch-receiver"),
+                    fNBatches(0),
+                    fNBatchData(0),
+                    fNItemData(0),
+                    fBatchSlot("batch", this, &KTTestBatchReceiver::AnalyzeBatch),
+                    fItemSlot("item", this, &KTTestBatchReceiver::AnalyzeItem)
+            {}
+            virtual ~KTTestBatchReceiver() {}
+
+            bool Configure(const scarab::param_node&)
+            {
+                return true;
+            }
+
+            bool AnalyzeBatch(const std::vector< KTTestData* >& batch)
+            {
+                KTINFO(testlog, "Received a batch of " << batch.size() << " test data objects");
+                ++fNBatches;
+                fNBatchData += batch.size();
+                return true;
+            }
+
+            bool AnalyzeItem(KTTestData&)
+            {
+                ++fNItemData;
+                return true;
+            }
+
+            unsigned fNBatches;
+            unsigned fNBatchData;
+            unsigned fNItemData;
+
+        private:
+            KTSlotDataBatch< KTTestData > fBatchSlot;
+            KTSlotDataOneType< KTTestData > fItemSlot;
+    };
+
+    KTDATAFIELD(KTCounterField, KTData, unsigned, Counter);
+    KTDATAFIELD(KTIsAwesomeField, KTTestData, bool, IsAwesome);
+}
+
+int main()
+{
+    KTBatchAccumulator accumulator;
+    accumulator.SetBatchSize(3);
+
+    KTTestBatchReceiver receiver;
+
+    try
+    {
+        accumulator.ConnectASlot("batch", &receiver, "batch");
+        accumulator.ConnectASlot("each-batch", &receiver, "item");
+    }
+    catch(std::exception& e)
+    {
+        KTERROR(testlog, "A problem occurred while connecting the signal and slots:\n" << e.what());
+        return -1;
+    }
+
+    KTINFO(testlog, "Adding 7 data objects; the fifth does not have test data");
+    KTDataPtrBatch allData;
+    for (unsigned iData = 0; iData < 7; ++iData)
+    {
+        KTDataPtr data(new KTData());
+        data->SetCounter(iData);
+        if (iData != 4) data->Of< KTTestData >().SetIsAwesome(true);
+        accumulator.AddData(data);
+        allData.push_back(data);
+    }
+    KTINFO(testlog, "Flushing the accumulator");
+    accumulator.Flush();
+
+    if (receiver.fNBatches != 3 || receiver.fNBatchData != 6 || receiver.fNItemData != 6)
+    {
+        KTERROR(testlog, "Expected 3 batches, 6 data objects in batches, and 6 single data objects; found "
+                << receiver.fNBatches << ", " << receiver.fNBatchData << ", and " << receiver.fNItemData);
+        return -1;
+    }
+
+    KTINFO(testlog, "Gathering fields into columns");
+    KTDataBatch< KTCounterField, KTIsAwesomeField > columns;
+    if (columns.Gather(allData) != 6 || columns.GetNSkipped() != 1 || columns.Data()[4] != allData[5])
+    {
+        KTERROR(testlog, "Expected 6 data objects in the columns and 1 left out; found " << columns.size() << " and " << columns.GetNSkipped());
+        return -1;
+    }
+    const std::vector< unsigned >& counters = columns.Column< KTCounterField >();
+    const std::vector< unsigned char >& isAwesome = columns.Column< KTIsAwesomeField >();
+    unsigned counterSum = 0;
+    for (unsigned iData = 0; iData < counters.size(); ++iData)
+    {
+        counterSum += counters[iData];
+        if (! isAwesome[iData]) counterSum = 1000;
+    }
+    if (counterSum != 17)
+    {
+        KTERROR(testlog, "Columns have the wrong contents");
+        return -1;
+    }
+
+    KTINFO(testlog, "Cutting on a column");
+    KTDataBatch< KTCounterField, KTIsAwesomeField >::cut_column_type isCut(columns.size());
+    for (unsigned iData = 0; iData < counters.size(); ++iData)
+    {
+        isCut[iData] = counters[iData] > 3;
+    }
+    columns.ScatterCut< KTAwesomeCut::Result >(isCut);
+    if (allData[3]->GetCutStatus().IsCut() || ! allData[5]->GetCutStatus().IsCut() || ! columns.IsCut()[4] || columns.IsCut()[3])
+    {
+        KTERROR(testlog, "Cut was not stored in the data objects");
+        return -1;
+    }
+
+    KTINFO(testlog, "Scattering a column");
+    columns.Column< KTCounterField >()[0] = 10;
+    columns.Column< KTIsAwesomeField >()[0] = false;
+    columns.Scatter< KTCounterField >();
+    if (allData[0]->GetCounter() != 10 || ! allData[0]->Of< KTTestData >().GetIsAwesome())
+    {
+        KTERROR(testlog, "Only the counter should have been written back");
+        return -1;
+    }
+    columns.Scatter();
+    if (allData[0]->Of< KTTestData >().GetIsAwesome())
+    {
+        KTERROR(testlog, "Awesomeness was not written back");
+        return -1;
+    }
+
+    KTINFO(testlog, "Tests complete");
+    return 0;
+}
@@ -0,0 +1,118 @@
+/*
+ * TestDataPool.cc
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: nsoblath
+ */
+
+#include "KTTestCuts.hh"
+
+#include "KTDataPool.hh"
+#include "KTLogger.hh"
+
+#include <vector>
+
+KTLOGGER(testlog, "TestDataPool");
+
+using namespace Nymph;
+
+namespace Nymph
+{
+    // Extension with a buffer that's kept when the data is recycled
+    class KTTestBufferData : public KTExtensibleData< KTTestBufferData >
+    {
+        public:
+            KTTestBufferData() : KTExtensibleData< KTTestBufferData >(), fBuffer() {}
+            virtual ~KTTestBufferData() {}
+
+            bool Reset()
+            {
+                fBuffer.clear();
+                return true;
+            }
+
+            std::vector< double > fBuffer;
+
+            static const std::string sName;
+    };
+    const std::string KTTestBufferData::sName("test-buffer-data");
+}
+
+int main()
+{
+    KTDataPool pool(2);
+
+    KTINFO(testlog, "Filling and releasing a data object");
+    const double* buffer = NULL;
+    {
+        KTDataPtr data = pool.Get();
+        data->SetCounter(5);
+        data->Of< KTTestBufferData >().fBuffer.resize(1000, 1.);
+        buffer = &data->Of< KTTestBufferData >().fBuffer[0];
+        data->Of< KTTestData >().SetIsAwesome(true);
+        data->GetCutStatus().AddCutResult< KTAwesomeCut::Result >(true);
+    }
+    if (pool.GetNAvailable() != 1 || pool.GetNCreated() != 1)
+    {
+        KTERROR(testlog, "Data object was not returned to the pool");
+        return -1;
+    }
+
+    KTINFO(testlog, "Reusing the data object");
+    {
+        KTDataPtr data = pool.Get();
+        if (pool.GetNReused() != 1 || data->GetCounter() != 0 || ! data->GetCutStatus().CutResultsPresent().empty())
+        {
+            KTERROR(testlog, "Reused data object was not reset");
+            return -1;
+        }
+        if (! data->Has< KTTestBufferData >() || ! data->Of< KTTestBufferData >().fBuffer.empty() || data->Of< KTTestBufferData >().fBuffer.capacity() < 1000)
+        {
+            KTERROR(testlog, "Extension with a buffer was not kept and reset");
+            return -1;
+        }
+        data->Of< KTTestBufferData >().fBuffer.resize(1000, 2.);
+        if (&data->Of< KTTestBufferData >().fBuffer[0] != buffer)
+        {
+            KTERROR(testlog, "Buffer was reallocated");
+            return -1;
+        }
+        if (data->Has< KTTestData >())
+        {
+            KTERROR(testlog, "Extension that can't be reset was kept");
+            return -1;
+        }
+    }
+
+    KTINFO(testlog, "Releasing more data objects than the capacity");
+    {
+        std::vector< KTDataPtr > data;
+        for (unsigned iData = 0; iData < 4; ++iData)
+        {
+            data.push_back(pool.Get());
+        }
+    }
+    if (pool.GetNAvailable() != 2 || pool.GetNCreated() != 4)
+    {
+        KTERROR(testlog, "Pool has " << pool.GetNAvailable() << " data objects and has created " << pool.GetNCreated());
+        return -1;
+    }
+    pool.SetCapacity(1);
+    if (pool.GetNAvailable() != 1)
+    {
+        KTERROR(testlog, "Extra data objects were not removed when the capacity was reduced");
+        return -1;
+    }
+
+    KTINFO(testlog, "Releasing a data object after its pool is gone");
+    KTDataPtr orphan;
+    {
+        KTDataPool tempPool;
+        orphan = tempPool.Get();
+        orphan->Of< KTTestBufferData >();
+    }
+    orphan.reset();
+
+    KTINFO(testlog, "Tests complete");
+    return 0;
+}
@@ -0,0 +1,401 @@
+/*
+ * TestExtensibleStruct.cc
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: nsoblath
+ */
+
+#include "KTTestCuts.hh"
+
+#include "KTArena.hh"
+#include "KTData.hh"
+#include "KTExtensibleStructFactory.hh"
+#include "KTLogger.hh"
+
+KTLOGGER(testlog, "TestExtensibleStruct");
+
+using namespace Nymph;
+
+namespace Nymph
+{
+    class KTTestDataA : public KTExtensibleData< KTTestDataA >
+    {
+        public:
+            KTTestDataA() : KTExtensibleData< KTTestDataA >(), fValue(0) {}
+            static const std::string sName;
+            unsigned fValue;
+    };
+    const std::string KTTestDataA::sName("test-data-a");
+
+    class KTTestDataB : public KTExtensibleData< KTTestDataB >
+    {
+        public:
+            KTTestDataB() : KTExtensibleData< KTTestDataB >(), fValue(0) {}
+            static const std::string sName;
+            unsigned fValue;
+    };
+    const std::string KTTestDataB::sName("test-data-b");
+
+    class KTTestDataC : public KTExtensibleData< KTTestDataC >
+    {
+        public:
+            KTTestDataC() : KTExtensibleData< KTTestDataC >(), fValue(0) {}
+            static const std::string sName;
+            unsigned fValue;
+    };
+    const std::string KTTestDataC::sName("test-data-c");
+
+    // not an extension type of its own: it would be found as a KTTestDataC
+    class KTTestDataCDerived : public KTTestDataC
+    {};
+    static_assert(! KTIsExtensibleStructInstance< KTTestDataCDerived, KTDataCore >::value, "a class derived from an extension type must not be looked up by type");
+    static_assert(KTIsExtensibleStructInstance< KTTestDataC, KTDataCore >::value, "an extension type must be looked up by type");
+
+    unsigned sNGenerated = 0;
+
+    // C is the sum of A and B
+    bool GenerateTestDataC(KTTestDataC& dataC, const KTExtensibleStructCore< KTDataCore >& data)
+    {
+        if (! data.Has< KTTestDataA >() || ! data.Has< KTTestDataB >()) return false;
+        dataC.fValue = data.Of< KTTestDataA >().fValue + data.Of< KTTestDataB >().fValue;
+        ++sNGenerated;
+        return true;
+    }
+
+    KT_REGISTER_GENERATOR(KTTestDataC, &GenerateTestDataC);
+}
+
+int main()
+{
+    KTData data;
+
+    KTINFO(testlog, "Checking an empty chain");
+    if (! data.Has< KTData >() || data.Has< KTTestDataA >() || data.Detatch< KTTestDataA >() != NULL)
+    {
+        KTERROR(testlog, "Empty chain has the wrong contents");
+        return -1;
+    }
+
+    KTINFO(testlog, "Adding extensions");
+    data.Of< KTTestDataA >().fValue = 1;
+    data.Of< KTTestDataB >().fValue = 2;
+    data.Of< KTTestDataC >().fValue = 3;
+    if (! data.Has< KTTestDataA >() || ! data.Has< KTTestDataB >() || ! data.Has< KTTestDataC >())
+    {
+        KTERROR(testlog, "Extensions were not added");
+        return -1;
+    }
+    if (data.Next() != &data.Of< KTTestDataA >() || data.Last() != &data.Of< KTTestDataC >())
+    {
+        KTERROR(testlog, "Extensions are not in the order in which they were added");
+        return -1;
+    }
+    if (data.Of< KTTestDataB >().Has< KTTestDataA >() || ! data.Of< KTTestDataB >().Has< KTTestDataC >())
+    {
+        KTERROR(testlog, "Has() called on an extension doesn't search from that extension");
+        return -1;
+    }
+
+    KTINFO(testlog, "Copying the chain");
+    KTData copy(data);
+    if (&copy.Of< KTTestDataB >() == &data.Of< KTTestDataB >() || copy.Of< KTTestDataB >().fValue != 2 || copy.Of< KTTestDataC >().Prev() != &copy.Of< KTTestDataB >())
+    {
+        KTERROR(testlog, "Chain was not copied correctly");
+        return -1;
+    }
+    KTData assigned;
+    assigned.Of< KTTestDataC >();
+    assigned = data;
+    if (assigned.Next() != &assigned.Of< KTTestDataA >() || assigned.Of< KTTestDataC >().fValue != 3)
+    {
+        KTERROR(testlog, "Chain was not assigned correctly");
+        return -1;
+    }
+
+    KTINFO(testlog, "Detatching from the middle and end of the chain");
+    KTTestDataB* dataB = data.Detatch< KTTestDataB >();
+    if (dataB == NULL || dataB->fValue != 2 || dataB->Next() != NULL || dataB->Prev() != NULL)
+    {
+        KTERROR(testlog, "Extension B was not detatched correctly");
+        return -1;
+    }
+    delete dataB;
+    if (data.Has< KTTestDataB >() || data.Of< KTTestDataA >().Next() != &data.Of< KTTestDataC >())
+    {
+        KTERROR(testlog, "Chain is wrong after detatching extension B");
+        return -1;
+    }
+    delete data.Detatch< KTTestDataC >();
+    if (data.Has< KTTestDataC >() || data.Of< KTTestDataA >().Next() != NULL)
+    {
+        KTERROR(testlog, "Chain is wrong after detatching extension C");
+        return -1;
+    }
+
+    KTINFO(testlog, "Adding an extension back after it was detatched");
+    data.Of< KTTestDataB >().fValue = 4;
+    if (data.Last() != &data.Of< KTTestDataB >() || data.Of< KTTestDataB >().fValue != 4)
+    {
+        KTERROR(testlog, "Extension B was not added back correctly");
+        return -1;
+    }
+
+    KTINFO(testlog, "Clearing the chain");
+    data.Clear();
+    if (data.Has< KTTestDataA >() || data.Has< KTTestDataB >() || data.Next() != NULL)
+    {
+        KTERROR(testlog, "Chain was not cleared");
+        return -1;
+    }
+
+    KTINFO(testlog, "Allocating extensions in an arena");
+    KTTestDataC* detatchedC = NULL;
+    {
+        KTData arenaData;
+        arenaData.UseArena(1024);
+        KTArena* arena = arenaData.GetArena();
+        arenaData.Of< KTTestDataA >().fValue = 5;
+        arenaData.Of< KTTestDataB >().fValue = 6;
+        arenaData.Of< KTTestDataC >().fValue = 7;
+        if (arena == NULL || arena->GetNBlocks() != 1 || arena->GetBytesAllocated() == 0 || arenaData.Of< KTTestDataB >().GetArena() != arena)
+        {
+            KTERROR(testlog, "Extensions were not allocated in the arena");
+            return -1;
+        }
+
+        KTData arenaCopy(arenaData);
+        if (arenaCopy.GetArena() == NULL || arenaCopy.GetArena() == arena || arenaCopy.Of< KTTestDataC >().fValue != 7)
+        {
+            KTERROR(testlog, "Chain using an arena was not copied correctly");
+            return -1;
+        }
+
+        delete arenaData.Detatch< KTTestDataB >();
+        // C is used after the data that own the arena are gone
+        detatchedC = arenaData.Detatch< KTTestDataC >();
+
+        arenaCopy.Clear();
+        arenaCopy.Of< KTTestDataB >().fValue = 8;
+        if (arenaCopy.GetArena()->GetNBlocks() != 1 || arenaCopy.Of< KTTestDataB >().fValue != 8)
+        {
+            KTERROR(testlog, "Arena was not reused after clearing the chain");
+            return -1;
+        }
+    }
+    if (detatchedC->fValue != 7)
+    {
+        KTERROR(testlog, "Detatched extension was not kept");
+        return -1;
+    }
+    delete detatchedC;
+
+    KTINFO(testlog, "Copying a copy-on-write chain");
+    KTData* original = new KTData();
+    original->SetIsCopyOnWrite(true);
+    original->Of< KTTestDataA >().fValue = 1;
+    original->Of< KTTestDataB >().fValue = 2;
+    original->GetCutStatus().AddCutResult< KTAwesomeCut::Result >(true);
+    const KTTestDataA* sharedA = &static_cast< const KTData* >(original)->Of< KTTestDataA >();
+    const KTTestDataB* sharedB = &static_cast< const KTData* >(original)->Of< KTTestDataB >();
+
+    KTData* fork = new KTData(*original);
+    const KTData* constFork = fork;
+    if (&constFork->Of< KTTestDataA >() != sharedA || &constFork->Of< KTTestDataB >() != sharedB || ! sharedA->IsShared() || ! fork->GetIsCopyOnWrite())
+    {
+        KTERROR(testlog, "Copy does not share the extensions of the original");
+        return -1;
+    }
+
+    KTINFO(testlog, "Adding an extension to the copy");
+    fork->Of< KTTestDataC >().fValue = 3;
+    if (original->Has< KTTestDataC >() || &constFork->Of< KTTestDataA >() != sharedA || fork->Next() != &fork->Of< KTTestDataC >())
+    {
+        KTERROR(testlog, "Adding an extension to the copy unshared the others or changed the original");
+        return -1;
+    }
+
+    KTINFO(testlog, "Modifying a shared extension of the copy");
+    fork->Of< KTTestDataA >().fValue = 4;
+    if (&constFork->Of< KTTestDataA >() == sharedA || sharedA->fValue != 1 || fork->Of< KTTestDataA >().Prev() != &fork->Of< KTTestDataC >())
+    {
+        KTERROR(testlog, "Modified extension was not copied");
+        return -1;
+    }
+    // B is behind A, so it's still shared
+    if (&constFork->Of< KTTestDataB >() != sharedB || constFork->Of< KTTestDataB >().fValue != 2)
+    {
+        KTERROR(testlog, "Extension that was not modified was copied");
+        return -1;
+    }
+
+    KTINFO(testlog, "Modifying the cut results of the copy");
+    fork->GetCutStatus().AddCutResult< KTNotAwesomeCut::Result >(false);
+    if (original->GetCutStatus().HasCutResult< KTNotAwesomeCut::Result >() || fork->GetCutStatus().CutResultsPresent() != "not-awesome-cut awesome-cut")
+    {
+        KTERROR(testlog, "Cut results were not copied correctly: " << fork->GetCutStatus().CutResultsPresent());
+        return -1;
+    }
+    const KTCutStatus& forkStatus = fork->GetCutStatus();
+    const KTCutStatus& originalStatus = original->GetCutStatus();
+    if (forkStatus.GetCutResult< KTAwesomeCut::Result >() != originalStatus.GetCutResult< KTAwesomeCut::Result >())
+    {
+        KTERROR(testlog, "Adding a cut result to the copy copied the shared cut results");
+        return -1;
+    }
+    fork->GetCutStatus().SetCutState< KTAwesomeCut::Result >(false);
+    if (forkStatus.GetCutResult< KTAwesomeCut::Result >() == originalStatus.GetCutResult< KTAwesomeCut::Result >()
+            || ! originalStatus.GetCutState< KTAwesomeCut::Result >() || forkStatus.GetCutState< KTAwesomeCut::Result >()
+            || forkStatus.CutResultsPresent() != "not-awesome-cut awesome-cut")
+    {
+        KTERROR(testlog, "Setting a shared cut result of the copy didn't copy it, or changed the original");
+        return -1;
+    }
+
+    KTINFO(testlog, "Taking back shared extensions after the copy is gone");
+    delete fork;
+    original->Of< KTTestDataA >().fValue = 5;
+    if (&original->Of< KTTestDataA >() != sharedA || sharedA->IsShared() || &original->Of< KTTestDataB >() != sharedB || original->Of< KTTestDataB >().fValue != 2)
+    {
+        KTERROR(testlog, "Extensions were not taken back by the original");
+        return -1;
+    }
+
+    KTINFO(testlog, "Deleting the original before the copy");
+    fork = new KTData(*original);
+    delete original;
+    fork->Unshare();
+    if (fork->Of< KTTestDataA >().fValue != 5 || fork->Of< KTTestDataB >().fValue != 2 || fork->Of< KTTestDataA >().IsShared())
+    {
+        KTERROR(testlog, "Copy is wrong after deleting the original");
+        return -1;
+    }
+    delete fork;
+
+    KTINFO(testlog, "Moving a chain");
+    KTData source;
+    source.UseArena(1024);
+    source.SetCounter(6);
+    source.Of< KTTestDataA >().fValue = 1;
+    source.Of< KTTestDataB >().fValue = 2;
+    source.GetCutStatus().AddCutResult< KTAwesomeCut::Result >(true);
+    KTArena* sourceArena = source.GetArena();
+    KTTestDataA* movedA = &source.Of< KTTestDataA >();
+    KTTestDataB* movedB = &source.Of< KTTestDataB >();
+
+    KTData moved(std::move(source));
+    if (&moved.Of< KTTestDataA >() != movedA || &moved.Of< KTTestDataB >() != movedB || movedA->Prev() != &moved || movedB->First() != &moved)
+    {
+        KTERROR(testlog, "Extensions were not moved to the new chain");
+        return -1;
+    }
+    if (moved.GetArena() != sourceArena || moved.GetCounter() != 6 || ! moved.GetCutStatus().HasCutResult< KTAwesomeCut::Result >())
+    {
+        KTERROR(testlog, "Arena, counter, or cut results were not moved");
+        return -1;
+    }
+    if (source.Next() != NULL || source.Has< KTTestDataA >() || source.GetArena() != NULL || ! source.GetCutStatus().CutResultsPresent().empty())
+    {
+        KTERROR(testlog, "Chain that was moved from is not empty");
+        return -1;
+    }
+
+    KTINFO(testlog, "Move-assigning a chain");
+    KTData target;
+    target.Of< KTTestDataC >().fValue = 3;
+    target = std::move(moved);
+    if (target.Has< KTTestDataC >() || &target.Of< KTTestDataA >() != movedA || movedA->Prev() != &target || target.Of< KTTestDataB >().fValue != 2 || moved.Next() != NULL)
+    {
+        KTERROR(testlog, "Chain was not move-assigned correctly");
+        return -1;
+    }
+
+    KTINFO(testlog, "Moving a copy-on-write chain");
+    target.SetIsCopyOnWrite(true);
+    KTData* sharing = new KTData(target);
+    KTData movedShared(std::move(*sharing));
+    delete sharing;
+    if (&static_cast< const KTData& >(movedShared).Of< KTTestDataA >() != movedA || ! movedShared.GetIsCopyOnWrite() || ! movedA->IsShared())
+    {
+        KTERROR(testlog, "Shared extensions were not moved");
+        return -1;
+    }
+    movedShared.Of< KTTestDataB >().fValue = 4;
+    if (target.Of< KTTestDataB >().fValue != 2 || movedShared.Of< KTTestDataA >().fValue != 1)
+    {
+        KTERROR(testlog, "Moved chain did not copy the shared extensions when they were modified");
+        return -1;
+    }
+
+    // the test extensions have implicit move constructors
+    KTINFO(testlog, "Moving an extension that isn't the first in its chain");
+    KTTestDataA movedExtension(std::move(target.Of< KTTestDataA >()));
+    if (movedExtension.Next() == NULL || movedExtension.Next() == movedB || movedExtension.Of< KTTestDataB >().fValue != 2 || &target.Of< KTTestDataB >() != movedB)
+    {
+        KTERROR(testlog, "Rest of the chain was not copied when moving an extension");
+        return -1;
+    }
+
+    KTINFO(testlog, "Attaching a detatched extension");
+    KTData branch1, branch2;
+    branch1.Of< KTTestDataA >().fValue = 1;
+    std::unique_ptr< KTTestDataB > detatchedB(target.Detatch< KTTestDataB >());
+    KTTestDataB* attachedB = &branch1.Attach(std::move(detatchedB));
+    if (attachedB != movedB || &branch1.Of< KTTestDataB >() != movedB || movedB->Prev() != &branch1.Of< KTTestDataA >() || movedB->First() != &branch1)
+    {
+        KTERROR(testlog, "Extension was not attached");
+        return -1;
+    }
+
+    KTINFO(testlog, "Splicing extensions from another chain");
+    branch2.UseArena(1024);
+    branch2.Of< KTTestDataB >().fValue = 5;
+    branch2.Of< KTTestDataC >().fValue = 6;
+    KTTestDataC* splicedC = &branch2.Of< KTTestDataC >();
+    if (branch1.Splice< KTTestDataC >(branch2) != splicedC || branch2.Has< KTTestDataC >() || splicedC->Prev() != movedB || branch1.Last() != splicedC)
+    {
+        KTERROR(testlog, "Extension C was not spliced");
+        return -1;
+    }
+    if (branch1.Splice< KTTestDataC >(branch2) != NULL)
+    {
+        KTERROR(testlog, "Splicing an extension that isn't there did something");
+        return -1;
+    }
+    KTTestDataB* splicedB = &branch2.Of< KTTestDataB >();
+    branch1.SpliceAll(branch2);
+    if (&branch1.Of< KTTestDataB >() != splicedB || branch1.Of< KTTestDataB >().fValue != 5 || branch1.Of< KTTestDataA >().fValue != 1 || branch2.Next() != NULL)
+    {
+        KTERROR(testlog, "Extensions were not all spliced, replacing the ones of the same type");
+        return -1;
+    }
+    if (splicedB->Prev() != splicedC || splicedC->Next() != splicedB || branch1.Last() != splicedB)
+    {
+        KTERROR(testlog, "Chain is wrong after splicing");
+        return -1;
+    }
+
+    KTINFO(testlog, "Generating an extension on demand");
+    KTData lazy;
+    const KTData& constLazy = lazy;
+    if (constLazy.Get< KTTestDataC >() != NULL || lazy.Has< KTTestDataC >() || lazy.Get< KTTestDataB >() != NULL)
+    {
+        KTERROR(testlog, "Extension was generated without what it needs, or without a generator");
+        return -1;
+    }
+    lazy.Of< KTTestDataA >().fValue = 2;
+    lazy.Of< KTTestDataB >().fValue = 3;
+    const KTTestDataC* lazyC = constLazy.Get< KTTestDataC >();
+    if (lazyC == NULL || lazyC->fValue != 5 || ! lazy.Has< KTTestDataC >() || lazy.Last() != lazyC || sNGenerated != 1)
+    {
+        KTERROR(testlog, "Extension was not generated");
+        return -1;
+    }
+    if (lazy.Get< KTTestDataC >() != lazyC || sNGenerated != 1)
+    {
+        KTERROR(testlog, "Extension was generated more than once");
+        return -1;
+    }
+
+    KTINFO(testlog, "Tests complete");
+    return 0;
+}
@@ -0,0 +1,102 @@
+/*
+ * TestFilteredConnection.cc
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: nsoblath
+ */
+
+#include "KTTestCuts.hh"
+#include "KTTestProcessor.hh"
+
+#include "KTApplyCut.hh"
+#include "KTDataPredicate.hh"
+#include "KTLogger.hh"
+#include "KTSlot.hh"
+
+KTLOGGER(testlog, "TestFilteredConnection");
+
+using namespace Nymph;
+
+namespace Nymph
+{
+    class KTTestFilterReceiver : public KTProcessor
+    {
+        public:
+            KTTestFilterReceiver(const std::string& name) :
+                    KTProcessor(name),
+                    fNData(0),
+                    fSlot("data", this, &KTTestFilterReceiver::Receive)
+            {}
+            virtual ~KTTestFilterReceiver() {}
+
+            bool Configure(const scarab::param_node&)
+            {
+                return true;
+            }
+
+            bool Receive(KTTestData&)
+            {
+                ++fNData;
+                return true;
+            }
+
+            unsigned fNData;
+
+        private:
+            KTSlotDataOneType< KTTestData > fSlot;
+    };
+}
+
+int main()
+{
+    KTApplyCut applyCut;
+    applyCut.SetCut(new KTAwesomeCut());
+
+    KTTestFilterReceiver hasDataReceiver("has-data-receiver");
+    KTTestFilterReceiver namedDataReceiver("named-data-receiver");
+    KTTestFilterReceiver passReceiver("pass-receiver");
+
+    try
+    {
+        applyCut.ConnectASlot("all", &hasDataReceiver, "data", -1, boost::shared_ptr< KTConnectionStats >(), KTRequireData< KTTestData >());
+        applyCut.ConnectASlot("all", &namedDataReceiver, "data", -1, boost::shared_ptr< KTConnectionStats >(), KTRequireDataNamed("test-data"));
+        applyCut.ConnectASlot("all", &passReceiver, "data", -1, boost::shared_ptr< KTConnectionStats >(), KTRequireBoth(KTRequireData< KTTestData >(), KTRequirePassCuts()));
+    }
+    catch(std::exception& e)
+    {
+        KTERROR(testlog, "A problem occurred while connecting the signal and slots:\n" << e.what());
+        return -1;
+    }
+
+    KTINFO(testlog, "Sending 4 data objects; the first two are awesome, the third is not, and the last does not have test data");
+    for (unsigned iData = 0; iData < 4; ++iData)
+    {
+        KTDataPtr data(new KTData());
+        if (iData != 3) data->Of< KTTestData >().SetIsAwesome(iData < 2);
+        applyCut.ApplyCut(data);
+    }
+
+    if (hasDataReceiver.fNData != 3 || namedDataReceiver.fNData != 3 || passReceiver.fNData != 2)
+    {
+        KTERROR(testlog, "Unexpected number of data received: has-data: " << hasDataReceiver.fNData << "; named-data: " << namedDataReceiver.fNData
+                << "; pass: " << passReceiver.fNData);
+        return -1;
+    }
+
+    KTINFO(testlog, "Checking that a predicate can't be used with a slot that doesn't take data");
+    KTTestProcessorA tpA;
+    KTTestProcessorB tpB;
+    try
+    {
+        tpA.ConnectASlot("the_signal", &tpB, "first_slot", -1, boost::shared_ptr< KTConnectionStats >(), KTRequireData< KTTestData >());
+        KTERROR(testlog, "Connection was made with a predicate for a slot that doesn't take data");
+        return -1;
+    }
+    catch(std::exception& e)
+    {
+        KTINFO(testlog, "Connection was refused, as expected");
+    }
+
+    KTINFO(testlog, "Tests complete");
+    return 0;
+}
@@ -0,0 +1,176 @@
+/*
+ * TestMemoryAccounting.cc
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: nsoblath
+ */
+
+#include "KTTestCuts.hh"
+
+#include "KTExtensibleStruct.hh"
+#include "KTLogger.hh"
+#include "KTMemoryAccounting.hh"
+#include "KTSignal.hh"
+
+#include <sstream>
+#include <vector>
+
+KTLOGGER(testlog, "TestMemoryAccounting");
+
+using namespace Nymph;
+
+namespace Nymph
+{
+    struct KTTestUnnamedBase
+    {
+        virtual ~KTTestUnnamedBase() {}
+    };
+
+    // Extensible struct without a name; its account is named after its C++ type
+    class KTTestUnnamed : public KTExtensibleStruct< KTTestUnnamed, KTTestUnnamedBase >
+    {};
+
+    // Data type that owns memory outside of the object, and keeps it when it's reset
+    class KTTestBuffer : public KTExtensibleData< KTTestBuffer >
+    {
+        public:
+            std::size_t OwnedBytes() const
+            {
+                return fValues.capacity() * sizeof(double);
+            }
+
+            bool Reset()
+            {
+                fValues.clear();
+                return true;
+            }
+
+            std::vector< double > fValues;
+
+            static const std::string sName;
+    };
+
+    const std::string KTTestBuffer::sName("test-buffer");
+}
+
+namespace
+{
+    void IgnoreData(const KTDataPtr&)
+    {
+        return;
+    }
+}
+
+int main()
+{
+    KTINFO(testlog, "Objects made before accounting is enabled are not recorded");
+    KTDataPtr early(new KTData());
+    early->Of< KTTestData >();
+
+    KTMemoryAccounting::SetIsEnabled(true);
+
+    KTMemoryAccount& dataAccount = KTMemoryAccounting::GetAccount(KTTestData::sName, sizeof(KTTestData));
+    if (dataAccount.GetNLive() != 0)
+    {
+        KTERROR(testlog, "Object made before accounting was enabled was recorded");
+        return -1;
+    }
+
+    KTINFO(testlog, "Making, copying, and destroying data objects");
+    {
+        KTDataPtr data(new KTData());
+        data->Of< KTTestData >().SetIsAwesome(true);
+        data->GetCutStatus().AddCutResult< KTAwesomeCut::Result >(true);
+        if (dataAccount.GetNLive() != 1 || dataAccount.GetLiveBytes() != sizeof(KTTestData))
+        {
+            KTERROR(testlog, "Live objects: " << dataAccount.GetNLive() << "; live bytes: " << dataAccount.GetLiveBytes());
+            return -1;
+        }
+
+        KTData copy(*data);
+        KTData moved(std::move(copy));
+        if (dataAccount.GetNLive() != 2 || dataAccount.GetPeakNLive() != 2)
+        {
+            KTERROR(testlog, "Live objects after copying: " << dataAccount.GetNLive() << "; peak: " << dataAccount.GetPeakNLive());
+            return -1;
+        }
+    }
+    if (dataAccount.GetNLive() != 0 || dataAccount.GetPeakNLive() != 2 || dataAccount.GetPeakBytes() != 2 * sizeof(KTTestData))
+    {
+        KTERROR(testlog, "Live objects after destruction: " << dataAccount.GetNLive() << "; peak: " << dataAccount.GetPeakNLive());
+        return -1;
+    }
+
+    KTTestUnnamed unnamed;
+
+    KTINFO(testlog, "Recording the memory owned by a data object when it's reset and destroyed");
+    KTMemoryAccount& bufferAccount = KTMemoryAccounting::GetAccount(KTTestBuffer::sName, sizeof(KTTestBuffer));
+    std::size_t finalOwnedBytes = 0;
+    {
+        KTSignalData signal;
+        signal.Connect(KTSignalData::slot_type(&IgnoreData), 0, false);
+        KTDataPtr data(new KTData());
+        data->Of< KTTestBuffer >().fValues.reserve(100);
+        // the slots could be modifying the data, so emitting it doesn't sample it
+        signal(data);
+        if (bufferAccount.GetOwnedBytes() != 0)
+        {
+            KTERROR(testlog, "Owned bytes were recorded when the data was emitted");
+            return -1;
+        }
+
+        // the buffer is reset for reuse, and keeps the memory it owns
+        data->Reset();
+        const std::size_t ownedBytes = data->Of< KTTestBuffer >().fValues.capacity() * sizeof(double);
+        if (bufferAccount.GetOwnedBytes() != ownedBytes || bufferAccount.GetLiveBytes() != sizeof(KTTestBuffer) + ownedBytes ||
+                bufferAccount.GetPeakBytes() != sizeof(KTTestBuffer) + ownedBytes)
+        {
+            KTERROR(testlog, "Owned bytes: " << bufferAccount.GetOwnedBytes() << "; live bytes: " << bufferAccount.GetLiveBytes()
+                    << "; peak bytes: " << bufferAccount.GetPeakBytes() << "; expected " << ownedBytes << " owned bytes");
+            return -1;
+        }
+
+        // the memory owned when the data is destroyed is included in the peak
+        data->Of< KTTestBuffer >().fValues.reserve(1000);
+        finalOwnedBytes = data->Of< KTTestBuffer >().fValues.capacity() * sizeof(double);
+    }
+    if (bufferAccount.GetNLive() != 0 || bufferAccount.GetOwnedBytes() != 0)
+    {
+        KTERROR(testlog, "Owned bytes after destruction: " << bufferAccount.GetOwnedBytes());
+        return -1;
+    }
+    if (bufferAccount.GetPeakBytes() != sizeof(KTTestBuffer) + finalOwnedBytes)
+    {
+        KTERROR(testlog, "Peak bytes after destruction: " << bufferAccount.GetPeakBytes() << "; expected " << sizeof(KTTestBuffer) + finalOwnedBytes);
+        return -1;
+    }
+
+    KTINFO(testlog, "Destroying an object made before accounting was enabled");
+    early.reset();
+    if (dataAccount.GetNLive() != 0)
+    {
+        KTERROR(testlog, "Object made before accounting was enabled was removed from its account");
+        return -1;
+    }
+
+    KTINFO(testlog, "Resetting the high-water marks");
+    KTMemoryAccounting::ResetPeaks();
+    if (dataAccount.GetPeakNLive() != 0)
+    {
+        KTERROR(testlog, "High-water mark was not reset");
+        return -1;
+    }
+
+    std::stringstream report;
+    KTMemoryAccounting::PrintReport(report);
+    KTINFO(testlog, "Memory accounting:\n" << report.str());
+    if (report.str().find("test-data") == std::string::npos || report.str().find("awesome-cut") == std::string::npos ||
+            report.str().find("KTTestUnnamed") == std::string::npos || report.str().find("test-buffer") == std::string::npos)
+    {
+        KTERROR(testlog, "Report is missing types");
+        return -1;
+    }
+
+    KTINFO(testlog, "Tests complete");
+    return 0;
+}
@@ -0,0 +1,260 @@
+/*
+ * TestReplicatedProcessor.cc
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: nsoblath
+ */
+
+#include "KTTestCuts.hh"
+
+#include "KTLogger.hh"
+#include "KTReplicatedProcessor.hh"
+#include "KTSlot.hh"
+
+#include <boost/thread/thread.hpp>
+
+#include <stdexcept>
+#include <vector>
+
+KTLOGGER(testlog, "TestReplicatedProcessor");
+
+using namespace Nymph;
+
+namespace Nymph
+{
+    // Makes the data awesome; takes longer for earlier data, so that the replicas finish out of order
+    class KTTestSlowAwesome : public KTProcessor
+    {
+        public:
+            KTTestSlowAwesome(const std::string& name = "slow-awesome") :
+                    KTProcessor(name),
+                    fNData(0),
+                    fSignal("awesome", this),
+                    fSlot("data", this, &KTTestSlowAwesome::MakeAwesome, &fSignal)
+            {}
+            virtual ~KTTestSlowAwesome() {}
+
+            bool Configure(const scarab::param_node&)
+            {
+                return true;
+            }
+
+            bool MakeAwesome(KTTestData& data)
+            {
+                boost::this_thread::sleep(boost::posix_time::milliseconds(2 * (sNData - fNData)));
+                ++fNData;
+                data.SetIsAwesome(true);
+                return true;
+            }
+
+            static const unsigned sNData = 12;
+
+            unsigned fNData;
+
+        private:
+            KTSignalData fSignal;
+            KTSlotDataOneType< KTTestData > fSlot;
+    };
+
+    // Fails for awesome data
+    class KTTestFailOnAwesome : public KTProcessor
+    {
+        public:
+            KTTestFailOnAwesome(const std::string& name = "fail-on-awesome") :
+                    KTProcessor(name),
+                    fSignal("checked", this),
+                    fSlot("data", this, &KTTestFailOnAwesome::Check, &fSignal)
+            {}
+            virtual ~KTTestFailOnAwesome() {}
+
+            bool Configure(const scarab::param_node&)
+            {
+                return true;
+            }
+
+            bool Check(KTTestData& data)
+            {
+                if (data.GetIsAwesome()) throw std::runtime_error("the data is awesome");
+                return true;
+            }
+
+        private:
+            KTSignalData fSignal;
+            KTSlotDataOneType< KTTestData > fSlot;
+    };
+
+    class KTTestOrderReceiver : public KTProcessor
+    {
+        public:
+            KTTestOrderReceiver() :
+                    KTProcessor("test-order-receiver"),
+                    fCounters(),
+                    fNotAwesome(0),
+                    fFailCounter(-1),
+                    fSlot("data", this, &KTTestOrderReceiver::Receive)
+            {}
+            virtual ~KTTestOrderReceiver() {}
+
+            bool Configure(const scarab::param_node&)
+            {
+                return true;
+            }
+
+            void Receive(const KTDataPtr& data)
+            {
+                fCounters.push_back(data->GetCounter());
+                if (! data->Of< KTTestData >().GetIsAwesome()) ++fNotAwesome;
+                if (int(data->GetCounter()) == fFailCounter) throw std::runtime_error("the receiver failed");
+                return;
+            }
+
+            std::vector< unsigned > fCounters;
+            unsigned fNotAwesome;
+            // the receiver throws after recording the data with this counter (-1 for never)
+            int fFailCounter;
+
+        private:
+            KTSlotOneArg< void (const KTDataPtr&) > fSlot;
+    };
+}
+
+int main()
+{
+    const unsigned nReplicas = 3;
+    std::vector< KTProcessor* > replicas;
+    for (unsigned iReplica = 0; iReplica < nReplicas; ++iReplica)
+    {
+        replicas.push_back(new KTTestSlowAwesome());
+    }
+    KTReplicatedProcessor replicated("replicated-awesome", replicas);
+
+    KTTestOrderReceiver receiver;
+
+    try
+    {
+        replicated.ConnectASlot("awesome", &receiver, "data");
+    }
+    catch(std::exception& e)
+    {
+        KTERROR(testlog, "A problem occurred while connecting the signal and slot:\n" << e.what());
+        return -1;
+    }
+
+    KTSlotWrapper* dataSlot = replicated.GetSlot("data");
+    if (dataSlot == NULL || replicated.GetSlot("not-a-slot") != NULL)
+    {
+        KTERROR(testlog, "Slots were not set up correctly");
+        return -1;
+    }
+
+    KTINFO(testlog, "Sending " << KTTestSlowAwesome::sNData << " data objects to " << nReplicas << " replicas");
+    KTSignalData sender;
+    KTSignalWrapper senderWrapper(static_cast< KTSignalConnector< KTSignalData::signature >* >(&sender));
+    replicated.ConnectSignalToSlot(&senderWrapper, dataSlot);
+    for (unsigned iData = 0; iData < KTTestSlowAwesome::sNData; ++iData)
+    {
+        KTDataPtr data(new KTData());
+        data->SetCounter(iData);
+        data->Of< KTTestData >().SetIsAwesome(false);
+        sender(data);
+    }
+    replicated.Drain();
+
+    for (unsigned iReplica = 0; iReplica < nReplicas; ++iReplica)
+    {
+        unsigned nData = static_cast< KTTestSlowAwesome* >(replicated.GetReplica(iReplica))->fNData;
+        if (nData != KTTestSlowAwesome::sNData / nReplicas)
+        {
+            KTERROR(testlog, "Replica " << iReplica << " received " << nData << " data objects");
+            return -1;
+        }
+    }
+
+    if (receiver.fCounters.size() != KTTestSlowAwesome::sNData || receiver.fNotAwesome != 0)
+    {
+        KTERROR(testlog, "Received " << receiver.fCounters.size() << " data objects, " << receiver.fNotAwesome << " of which were not awesome");
+        return -1;
+    }
+    for (unsigned iData = 0; iData < receiver.fCounters.size(); ++iData)
+    {
+        if (receiver.fCounters[iData] != iData)
+        {
+            KTERROR(testlog, "Data were received out of order: position " << iData << " has counter " << receiver.fCounters[iData]);
+            return -1;
+        }
+    }
+
+    KTINFO(testlog, "Sending data to replicas that fail for awesome data");
+    std::vector< KTProcessor* > failingReplicas;
+    for (unsigned iReplica = 0; iReplica < 2; ++iReplica)
+    {
+        failingReplicas.push_back(new KTTestFailOnAwesome());
+    }
+    KTReplicatedProcessor failing("replicated-fail-on-awesome", failingReplicas);
+    KTTestOrderReceiver failingReceiver;
+    failing.ConnectASlot("checked", &failingReceiver, "data");
+    KTSignalData failingSender;
+    KTSignalWrapper failingSenderWrapper(static_cast< KTSignalConnector< KTSignalData::signature >* >(&failingSender));
+    failing.ConnectSignalToSlot(&failingSenderWrapper, failing.GetSlot("data"));
+    for (unsigned iData = 0; iData < 3; ++iData)
+    {
+        KTDataPtr data(new KTData());
+        data->SetCounter(iData);
+        data->Of< KTTestData >().SetIsAwesome(iData == 1);
+        failingSender(data);
+    }
+    try
+    {
+        failing.Drain();
+        KTERROR(testlog, "The failure of a replica wasn't reported by Drain()");
+        return -1;
+    }
+    catch(std::exception& e)
+    {
+        KTINFO(testlog, "Drain() reported the failure of a replica: " << e.what());
+    }
+    if (failingReceiver.fCounters.size() != 2 || failingReceiver.fCounters[0] != 0 || failingReceiver.fCounters[1] != 2)
+    {
+        KTERROR(testlog, "Expected the data before and after the failed one to be emitted in order");
+        return -1;
+    }
+
+    KTINFO(testlog, "Sending data to replicas whose output fails to be received");
+    std::vector< KTProcessor* > outputReplicas;
+    for (unsigned iReplica = 0; iReplica < 2; ++iReplica)
+    {
+        outputReplicas.push_back(new KTTestSlowAwesome());
+    }
+    KTReplicatedProcessor output("replicated-output", outputReplicas);
+    KTTestOrderReceiver outputReceiver;
+    outputReceiver.fFailCounter = 1;
+    output.ConnectASlot("awesome", &outputReceiver, "data");
+    KTSignalData outputSender;
+    KTSignalWrapper outputSenderWrapper(static_cast< KTSignalConnector< KTSignalData::signature >* >(&outputSender));
+    output.ConnectSignalToSlot(&outputSenderWrapper, output.GetSlot("data"));
+    for (unsigned iData = 0; iData < 4; ++iData)
+    {
+        KTDataPtr data(new KTData());
+        data->SetCounter(iData);
+        data->Of< KTTestData >().SetIsAwesome(false);
+        outputSender(data);
+    }
+    try
+    {
+        output.Drain();
+        KTERROR(testlog, "The failure of the receiver wasn't reported by Drain()");
+        return -1;
+    }
+    catch(std::exception& e)
+    {
+        KTINFO(testlog, "Drain() reported the failure of the receiver: " << e.what());
+    }
+    if (outputReceiver.fCounters.size() != 4)
+    {
+        KTERROR(testlog, "Expected all of the output to be emitted after the receiver failed; received " << outputReceiver.fCounters.size());
+        return -1;
+    }
+
+    KTINFO(testlog, "Tests complete");
+    return 0;
+}
@@ -7,12 +7,121 @@
 
 
 #include "KTTestProcessor.hh"
+#include "KTTestCuts.hh"
+#include "KTAsyncStage.hh"
+#include "KTConnectionStats.hh"
+#include "KTSignal.hh"
 #include "KTLogger.hh"
 
+#include <boost/thread.hpp>
+
+#include <atomic>
+#include <string>
+
 using namespace Nymph;
 
 KTLOGGER(testsiglog, "TestSignalsAndSlots")
 
+namespace Nymph
+{
+    struct KTSecondTestData : public KTExtensibleData< KTSecondTestData >
+    {
+        static const std::string sName;
+    };
+    const std::string KTSecondTestData::sName("second-test-data");
+}
+
+namespace
+{
+    unsigned sNNullData = 0;
+    std::string sCallOrder;
+
+    // like a queue processor, takes the data out of the pointer it's given
+    void TakeData(KTDataPtr& dataPtr)
+    {
+        KTDataPtr taken;
+        taken.swap(dataPtr);
+        return;
+    }
+
+    void CheckData(const KTDataPtr& dataPtr)
+    {
+        if (! dataPtr) ++sNNullData;
+        return;
+    }
+
+    void RecordValueCall(const KTDataPtr&)
+    {
+        sCallOrder += "v";
+        return;
+    }
+
+    void RecordRefCall(KTDataPtr&)
+    {
+        sCallOrder += "r";
+        return;
+    }
+
+    void Increment(std::atomic< unsigned >& counter)
+    {
+        ++counter;
+        return;
+    }
+
+    void ThrowNonStandard()
+    {
+        throw 42;
+    }
+
+    void AddTestData(const KTDataPtr& dataPtr)
+    {
+        dataPtr->Of< KTTestData >().SetIsAwesome(true);
+        return;
+    }
+
+    void AddSecondTestData(const KTDataPtr& dataPtr)
+    {
+        dataPtr->Of< KTSecondTestData >();
+        return;
+    }
+
+    void AddAwesomeCutResult(const KTDataPtr& dataPtr)
+    {
+        dataPtr->GetCutStatus().AddCutResult< KTAwesomeCut::Result >(false);
+        return;
+    }
+
+    void AddNotAwesomeCutResult(const KTDataPtr& dataPtr)
+    {
+        dataPtr->GetCutStatus().AddCutResult< KTNotAwesomeCut::Result >(true);
+        return;
+    }
+
+    // emits the data again from within a parallel group
+    void EmitAgain(KTSignalData* signal, const KTDataPtr& dataPtr)
+    {
+        (*signal)(dataPtr);
+        return;
+    }
+
+    void EmitToParallelGroup(KTSignalData* signal, unsigned nData, unsigned* nBad)
+    {
+        for (unsigned iData = 0; iData < nData; ++iData)
+        {
+            KTDataPtr dataPtr(new KTData());
+            (*signal)(dataPtr);
+            const KTCutStatus& cutStatus = dataPtr->GetCutStatus();
+            if (! dataPtr->Has< KTTestData >() || ! dataPtr->Has< KTSecondTestData >() ||
+                    ! cutStatus.HasCutResult< KTAwesomeCut::Result >() || ! cutStatus.HasCutResult< KTNotAwesomeCut::Result >() ||
+                    cutStatus.GetSummary().count() != 1)
+            {
+                ++(*nBad);
+            }
+        }
+        return;
+    }
+}
+
 int main()
 {
 
@@ -51,6 +160,153 @@ int main()
     KTINFO(testsiglog, "Second test signal: 18");
     tpA.EmitSignals(18);
 
+    KTINFO(testsiglog, "Disconnecting second_slot");
+    tpB.GetSlot("second_slot")->Disconnect();
+    KTINFO(testsiglog, "Third test signal (first_slot only): 7");
+    tpA.EmitSignals(7);
+    if (tpA.fTheSignal.num_slots() != 1)
+    {
+        KTERROR(testsiglog, "Expected 1 connected slot; found " << tpA.fTheSignal.num_slots());
+        return -1;
+    }
+
+    KTINFO(testsiglog, "Reconnecting second_slot asynchronously");
+    boost::shared_ptr< KTAsyncStage > stage(new KTAsyncStage("test-stage", 4));
+    try
+    {
+        tpA.ConnectASlotAsync("the_signal", &tpB, "second_slot", stage, 10);
+    }
+    catch(std::exception& e)
+    {
+        KTERROR(testsiglog, "A problem occurred while connecting the signal and slot asynchronously:\n" << e.what());
+        return -1;
+    }
+    KTINFO(testsiglog, "Fourth and fifth test signals: 3 and 11");
+    tpA.EmitSignals(3);
+    tpA.EmitSignals(11);
+    stage->Drain();
+    if (stage->GetNTasksCompleted() != 2)
+    {
+        KTERROR(testsiglog, "Expected 2 asynchronous slot calls; found " << stage->GetNTasksCompleted());
+        return -1;
+    }
+    KTINFO(testsiglog, "Queueing a task that throws something other than a std::exception, and one after it");
+    stage->Push(&ThrowNonStandard);
+    tpA.EmitSignals(6);
+    try
+    {
+        stage->Drain();
+        KTERROR(testsiglog, "The failure of an asynchronous task wasn't reported by Drain()");
+        return -1;
+    }
+    catch(int)
+    {}
+    stage->Drain();
+    if (stage->GetNTasksCompleted() != 4)
+    {
+        KTERROR(testsiglog, "Expected 4 asynchronous tasks; found " << stage->GetNTasksCompleted());
+        return -1;
+    }
+    stage->Stop();
+
+    KTINFO(testsiglog, "Moving second_slot to group 20, and making group 20 parallel");
+    tpB.GetSlot("second_slot")->Disconnect();
+    tpA.ConnectASlot("the_signal", &tpB, "second_slot", 20);
+    tpA.GetSignal("the_signal")->SetParallelGroup(20);
+    KTINFO(testsiglog, "Sixth test signal (first_slot and second_slot concurrently): 4");
+    try
+    {
+        tpA.EmitSignals(4);
+    }
+    catch(std::exception& e)
+    {
+        KTERROR(testsiglog, "A problem occurred while emitting to a parallel group:\n" << e.what());
+        return -1;
+    }
+
+    KTINFO(testsiglog, "Emitting a non-copyable reference argument to a parallel group");
+    KTSignalDispatcher< void (std::atomic< unsigned >&) > counterSignal;
+    counterSignal.connect(3, &Increment);
+    counterSignal.connect(3, &Increment);
+    counterSignal.SetParallelGroup(3, true);
+    std::atomic< unsigned > counter(0);
+    counterSignal(counter);
+    if (counter != 2)
+    {
+        KTERROR(testsiglog, "Expected the parallel slots to increment the argument twice; found " << counter);
+        return -1;
+    }
+
+    KTINFO(testsiglog, "Reconnecting first_slot with profiling");
+    tpB.GetSlot("first_slot")->Disconnect();
+    boost::shared_ptr< KTConnectionStats > stats(new KTConnectionStats("tpA:the_signal -> tpB:first_slot"));
+    tpA.ConnectASlot("the_signal", &tpB, "first_slot", 30, stats);
+    KTINFO(testsiglog, "Seventh and eighth test signals: 1 and 2");
+    tpA.EmitSignals(1);
+    tpA.EmitSignals(2);
+    KTConnectionStats::Summary summary = stats->GetSummary();
+    if (summary.fNCalls != 2 || summary.fNExceptions != 0 || summary.fMaxTime > summary.fTotalTime)
+    {
+        KTERROR(testsiglog, "Unexpected profile for " << stats->GetName() << ": " << summary.fNCalls << " calls, " << summary.fNExceptions << " exceptions, "
+                << summary.fTotalTime << " ns total, " << summary.fMaxTime << " ns max");
+        return -1;
+    }
+
+    KTINFO(testsiglog, "Emitting data to a value slot ordered after a reference slot that takes the data");
+    KTSignalData dataSignal;
+    dataSignal.Connect(KTSignalData::ref_slot_type(&TakeData), 1, true);
+    dataSignal.Connect(KTSignalData::slot_type(&CheckData), 2, true);
+    dataSignal.Connect(KTSignalData::slot_type(&CheckData), 0, false);
+    KTDataPtr dataPtr(new KTData());
+    dataSignal(dataPtr);
+    if (sNNullData != 0 || ! dataPtr)
+    {
+        KTERROR(testsiglog, "A value slot was given the pointer after a reference slot took its data");
+        return -1;
+    }
+
+    KTINFO(testsiglog, "Calling the value slots before the reference slots, whatever their groups");
+    KTSignalData orderSignal;
+    orderSignal.Connect(KTSignalData::ref_slot_type(&RecordRefCall), 0, true);
+    orderSignal.Connect(KTSignalData::slot_type(&RecordValueCall), 5, true);
+    orderSignal.Connect(KTSignalData::slot_type(&RecordValueCall), 0, false);
+    orderSignal(KTDataPtr(new KTData()));
+    if (sCallOrder != "vvr")
+    {
+        KTERROR(testsiglog, "Slots were called in the order <" << sCallOrder << ">; expected <vvr>");
+        return -1;
+    }
+
+    KTINFO(testsiglog, "Emitting data to a parallel group of slots that each add to the data");
+    KTSignalData parallelSignal;
+    parallelSignal.Connect(KTSignalData::slot_type(&AddTestData), 5, true);
+    parallelSignal.Connect(KTSignalData::slot_type(&AddSecondTestData), 5, true);
+    parallelSignal.Connect(KTSignalData::slot_type(&AddAwesomeCutResult), 5, true);
+    parallelSignal.Connect(KTSignalData::slot_type(&AddNotAwesomeCutResult), 5, true);
+    parallelSignal.SetParallelGroup(5, true);
+    KTSignalData outerSignal;
+    outerSignal.Connect(KTSignalData::slot_type(boost::bind(&EmitAgain, &parallelSignal, _1)), 1, true);
+    outerSignal.Connect(KTSignalData::slot_type(&CheckData), 1, true);
+    outerSignal.SetParallelGroup(1, true);
+    const unsigned nThreads = 4;
+    unsigned nBad[nThreads] = {};
+    boost::thread_group threads;
+    for (unsigned iThread = 0; iThread < nThreads; ++iThread)
+    {
+        // half of the threads emit to the parallel group from within another
+        KTSignalData* signal = iThread % 2 == 0 ? &parallelSignal : &outerSignal;
+        threads.create_thread(boost::bind(&EmitToParallelGroup, signal, 1000, &nBad[iThread]));
+    }
+    threads.join_all();
+    for (unsigned iThread = 0; iThread < nThreads; ++iThread)
+    {
+        if (nBad[iThread] != 0)
+        {
+            KTERROR(testsiglog, nBad[iThread] << " data object(s) emitted by thread " << iThread << " are missing extensions or cut results");
+            return -1;
+        }
+    }
+
     KTINFO(testsiglog, "Tests complete");
     return 0;
     /**/
@@ -0,0 +1,145 @@
+/*
+ * TestStaticChain.cc
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: nsoblath
+ */
+
+#include "KTTestCuts.hh"
+
+#include "KTLogger.hh"
+#include "KTSlot.hh"
+#include "KTStaticChain.hh"
+
+KTLOGGER(testlog, "TestStaticChain");
+
+using namespace Nymph;
+
+namespace Nymph
+{
+    // Makes the data awesome, if it isn't already
+    class KTTestMakeAwesome : public KTProcessor
+    {
+        public:
+            KTTestMakeAwesome(const std::string& name = "make-awesome") :
+                    KTProcessor(name),
+                    fNCalls(0)
+            {}
+            virtual ~KTTestMakeAwesome() {}
+
+            bool Configure(const scarab::param_node&)
+            {
+                return true;
+            }
+
+            bool MakeAwesome(KTTestData& data)
+            {
+                ++fNCalls;
+                data.SetIsAwesome(true);
+                return true;
+            }
+
+            unsigned fNCalls;
+    };
+
+    // Fails unless the data is awesome
+    class KTTestRequireAwesome : public KTProcessor
+    {
+        public:
+            KTTestRequireAwesome(const std::string& name = "require-awesome") :
+                    KTProcessor(name),
+                    fNCalls(0)
+            {}
+            virtual ~KTTestRequireAwesome() {}
+
+            bool Configure(const scarab::param_node&)
+            {
+                return true;
+            }
+
+            bool RequireAwesome(KTTestData& data)
+            {
+                ++fNCalls;
+                return data.GetIsAwesome();
+            }
+
+            unsigned fNCalls;
+    };
+
+    class KTTestChainReceiver : public KTProcessor
+    {
+        public:
+            KTTestChainReceiver() :
+                    KTProcessor("test-chain-receiver"),
+                    fNData(0),
+                    fSlot("data", this, &KTTestChainReceiver::Receive)
+            {}
+            virtual ~KTTestChainReceiver() {}
+
+            bool Configure(const scarab::param_node&)
+            {
+                return true;
+            }
+
+            bool Receive(KTTestData&)
+            {
+                ++fNData;
+                return true;
+            }
+
+            unsigned fNData;
+
+        private:
+            KTSlotDataOneType< KTTestData > fSlot;
+    };
+
+    typedef KTStaticChain< KTChainStage< KTTestMakeAwesome, KTTestData, &KTTestMakeAwesome::MakeAwesome >,
+                           KTChainStage< KTTestRequireAwesome, KTTestData, &KTTestRequireAwesome::RequireAwesome > > KTTestChain;
+
+    typedef KTStaticChain< KTChainStage< KTTestRequireAwesome, KTTestData, &KTTestRequireAwesome::RequireAwesome >,
+                           KTChainStage< KTTestMakeAwesome, KTTestData, &KTTestMakeAwesome::MakeAwesome > > KTTestReversedChain;
+}
+
+int main()
+{
+    KTTestChain chain;
+    KTTestReversedChain reversedChain;
+    KTTestChainReceiver receiver;
+
+    try
+    {
+        chain.ConnectASlot("data", &receiver, "data");
+        reversedChain.ConnectASlot("data", &receiver, "data");
+    }
+    catch(std::exception& e)
+    {
+        KTERROR(testlog, "A problem occurred while connecting the signal and slots:\n" << e.what());
+        return -1;
+    }
+
+    KTINFO(testlog, "Running 3 data objects through each chain; the last one does not have test data");
+    for (unsigned iData = 0; iData < 3; ++iData)
+    {
+        KTDataPtr data(new KTData());
+        if (iData != 2) data->Of< KTTestData >().SetIsAwesome(false);
+        chain.ProcessData(data);
+
+        KTDataPtr reversedData(new KTData());
+        if (iData != 2) reversedData->Of< KTTestData >().SetIsAwesome(false);
+        reversedChain.ProcessData(reversedData);
+    }
+
+    // The reversed chain stops at its first stage, since the data isn't awesome yet
+    if (chain.GetProcessor< 0 >().fNCalls != 2 || chain.GetProcessor< 1 >().fNCalls != 2 ||
+        reversedChain.GetProcessor< 0 >().fNCalls != 2 || reversedChain.GetProcessor< 1 >().fNCalls != 0 ||
+        receiver.fNData != 2)
+    {
+        KTERROR(testlog, "Unexpected number of calls: chain: " << chain.GetProcessor< 0 >().fNCalls << ", " << chain.GetProcessor< 1 >().fNCalls
+                << "; reversed chain: " << reversedChain.GetProcessor< 0 >().fNCalls << ", " << reversedChain.GetProcessor< 1 >().fNCalls
+                << "; receiver: " << receiver.fNData);
+        return -1;
+    }
+
+    KTINFO(testlog, "Tests complete");
+    return 0;
+}
@@ -0,0 +1,75 @@
+/*
+ * KTBatchAccumulator.cc
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: nsoblath
+ */
+
+#include "KTBatchAccumulator.hh"
+
+#include "KTLogger.hh"
+
+namespace Nymph
+{
+    KTLOGGER(batchlog, "KTBatchAccumulator");
+
+    KT_REGISTER_PROCESSOR(KTBatchAccumulator, "batch-accumulator");
+
+    KTBatchAccumulator::KTBatchAccumulator(const std::string& name) :
+            KTProcessor(name),
+            fBatchSize(64),
+            fBatch(),
+            fBatchSignal("batch", this),
+            fDoneSignal("done", this)
+    {
+        RegisterSlot("data", this, &KTBatchAccumulator::AddData);
+        RegisterSlot("flush", this, &KTBatchAccumulator::Flush);
+    }
+
+    KTBatchAccumulator::~KTBatchAccumulator()
+    {
+    }
+
+    bool KTBatchAccumulator::Configure(const scarab::param_node& node)
+    {
+        SetBatchSize(node.get_value< unsigned >("batch-size", fBatchSize));
+        if (fBatchSize == 0)
+        {
+            KTERROR(batchlog, "Batch size must be greater than 0");
+            return false;
+        }
+        fBatch.reserve(fBatchSize);
+        return true;
+    }
+
+    void KTBatchAccumulator::AddData(const KTDataPtr& data)
+    {
+        fBatch.push_back(data);
+        if (fBatch.size() >= fBatchSize || data->GetLastData())
+        {
+            EmitBatch();
+        }
+        return;
+    }
+
+    void KTBatchAccumulator::Flush()
+    {
+        if (! fBatch.empty())
+        {
+            EmitBatch();
+        }
+        KTDEBUG(batchlog, "Flushed batch accumulator <" << GetConfigName() << ">");
+        fDoneSignal();
+        return;
+    }
+
+    void KTBatchAccumulator::EmitBatch()
+    {
+        KTDEBUG(batchlog, "Emitting batch of " << fBatch.size() << " data objects");
+        fBatchSignal(fBatch);
+        // clearing keeps the capacity, so the next batch doesn't need to allocate
+        fBatch.clear();
+        return;
+    }
+
+} /* namespace Nymph */
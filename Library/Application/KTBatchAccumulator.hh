@@ -0,0 +1,75 @@
+/*
+ * KTBatchAccumulator.hh
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: nsoblath
+ */
+
+#ifndef KTBATCHACCUMULATOR_HH_
+#define KTBATCHACCUMULATOR_HH_
+
+#include "KTProcessor.hh"
+
+#include "KTData.hh"
+#include "KTMemberVariable.hh"
+#include "KTSignal.hh"
+
+#include <string>
+
+namespace Nymph
+{
+    /*!
+     @class KTBatchAccumulator
+     @author N. S. Oblath
+
+     @brief Collects data objects from a single-object signal into batches, so they can be used by batch slots (e.g. KTSlotDataBatch).
+
+     @details
+     A batch is emitted when it reaches the configured size, when a data object flagged as the last data is received,
+     or when the "flush" slot is called.
+
+     Configuration name: "batch-accumulator"
+
+     Available configuration values:
+     - "batch-size": unsigned -- number of data objects in a full batch (default: 64)
+
+     Slots:
+     - "data": void (KTDataPtr) -- Add a data object to the current batch
+     - "flush": void () -- Emit the current batch, if it has any data, and then emit "done"
+
+     Signals:
+     - "batch": void (const KTDataPtrBatch&) -- Emitted with each batch; "each-batch" is also available for single-object slots (see KTSignalDataBatch)
+     - "done": void () -- Emitted after a flush
+    */
+    class KTBatchAccumulator : public KTProcessor
+    {
+        public:
+            KTBatchAccumulator(const std::string& name = "batch-accumulator");
+            virtual ~KTBatchAccumulator();
+
+            bool Configure(const scarab::param_node& node);
+
+            MEMBERVARIABLE(unsigned, BatchSize);
+
+        public:
+            void AddData(const KTDataPtr& data);
+
+            void Flush();
+
+        private:
+            void EmitBatch();
+
+            KTDataPtrBatch fBatch;
+
+            //***************
+            // Signals
+            //***************
+
+        private:
+            KTSignalDataBatch fBatchSignal;
+            KTSignalDone fDoneSignal;
+
+    };
+
+} /* namespace Nymph */
+#endif /* KTBATCHACCUMULATOR_HH_ */
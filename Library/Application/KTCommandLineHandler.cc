@@ -43,8 +43,8 @@ namespace Nymph
             fCommandLineVarMap(),
             fConfigOverrideValues(),
             fPrintHelpMessage(false),
-            fPrintVersionMessage(false),
             fPrintHelpMessageAfterConfig(false),
+            fPrintVersionMessage(false),
             fConfigFilename(),
             fCommandLineJSON()
     {
@@ -298,10 +298,9 @@ namespace Nymph
     {
         KTDEBUG(eqplog, "Queueing data");
         DataAndFunc daf;
-        daf.fData = data; // I'd like to use move semantics here (operator=(shared_ptr&&)), but they didn't work, so I bootstrapped with copy and reset.
-        data.reset();
+        daf.fData = std::move(data); // leaves data empty
         daf.fFuncPtr = func;
-        fQueue.push(daf);
+        fQueue.push(std::move(daf));
         return;
     }
 /*
@@ -8,6 +8,7 @@
 #include "KTPrintDataStructure.hh"
 
 #include "KTLogger.hh"
+#include "KTMemoryAccounting.hh"
 
 #include <sstream>
 
@@ -25,7 +26,8 @@ namespace Nymph
             fDataSignal("data", this),
             fDataStructSlot("print-data", this, &KTPrintDataStructure::PrintDataStructure),
             fCutStructSlot("print-cuts", this, &KTPrintDataStructure::PrintCutStructure),
-            fDataAndCutStructSlot("print-data-and-cuts", this, &KTPrintDataStructure::PrintDataAndCutStructure)
+            fDataAndCutStructSlot("print-data-and-cuts", this, &KTPrintDataStructure::PrintDataAndCutStructure),
+            fMemorySlot("print-memory", this, &KTPrintDataStructure::PrintMemory)
     {
     }
 
@@ -38,7 +40,7 @@ namespace Nymph
         return true;
     }
 
-    void KTPrintDataStructure::PrintDataStructure(KTDataPtr dataPtr)
+    void KTPrintDataStructure::PrintDataStructure(const KTDataPtr& dataPtr)
     {
         DoPrintDataStructure(dataPtr);
 
@@ -47,7 +49,7 @@ namespace Nymph
         return;
     }
 
-    void KTPrintDataStructure::PrintCutStructure(KTDataPtr dataPtr)
+    void KTPrintDataStructure::PrintCutStructure(const KTDataPtr& dataPtr)
     {
         DoPrintCutStructure(dataPtr);
 
@@ -57,7 +59,7 @@ namespace Nymph
     }
 
 
-    void KTPrintDataStructure::PrintDataAndCutStructure(KTDataPtr dataPtr)
+    void KTPrintDataStructure::PrintDataAndCutStructure(const KTDataPtr& dataPtr)
     {
         DoPrintDataStructure(dataPtr);
         DoPrintCutStructure(dataPtr);
@@ -67,7 +69,16 @@ namespace Nymph
         return;
     }
 
-    void KTPrintDataStructure::DoPrintDataStructure(KTDataPtr dataPtr)
+    void KTPrintDataStructure::PrintMemory(const KTDataPtr& dataPtr)
+    {
+        DoPrintMemory();
+
+        fDataSignal(dataPtr);
+
+        return;
+    }
+
+    void KTPrintDataStructure::DoPrintDataStructure(const KTDataPtr& dataPtr)
     {
         std::stringstream printbuf;
 
@@ -87,7 +98,7 @@ namespace Nymph
         return;
     }
 
-    void KTPrintDataStructure::DoPrintCutStructure(KTDataPtr dataPtr)
+    void KTPrintDataStructure::DoPrintCutStructure(const KTDataPtr& dataPtr)
     {
         std::stringstream printbuf;
 
@@ -108,4 +119,22 @@ namespace Nymph
         return;
     }
 
+    void KTPrintDataStructure::DoPrintMemory()
+    {
+        if (! KTMemoryAccounting::GetIsEnabled())
+        {
+            KTWARN(datalog, "Memory accounting is not enabled");
+            return;
+        }
+
+        std::stringstream printbuf;
+
+        printbuf << "\nMemory:\n";
+        KTMemoryAccounting::PrintReport(printbuf);
+
+        KTINFO(datalog, printbuf.str());
+
+        return;
+    }
+
 } /* namespace Nymph */
@@ -38,6 +38,7 @@ namespace Nymph
      - "print-data": void (KTDataPtr) -- Prints the structure of the data object; Does not modify the data or cuts; Emits signal "data"
      - "print-cuts": void (KTDataPtr) -- Prints the structure of the data's cuts; Does not modify the data or cuts; Emits signal "data"
      - "print-data-and-cuts": void (KTDataPtr) -- Prints the structure of the data object and its cuts; Does not modify the data or cuts; Emits signal "data"
+     - "print-memory": void (KTDataPtr) -- Prints the memory used by the objects of each data and cut type that are alive (see KTMemoryAccounting; accounting must be enabled); Does not modify the data or cuts; Emits signal "data"
 
      Signals:
      - "data": void (KTDataPtr) -- Emitted after structure information is printed
@@ -52,13 +53,15 @@ namespace Nymph
             bool Configure(const scarab::param_node& node);
 
         public:
-            void PrintDataStructure(KTDataPtr dataPtr);
-            void PrintCutStructure(KTDataPtr dataPtr);
-            void PrintDataAndCutStructure(KTDataPtr dataPtr);
+            void PrintDataStructure(const KTDataPtr& dataPtr);
+            void PrintCutStructure(const KTDataPtr& dataPtr);
+            void PrintDataAndCutStructure(const KTDataPtr& dataPtr);
+            void PrintMemory(const KTDataPtr& dataPtr);
 
         private:
-            void DoPrintDataStructure(KTDataPtr dataPtr);
-            void DoPrintCutStructure(KTDataPtr dataPtr);
+            void DoPrintDataStructure(const KTDataPtr& dataPtr);
+            void DoPrintCutStructure(const KTDataPtr& dataPtr);
+            void DoPrintMemory();
 
             //***************
             // Signals
@@ -72,9 +75,10 @@ namespace Nymph
             //***************
 
         private:
-            KTSlotOneArg< void (KTDataPtr) > fDataStructSlot;
-            KTSlotOneArg< void (KTDataPtr) > fCutStructSlot;
-            KTSlotOneArg< void (KTDataPtr) > fDataAndCutStructSlot;
+            KTSlotOneArg< void (const KTDataPtr&) > fDataStructSlot;
+            KTSlotOneArg< void (const KTDataPtr&) > fCutStructSlot;
+            KTSlotOneArg< void (const KTDataPtr&) > fDataAndCutStructSlot;
+            KTSlotOneArg< void (const KTDataPtr&) > fMemorySlot;
 
     };
 }
@@ -7,12 +7,23 @@
 
 #include "KTProcessorToolbox.hh"
 
+#include "KTAsyncStage.hh"
+#include "KTConnectionStats.hh"
+#include "KTCutFlow.hh"
 #include "KTLogger.hh"
+#include "KTMemoryAccounting.hh"
 #include "KTPrimaryProcessor.hh"
+#include "KTReplicatedProcessor.hh"
+#include "KTSignalWrapper.hh"
 
 #include "factory.hh"
 #include "param_codec.hh"
 
+#include <algorithm>
+#include <exception>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
 #include <vector>
 
 #ifndef SINGLETHREADED
@@ -30,14 +41,25 @@ namespace Nymph
 
     KTProcessorToolbox::KTProcessorToolbox(const std::string& name) :
             KTConfigurable(name),
-            fRunQueue(),
-            fProcMap()
+            fProcMap(),
+            fAsyncStages(),
+            fDataSignals(),
+            fDirectSlotProcs(),
+            fProfileConnections(false),
+            fConnectionStats(),
+            fCutFlowFilename(),
+            fEnabledMemoryAccounting(false),
+            fEnabledCutFlow(false),
+            fRunQueue()
     {
     }
 
     KTProcessorToolbox::~KTProcessorToolbox()
     {
         ClearProcessors();
+        // the flags are global, so they'd otherwise stay on for whatever runs after this toolbox
+        if (fEnabledMemoryAccounting) KTMemoryAccounting::SetIsEnabled(false);
+        if (fEnabledCutFlow) KTCutFlow::SetIsEnabled(false);
     }
 
     bool KTProcessorToolbox::Configure(const scarab::param_node& node)
@@ -45,6 +67,56 @@ namespace Nymph
         auto tProcFactory = scarab::factory< KTProcessor, const std::string& >::get_instance();
 
         KTPROG(proclog, "Configuring . . .");
+
+        // Profiling has to be switched on before any connections are made
+        SetProfileConnections(node.get_value("profile-connections", fProfileConnections));
+        if (fProfileConnections)
+        {
+            KTINFO(proclog, "Connections will be profiled");
+        }
+
+        if (node.get_value("account-memory", false))
+        {
+            if (! KTMemoryAccounting::GetIsEnabled()) fEnabledMemoryAccounting = true;
+            KTMemoryAccounting::SetIsEnabled(true);
+            KTINFO(proclog, "Memory used by data objects will be accounted");
+        }
+
+        if (node.has("cut-flow"))
+        {
+            const scarab::param& cutFlowParam = node["cut-flow"];
+            bool doCutFlow = true;
+            if (cutFlowParam.is_value())
+            {
+                doCutFlow = cutFlowParam().as_bool();
+            }
+            else if (cutFlowParam.is_node())
+            {
+                const scarab::param_node& cutFlowNode = cutFlowParam.as_node();
+                if (cutFlowNode.has("order"))
+                {
+                    std::vector< std::string > order;
+                    const scarab::param_array& orderArray = cutFlowNode["order"].as_array();
+                    for (scarab::param_array::const_iterator orderIt = orderArray.begin(); orderIt != orderArray.end(); ++orderIt)
+                    {
+                        order.push_back((*orderIt)().as_string());
+                    }
+                    if (! KTCutFlow::SetOrder(order))
+                    {
+                        KTERROR(proclog, "Unable to set the order of the cut flow");
+                        return false;
+                    }
+                }
+                fCutFlowFilename = cutFlowNode.get_value("file", fCutFlowFilename);
+            }
+            if (doCutFlow && ! KTCutFlow::GetIsEnabled()) fEnabledCutFlow = true;
+            KTCutFlow::SetIsEnabled(doCutFlow);
+            if (doCutFlow)
+            {
+                KTINFO(proclog, "The cut flow will be recorded");
+            }
+        }
+
         // Deal with "processor" blocks first
         if (! node.has("processors"))
         {
@@ -79,7 +151,23 @@ namespace Nymph
                 {
                     procName = procNode["name"]().as_string();
                 }
-                KTProcessor* newProc = tProcFactory->create(procType, procType);
+                unsigned nReplicas = procNode.get_value< unsigned >("replicas", 1);
+#ifdef SINGLETHREADED
+                if (nReplicas > 1)
+                {
+                    KTWARN(proclog, "Replicas are not available in single-threaded mode; creating a single instance of processor <" << procName << ">");
+                    nReplicas = 1;
+                }
+#endif
+                KTProcessor* newProc = NULL;
+                if (nReplicas > 1)
+                {
+                    newProc = CreateReplicatedProcessor(procType, procName, nReplicas, procNode.get_value("shard-by", string("counter")));
+                }
+                else
+                {
+                    newProc = tProcFactory->create(procType, procType);
+                }
                 if (newProc == NULL)
                 {
                     KTERROR(proclog, "Unable to create processor of type <" << procType << ">");
@@ -104,6 +192,19 @@ namespace Nymph
         else
         {
             const scarab::param_array& connArray = node["connections"].as_array();
+#ifndef SINGLETHREADED
+            // the stages are made first, so that the regular connections to a processor with asynchronous connections
+            // are queued on its stage however the connections are ordered
+            for( scarab::param_array::const_iterator connIt = connArray.begin(); connIt != connArray.end(); ++connIt )
+            {
+                if( ! connIt->is_node() ) continue;
+                const scarab::param_node& connNode = connIt->as_node();
+                string slotProcName, slotName;
+                if (! connNode.get_value("async", false) || ! connNode.has("slot") || ! ParseSignalSlotName(connNode["slot"]().as_string(), slotProcName, slotName)) continue;
+                if (GetProcessor(slotProcName) == NULL) continue;
+                GetAsyncStage(slotProcName, connNode.get_value< unsigned >("queue-depth", KTAsyncStage::sDefaultQueueDepth));
+            }
+#endif
             for( scarab::param_array::const_iterator connIt = connArray.begin(); connIt != connArray.end(); ++connIt )
             {
                 if( ! connIt->is_node() )
@@ -137,13 +238,16 @@ namespace Nymph
                 }
 
                 bool connReturn = false;
-                if (connNode.has("order"))
+                int order = connNode.has("order") ? connNode["order"]().as_int() : std::numeric_limits< int >::min();
+                KTDataPredicate predicate = ParseConnectionPredicate(connNode);
+                if (connNode.get_value("async", false))
                 {
-                    connReturn = MakeConnection(connNode["signal"]().as_string(), connNode["slot"]().as_string(), connNode["order"]().as_int());
+                    unsigned queueDepth = connNode.get_value< unsigned >("queue-depth", KTAsyncStage::sDefaultQueueDepth);
+                    connReturn = MakeAsyncConnection(connNode["signal"]().as_string(), connNode["slot"]().as_string(), queueDepth, order, predicate);
                 }
                 else
                 {
-                    connReturn = MakeConnection(connNode["signal"]().as_string(), connNode["slot"]().as_string());
+                    connReturn = MakeConnection(connNode["signal"]().as_string(), connNode["slot"]().as_string(), order, predicate);
                 }
                 if (! connReturn)
                 {
@@ -151,6 +255,19 @@ namespace Nymph
                     return false;
                 }
 
+                if (connNode.get_value("parallel", false))
+                {
+                    if (! connNode.has("order"))
+                    {
+                        KTERROR(proclog, "Parallel connection <" << connNode["signal"]().as_string() << "> --> <" << connNode["slot"]().as_string() << "> requires an order");
+                        return false;
+                    }
+                    if (! SetParallelGroup(connNode["signal"]().as_string(), order))
+                    {
+                        return false;
+                    }
+                }
+
                 KTINFO(proclog, "Signal <" << connNode["signal"]().as_string() << "> connected to slot <" << connNode["slot"]().as_string() << ">");
             }
         }
@@ -288,10 +405,39 @@ namespace Nymph
             }
             // wait for execution to complete
             parallelThreads.join_all();
+            // the group is complete once everything it queued for asynchronous slots has been processed
+            try
+            {
+                DrainAsyncStages();
+            }
+            catch (std::exception& e)
+            {
+                KTERROR(proclog, "An asynchronous slot failed in thread group " << iGroup << ":\n" << e.what());
+                return false;
+            }
+            catch (...)
+            {
+                KTERROR(proclog, "An asynchronous slot failed in thread group " << iGroup << " with an unknown exception");
+                return false;
+            }
             iGroup++;
 #endif
         }
         KTPROG(proclog, ". . . processing complete.");
+        if (fProfileConnections)
+        {
+            PrintConnectionStats();
+        }
+        if (KTMemoryAccounting::GetIsEnabled())
+        {
+            std::stringstream table;
+            KTMemoryAccounting::PrintReport(table);
+            KTPROG(proclog, "Memory accounting:\n" << table.str());
+        }
+        if (KTCutFlow::GetIsEnabled())
+        {
+            ReportCutFlow();
+        }
         return true;
     }
 
@@ -378,6 +524,16 @@ namespace Nymph
             KTWARN(proclog, "Processor <" << procName << "> was not found.");
             return NULL;
         }
+        StopAsyncStage(procName);
+        RemoveConnections(procName);
+        KTReplicatedProcessor* replicated = dynamic_cast< KTReplicatedProcessor* >(it->second.fProc);
+        if (replicated != NULL)
+        {
+            for (unsigned iReplica = 0; iReplica < replicated->GetNReplicas(); ++iReplica)
+            {
+                StopAsyncStage(replicated->GetStage(iReplica)->GetName());
+            }
+        }
         KTProcessor* procToRelease = it->second.fProc;
         fProcMap.erase(it);
         return procToRelease;
@@ -385,6 +541,15 @@ namespace Nymph
 
     void KTProcessorToolbox::ClearProcessors()
     {
+        // the stage threads call into the processors, so they have to be stopped first
+        for (AsyncStageMapIt it = fAsyncStages.begin(); it != fAsyncStages.end(); ++it)
+        {
+            it->second->Stop();
+        }
+        fAsyncStages.clear();
+        fDataSignals.clear();
+        fDirectSlotProcs.clear();
+
         for (ProcMapIt it = fProcMap.begin(); it != fProcMap.end(); it++)
         {
             delete it->second.fProc;
@@ -395,7 +560,84 @@ namespace Nymph
     }
 
 
-    bool KTProcessorToolbox::MakeConnection(const std::string& signal, const std::string& slot, int order)
+    bool KTProcessorToolbox::MakeConnection(const std::string& signal, const std::string& slot, int order, const KTDataPredicate& predicate)
+    {
+        string signalProcName, signalName;
+        if (! ParseSignalSlotName(signal, signalProcName, signalName))
+        {
+            KTERROR(proclog, "Unable to parse signal name: <" << signal << ">");
+            return false;
+        }
+
+        string slotProcName, slotName;
+        if (! ParseSignalSlotName(slot, slotProcName, slotName))
+        {
+            KTERROR(proclog, "Unable to parse slot name: <" << slot << ">");
+            return false;
+        }
+
+        return MakeConnection(signalProcName, signalName, slotProcName, slotName, order, predicate);
+    }
+
+    bool KTProcessorToolbox::MakeConnection(const std::string& signalProcName, const std::string& signalName, const std::string& slotProcName, const std::string& slotName, int order, const KTDataPredicate& predicate)
+    {
+        KTProcessor* signalProc = GetProcessor(signalProcName);
+        if (signalProc == NULL)
+        {
+            KTERROR(proclog, "Processor named <" << signalProcName << "> was not found!");
+            return false;
+        }
+
+        KTProcessor* slotProc = GetProcessor(slotProcName);
+        if (slotProc == NULL)
+        {
+            KTERROR(proclog, "Processor named <" << slotProcName << "> was not found!");
+            return false;
+        }
+
+#ifndef SINGLETHREADED
+        // the processor's slots are called on its stage, in order; calling this one directly could overtake the calls that are still queued
+        AsyncStageMapIt stageIt = fAsyncStages.find(slotProcName);
+        if (stageIt != fAsyncStages.end())
+        {
+            KTINFO(proclog, "Processor <" << slotProcName << "> has asynchronous connections, so the connection from <"
+                    << signalProcName << ":" << signalName << "> to <" << slotProcName << ":" << slotName << "> is asynchronous too");
+            return MakeAsyncConnection(signalProcName, signalName, slotProcName, slotName, stageIt->second->GetQueueDepth(), order, predicate);
+        }
+#endif
+
+        if (! CheckDataSignal(signalProc, signalProcName, signalName, false))
+        {
+            return false;
+        }
+
+        try
+        {
+            boost::shared_ptr< KTConnectionStats > stats = MakeConnectionStats(signalProcName, signalName, slotProcName, slotName);
+            if (order != std::numeric_limits< int >::min())
+            {
+                signalProc->ConnectASlot(signalName, slotProc, slotName, order, stats, predicate);
+            }
+            else
+            {
+                signalProc->ConnectASlot(signalName, slotProc, slotName, -1, stats, predicate);
+            }
+        }
+        catch (std::exception& e)
+        {
+            KTERROR(proclog, "An error occurred while connecting signals and slots:\n"
+                    << "\tSignal " << signalName << " from processor " << signalProcName << " (a.k.a. " << signalProc->GetConfigName() << ")" << '\n'
+                    << "\tSlot " << slotName << " from processor " << slotProcName << " (a.k.a. " << slotProc->GetConfigName() << ")" << '\n'
+                    << '\t' << e.what());
+            return false;
+        }
+
+        AddDataSignal(signalProc, signalProcName, signalName, false);
+        fDirectSlotProcs.insert(slotProcName);
+        return true;
+    }
+
+    bool KTProcessorToolbox::MakeAsyncConnection(const std::string& signal, const std::string& slot, unsigned queueDepth, int order, const KTDataPredicate& predicate)
     {
         string signalProcName, signalName;
         if (! ParseSignalSlotName(signal, signalProcName, signalName))
@@ -411,11 +653,17 @@ namespace Nymph
             return false;
         }
 
-        return MakeConnection(signalProcName, signalName, slotProcName, slotName, order);
+        return MakeAsyncConnection(signalProcName, signalName, slotProcName, slotName, queueDepth, order, predicate);
     }
 
-    bool KTProcessorToolbox::MakeConnection(const std::string& signalProcName, const std::string& signalName, const std::string& slotProcName, const std::string& slotName, int order)
+    bool KTProcessorToolbox::MakeAsyncConnection(const std::string& signalProcName, const std::string& signalName, const std::string& slotProcName, const std::string& slotName, unsigned queueDepth, int order, const KTDataPredicate& predicate)
     {
+#ifdef SINGLETHREADED
+        KTWARN(proclog, "Asynchronous connections are not available in single-threaded mode; making a regular connection from <"
+                << signalProcName << ":" << signalName << "> to <" << slotProcName << ":" << slotName << ">");
+        (void)queueDepth;
+        return MakeConnection(signalProcName, signalName, slotProcName, slotName, order, predicate);
+#else
         KTProcessor* signalProc = GetProcessor(signalProcName);
         if (signalProc == NULL)
         {
@@ -430,15 +678,28 @@ namespace Nymph
             return false;
         }
 
+        if (fDirectSlotProcs.count(slotProcName) != 0)
+        {
+            KTERROR(proclog, "Processor <" << slotProcName << "> already has regular connections, which would not be queued with the asynchronous ones; "
+                    << "make the asynchronous connections to it first");
+            return false;
+        }
+        if (! CheckDataSignal(signalProc, signalProcName, signalName, true))
+        {
+            return false;
+        }
+
         try
         {
+            boost::shared_ptr< KTAsyncStage > stage = GetAsyncStage(slotProcName, queueDepth);
+            boost::shared_ptr< KTConnectionStats > stats = MakeConnectionStats(signalProcName, signalName, slotProcName, slotName);
             if (order != std::numeric_limits< int >::min())
             {
-                signalProc->ConnectASlot(signalName, slotProc, slotName, order);
+                signalProc->ConnectASlotAsync(signalName, slotProc, slotName, stage, order, stats, predicate);
             }
             else
             {
-                signalProc->ConnectASlot(signalName, slotProc, slotName);
+                signalProc->ConnectASlotAsync(signalName, slotProc, slotName, stage, -1, stats, predicate);
             }
         }
         catch (std::exception& e)
@@ -450,9 +711,246 @@ namespace Nymph
             return false;
         }
 
+        AddDataSignal(signalProc, signalProcName, signalName, true);
+        return true;
+#endif
+    }
+
+    bool KTProcessorToolbox::SetParallelGroup(const std::string& signal, int order, bool isParallel)
+    {
+        string signalProcName, signalName;
+        if (! ParseSignalSlotName(signal, signalProcName, signalName))
+        {
+            KTERROR(proclog, "Unable to parse signal name: <" << signal << ">");
+            return false;
+        }
+
+        KTProcessor* signalProc = GetProcessor(signalProcName);
+        if (signalProc == NULL)
+        {
+            KTERROR(proclog, "Processor named <" << signalProcName << "> was not found!");
+            return false;
+        }
+
+        KTSignalWrapper* signalWrap = signalProc->GetSignal(signalName);
+        if (signalWrap == NULL)
+        {
+            KTERROR(proclog, "Signal <" << signalName << "> was not found in processor <" << signalProcName << ">");
+            return false;
+        }
+
+        signalWrap->SetParallelGroup(order, isParallel);
+        KTDEBUG(proclog, "Slots connected to signal <" << signal << "> with order " << order << " will be called " << (isParallel ? "concurrently" : "sequentially"));
         return true;
     }
 
+    const KTConnectionStats* KTProcessorToolbox::GetConnectionStats(const std::string& connection) const
+    {
+        ConnStatsMapCIt it = fConnectionStats.find(connection);
+        if (it == fConnectionStats.end()) return NULL;
+        return it->second.get();
+    }
+
+    boost::shared_ptr< KTConnectionStats > KTProcessorToolbox::MakeConnectionStats(const std::string& signalProcName, const std::string& signalName, const std::string& slotProcName, const std::string& slotName)
+    {
+        if (! fProfileConnections) return boost::shared_ptr< KTConnectionStats >();
+
+        string connection = signalProcName + fSigSlotNameSep + signalName + " -> " + slotProcName + fSigSlotNameSep + slotName;
+        ConnStatsMapCIt it = fConnectionStats.find(connection);
+        if (it != fConnectionStats.end())
+        {
+            // a reconnection keeps adding to the existing record
+            return it->second;
+        }
+        boost::shared_ptr< KTConnectionStats > stats(new KTConnectionStats(connection));
+        fConnectionStats.insert(ConnStatsMapValue(connection, stats));
+        return stats;
+    }
+
+    namespace
+    {
+        typedef std::pair< std::string, KTConnectionStats::Summary > NamedSummary;
+        bool MoreTotalTime(const NamedSummary& lhs, const NamedSummary& rhs)
+        {
+            return lhs.second.fTotalTime > rhs.second.fTotalTime;
+        }
+    }
+
+    void KTProcessorToolbox::PrintConnectionStats() const
+    {
+        vector< NamedSummary > summaries;
+        size_t nameWidth = 10;
+        for (ConnStatsMapCIt it = fConnectionStats.begin(); it != fConnectionStats.end(); ++it)
+        {
+            summaries.push_back(NamedSummary(it->first, it->second->GetSummary()));
+            nameWidth = std::max(nameWidth, it->first.size());
+        }
+        std::sort(summaries.begin(), summaries.end(), MoreTotalTime);
+
+        std::stringstream table;
+        table << std::left << std::setw(nameWidth) << "Connection" << std::right
+                << std::setw(12) << "Calls" << std::setw(12) << "Exceptions"
+                << std::setw(14) << "Total (s)" << std::setw(14) << "Mean (us)" << std::setw(14) << "Max (us)" << '\n';
+        table << std::fixed;
+        for (vector< NamedSummary >::const_iterator it = summaries.begin(); it != summaries.end(); ++it)
+        {
+            const KTConnectionStats::Summary& summary = it->second;
+            double mean = summary.fNCalls == 0 ? 0. : (double)summary.fTotalTime / (double)summary.fNCalls;
+            table << std::left << std::setw(nameWidth) << it->first << std::right
+                    << std::setw(12) << summary.fNCalls << std::setw(12) << summary.fNExceptions
+                    << std::setw(14) << std::setprecision(6) << (double)summary.fTotalTime * 1.e-9
+                    << std::setw(14) << std::setprecision(3) << mean * 1.e-3
+                    << std::setw(14) << std::setprecision(3) << (double)summary.fMaxTime * 1.e-3 << '\n';
+        }
+        KTPROG(proclog, "Connection profile:\n" << table.str());
+        return;
+    }
+
+    void KTProcessorToolbox::ReportCutFlow() const
+    {
+        std::stringstream table;
+        KTCutFlow::PrintTable(table);
+        KTPROG(proclog, "Cut flow:\n" << table.str());
+
+        if (fCutFlowFilename.empty()) return;
+        std::ofstream file(fCutFlowFilename.c_str());
+        if (! file.is_open())
+        {
+            KTERROR(proclog, "Unable to open file <" << fCutFlowFilename << "> for the cut flow");
+            return;
+        }
+        KTCutFlow::WriteJSON(file);
+        KTINFO(proclog, "Cut flow written to <" << fCutFlowFilename << ">");
+        return;
+    }
+
+    boost::shared_ptr< KTAsyncStage > KTProcessorToolbox::GetAsyncStage(const std::string& procName, unsigned queueDepth)
+    {
+        AsyncStageMapIt it = fAsyncStages.find(procName);
+        if (it != fAsyncStages.end())
+        {
+            if (it->second->GetQueueDepth() != queueDepth)
+            {
+                KTWARN(proclog, "Asynchronous stage for processor <" << procName << "> already exists with queue depth " << it->second->GetQueueDepth() << "; requested depth (" << queueDepth << ") is ignored");
+            }
+            return it->second;
+        }
+        boost::shared_ptr< KTAsyncStage > stage(new KTAsyncStage(procName, queueDepth));
+        fAsyncStages.insert(AsyncStageMapValue(procName, stage));
+        return stage;
+    }
+
+    KTProcessor* KTProcessorToolbox::CreateReplicatedProcessor(const std::string& procType, const std::string& procName, unsigned nReplicas, const std::string& shardBy)
+    {
+        KTReplicatedProcessor::ShardKey shardKey;
+        if (shardBy == "counter")
+        {
+            shardKey = &KTReplicatedProcessor::ShardByCounter;
+        }
+        else if (shardBy != "arrival")
+        {
+            KTERROR(proclog, "Unknown shard key for processor <" << procName << ">: <" << shardBy << ">; options are \"counter\" and \"arrival\"");
+            return NULL;
+        }
+
+        auto tProcFactory = scarab::factory< KTProcessor, const std::string& >::get_instance();
+        std::vector< KTProcessor* > replicas;
+        for (unsigned iReplica = 0; iReplica < nReplicas; ++iReplica)
+        {
+            KTProcessor* replica = tProcFactory->create(procType, procType);
+            if (replica == NULL)
+            {
+                for (std::vector< KTProcessor* >::iterator it = replicas.begin(); it != replicas.end(); ++it)
+                {
+                    delete *it;
+                }
+                return NULL;
+            }
+            replicas.push_back(replica);
+        }
+
+        KTReplicatedProcessor* replicated = new KTReplicatedProcessor(procName, replicas);
+        replicated->SetShardKey(shardKey);
+        // the replicas' stages are drained and stopped along with the stages of asynchronous connections
+        for (unsigned iReplica = 0; iReplica < nReplicas; ++iReplica)
+        {
+            boost::shared_ptr< KTAsyncStage > stage = replicated->GetStage(iReplica);
+            fAsyncStages.insert(AsyncStageMapValue(stage->GetName(), stage));
+        }
+        KTINFO(proclog, "Created " << nReplicas << " replicas of processor <" << procName << ">");
+        return replicated;
+    }
+
+    void KTProcessorToolbox::DrainAsyncStages()
+    {
+        // tasks run by one stage can queue tasks on another, so keep going until a full pass finds no new work
+        // all of the stages are drained even if one has failed; the first failure is then rethrown
+        std::exception_ptr exception;
+        unsigned long nCompletedBefore = 0, nCompletedAfter = 0;
+        do
+        {
+            nCompletedBefore = nCompletedAfter;
+            nCompletedAfter = 0;
+            for (AsyncStageMapIt it = fAsyncStages.begin(); it != fAsyncStages.end(); ++it)
+            {
+                try
+                {
+                    it->second->Drain();
+                }
+                catch (...)
+                {
+                    if (! exception) exception = std::current_exception();
+                }
+                nCompletedAfter += it->second->GetNTasksCompleted();
+            }
+        } while (nCompletedAfter != nCompletedBefore);
+        if (exception) std::rethrow_exception(exception);
+        return;
+    }
+
+    void KTProcessorToolbox::StopAsyncStage(const std::string& procName)
+    {
+        AsyncStageMapIt it = fAsyncStages.find(procName);
+        if (it == fAsyncStages.end()) return;
+        it->second->Stop();
+        fAsyncStages.erase(it);
+        return;
+    }
+
+    bool KTProcessorToolbox::CheckDataSignal(KTProcessor* signalProc, const std::string& signalProcName, const std::string& signalName, bool isAsync) const
+    {
+        KTSignalWrapper* signal = signalProc->GetSignal(signalName);
+        // a signal that doesn't exist is reported when the connection is made
+        if (signal == NULL || ! signal->PassesData()) return true;
+
+        DataSignalMap::const_iterator it = fDataSignals.find(std::make_pair(signalProcName, signal->GetSignalObject()));
+        if (it == fDataSignals.end() || it->second == isAsync) return true;
+
+        // asynchronous slots would run while the regular ones modify the same data
+        KTERROR(proclog, "Signal <" << signalProcName << ":" << signalName << "> already has " << (isAsync ? "regular" : "asynchronous")
+                << " connections; a signal that passes data can't have both asynchronous and regular connections");
+        return false;
+    }
+
+    void KTProcessorToolbox::AddDataSignal(KTProcessor* signalProc, const std::string& signalProcName, const std::string& signalName, bool isAsync)
+    {
+        KTSignalWrapper* signal = signalProc->GetSignal(signalName);
+        if (signal == NULL || ! signal->PassesData()) return;
+        fDataSignals[std::make_pair(signalProcName, signal->GetSignalObject())] = isAsync;
+        return;
+    }
+
+    void KTProcessorToolbox::RemoveConnections(const std::string& procName)
+    {
+        for (DataSignalMap::iterator it = fDataSignals.begin(); it != fDataSignals.end();)
+        {
+            if (it->first.first == procName) fDataSignals.erase(it++);
+            else ++it;
+        }
+        fDirectSlotProcs.erase(procName);
+        return;
+    }
+
     bool KTProcessorToolbox::ParseSignalSlotName(const std::string& toParse, std::string& nameOfProc, std::string& nameOfSigSlot) const
     {
         size_t sepPos = toParse.find_first_of(fSigSlotNameSep);
@@ -466,6 +964,39 @@ namespace Nymph
         return true;
     }
 
+    KTDataPredicate KTProcessorToolbox::ParseConnectionPredicate(const scarab::param_node& connNode) const
+    {
+        KTDataPredicate predicate;
+
+        if (connNode.has("require-data"))
+        {
+            predicate = KTRequireDataNamed(connNode["require-data"]().as_string());
+        }
+
+        if (connNode.has("cut-mask-all") || connNode.has("cut-mask") || connNode.has("cut-mask-int"))
+        {
+            // same precedence as in KTCutFilter
+            KTRequirePassCuts passCuts;
+            if (connNode.has("cut-mask-int"))
+            {
+                passCuts.SetCutMask(connNode["cut-mask-int"]().as_uint());
+            }
+            if (connNode.has("cut-mask"))
+            {
+                passCuts.SetCutMask(connNode["cut-mask"]().as_string());
+            }
+            if (connNode.get_value("cut-mask-all", false))
+            {
+                passCuts.SetCutMaskAll();
+            }
+
+            if (predicate) predicate = KTRequireBoth(predicate, passCuts);
+            else predicate = passCuts;
+        }
+
+        return predicate;
+    }
+
 
     bool KTProcessorToolbox::PushBackToRunQueue(const std::string& name)
     {
@@ -11,13 +11,22 @@
 
 #include "KTConfigurable.hh"
 
+#include "KTDataPredicate.hh"
+
+#include <boost/shared_ptr.hpp>
+
 #include <deque>
 #include <initializer_list>
 #include <limits>
+#include <map>
 #include <set>
+#include <string>
+#include <utility>
 
 namespace Nymph
 {
+    class KTAsyncStage;
+    class KTConnectionStats;
     class KTPrimaryProcessor;
     class KTProcessor;
 
@@ -44,10 +53,29 @@ namespace Nymph
 
      Available (nested) configuration values:
      <ul>
+         <li>profile-connections -- (optional) boolean; if true, the number of calls, the total and maximum time spent, and the number of exceptions thrown
+         are recorded for each connection made by the toolbox, and a table of the results is printed at the end of Run().
+         There is no cost for connections when this is off.</li>
+         <li>account-memory -- (optional) boolean; if true, the number and size of the data objects, their extensions, and cut results that are alive, and the memory they own, are recorded by type,
+         along with the most that were alive at once, and a table of the results is printed at the end of Run() (see KTMemoryAccounting).
+         Accounting is disabled again when the toolbox is destroyed.</li>
+         <li>cut-flow -- (optional) boolean or object; if true, or an object, the number of data objects each cut was applied to, passed, and rejected are recorded
+         (see KTCutFlow), and a table of the results is printed at the end of Run(); it includes the data objects still held by the processors.
+         The cut flow is disabled again when the toolbox is destroyed.  The object can contain:
+             <ul>
+                 <li>order -- (optional) array of cut names, giving the order of the cut flow; other cuts follow in the order in which they were registered.</li>
+                 <li>file -- (optional) string; the cut flow is also written to this file as JSON when it's printed.</li>
+             </ul>
+         </li>
          <li>processors (array of objects) -- create a processor; each object in the array should consist of:
              <ul>
                  <li>type -- string specifying the processor type (matches the string given to the Registrar, which should be specified before the class implementation in each processor's .cc file).</li>
                  <li>name -- string giving the individual processor a name so that multiple processors of the same type can be created.</li>
+                 <li>replicas -- (optional) unsigned integer; if greater than 1, that many instances of the processor are created, each running on its own thread,
+                 and the data sent to the processor are distributed among them; their output is merged back into the order in which the data arrived (see KTReplicatedProcessor).
+                 Only data slots and signals can be connected to a replicated processor.  In single-threaded mode, a single instance is created.</li>
+                 <li>shard-by -- (optional) string; how data are assigned to replicas: "counter" (default) uses KTData::Counter modulo the number of replicas;
+                 "arrival" distributes the data in the order in which they arrive.</li>
              </ul>
          </li>
          <li>connection (array of objects) -- connect a signal to a slot; each object should consist of:
@@ -55,6 +83,24 @@ namespace Nymph
                  <li>signal -- <i>proc-name:signal-name</i>; name (i.e. the name given in the array of processors above) of the processor, and the signal that will be emitted.</li>
                  <li>slot -- <i>proc-name:slot-name</li>; name of the processor with the slot that will receive the signal.</li>
                  <li>group-order -- (optional) integer specifying the order in which slots should be called.
+                 <li>async -- (optional) boolean; if true, calls to the slot are queued and executed on a separate thread, so the emitting processor does not wait for the slot to finish.
+                 All asynchronous connections to a given processor share one queue and one thread, so that processor's slots are still called one at a time, in order.
+                 Queues are drained at the end of each run-queue group, and Run() fails if an asynchronous slot threw an exception.
+                 Regular connections to a processor that has asynchronous connections are queued on its thread as well
+                 (e.g. a "done" signal to a writer), so they can't overtake the calls that were queued before them.
+                 The slot runs while the emitting processor carries on, including calling the other slots connected to the same signal,
+                 so a signal that passes data can't have both asynchronous and regular connections;
+                 and data sent asynchronously must not be modified by the emitting processor.
+                 In single-threaded mode, asynchronous connections are made as regular connections.</li>
+                 <li>queue-depth -- (optional) unsigned integer; maximum number of queued calls for an asynchronous connection (default: 1024);
+                 the emitting processor blocks while the queue is full.
+                 The depth is set by the first asynchronous connection to a given processor.</li>
+                 <li>require-data -- (optional) string; name of a data type (e.g. "test-data"); the slot is only called for data that have that type.</li>
+                 <li>cut-mask-all, cut-mask, cut-mask-int -- (optional) the slot is only called for data that pass the cuts selected by the mask; the options are interpreted as in KTCutFilter.
+                 These and require-data can only be used with slots that take a KTDataPtr, and are checked before the slot is called (and before an asynchronous call is queued).</li>
+                 <li>parallel -- (optional) boolean; if true, the slots connected to this signal with the same order are called concurrently on a shared thread pool,
+                 and the signal returns once they have all finished.  Requires an order.
+                 The slots share the data, so each should only add to it (see KTSignalData).</li>
              </ul>
          </li>
          <li>run-queue -- (array of strings and arrays of strings) define the queue of processors that will control the running of Nymph.
@@ -125,19 +171,99 @@ namespace Nymph
         private:
             ProcessorMap fProcMap;
 
+            typedef std::map< std::string, boost::shared_ptr< KTAsyncStage > > AsyncStageMap;
+            typedef AsyncStageMap::iterator AsyncStageMapIt;
+            typedef AsyncStageMap::value_type AsyncStageMapValue;
+
+            /// Get the asynchronous stage for a processor; it's created with the given queue depth if it does not exist yet
+            boost::shared_ptr< KTAsyncStage > GetAsyncStage(const std::string& procName, unsigned queueDepth);
+            /// Wait until all asynchronous stages are idle
+            void DrainAsyncStages();
+            /// Stop and remove the asynchronous stage for a processor, if it has one
+            void StopAsyncStage(const std::string& procName);
+
+            /// Returns false if the signal passes data, and already has connections of the other kind (asynchronous or regular)
+            bool CheckDataSignal(KTProcessor* signalProc, const std::string& signalProcName, const std::string& signalName, bool isAsync) const;
+            /// Records the kind of a connection that was made to a signal that passes data
+            void AddDataSignal(KTProcessor* signalProc, const std::string& signalProcName, const std::string& signalName, bool isAsync);
+            /// Forgets the connections made to and from a processor
+            void RemoveConnections(const std::string& procName);
+
+            /// Creates a KTReplicatedProcessor with nReplicas instances of the processor type; shardBy is "counter" or "arrival"
+            /// The replicas' stages are added to the asynchronous stages
+            KTProcessor* CreateReplicatedProcessor(const std::string& procType, const std::string& procName, unsigned nReplicas, const std::string& shardBy);
+
+            AsyncStageMap fAsyncStages;
+
+            // signals that pass data, by processor name and signal object (see KTSignalWrapper::GetSignalObject()),
+            // and whether their connections are asynchronous
+            typedef std::map< std::pair< std::string, const void* >, bool > DataSignalMap;
+            DataSignalMap fDataSignals;
+            // processors with slots that have regular connections
+            std::set< std::string > fDirectSlotProcs;
+
 
         public:
             /// Make a connection between the signal from one processor and the slot from another processor
             /// Both processors should already have been added to the Toolbox
+            /// If the slot's processor has asynchronous connections, calls to the slot are queued with theirs
+            /// If a predicate is given, the slot is only called for data that satisfy it (see KTDataPredicate)
             /// Signal and slot strings should be formatted as: [processor name]:[signal/slot name]
-            bool MakeConnection(const std::string& signal, const std::string& slot, int order = std::numeric_limits< int >::min());
+            bool MakeConnection(const std::string& signal, const std::string& slot, int order = std::numeric_limits< int >::min(), const KTDataPredicate& predicate = KTDataPredicate());
 
             /// Make a connection between the signal from one processor and the slot from another processor
             /// Both processors should already have been added to the Toolbox
-            bool MakeConnection(const std::string& signalProcName, const std::string& signalName, const std::string& slotProcName, const std::string& slotName, int order = std::numeric_limits< int >::min());
+            bool MakeConnection(const std::string& signalProcName, const std::string& signalName, const std::string& slotProcName, const std::string& slotName, int order = std::numeric_limits< int >::min(), const KTDataPredicate& predicate = KTDataPredicate());
+
+            /// Make an asynchronous connection between the signal from one processor and the slot from another processor
+            /// Calls to the slot are queued (up to queueDepth calls) and executed on a thread dedicated to the slot's processor
+            /// Fails if the slot's processor already has regular connections, which would otherwise not be queued
+            /// Signal and slot strings should be formatted as: [processor name]:[signal/slot name]
+            bool MakeAsyncConnection(const std::string& signal, const std::string& slot, unsigned queueDepth, int order = std::numeric_limits< int >::min(), const KTDataPredicate& predicate = KTDataPredicate());
+
+            /// Make an asynchronous connection between the signal from one processor and the slot from another processor
+            /// Calls to the slot are queued (up to queueDepth calls) and executed on a thread dedicated to the slot's processor
+            bool MakeAsyncConnection(const std::string& signalProcName, const std::string& signalName, const std::string& slotProcName, const std::string& slotName, unsigned queueDepth, int order = std::numeric_limits< int >::min(), const KTDataPredicate& predicate = KTDataPredicate());
+
+            /// Make the slots connected to a signal with the given order run concurrently (or, if isParallel is false, sequentially again)
+            /// The signal string should be formatted as: [processor name]:[signal name]
+            bool SetParallelGroup(const std::string& signal, int order, bool isParallel = true);
+
+            /// If true, connections made after this is set are profiled (see KTConnectionStats)
+            bool GetProfileConnections() const;
+            void SetProfileConnections(bool flag);
+
+            /// Get the profiling results for a connection; the connection string should be formatted as: [processor name]:[signal name] -> [processor name]:[slot name]
+            /// Returns NULL if the connection was not profiled
+            const KTConnectionStats* GetConnectionStats(const std::string& connection) const;
+
+            /// Print a table of the profiling results for all profiled connections, ordered by the total time spent in each slot
+            void PrintConnectionStats() const;
+
+        private:
+            /// Creates the record for a connection, or returns the existing one; returns an empty pointer if profiling is off
+            boost::shared_ptr< KTConnectionStats > MakeConnectionStats(const std::string& signalProcName, const std::string& signalName, const std::string& slotProcName, const std::string& slotName);
+
+            typedef std::map< std::string, boost::shared_ptr< KTConnectionStats > > ConnectionStatsMap;
+            typedef ConnectionStatsMap::const_iterator ConnStatsMapCIt;
+            typedef ConnectionStatsMap::value_type ConnStatsMapValue;
+
+            bool fProfileConnections;
+            ConnectionStatsMap fConnectionStats;
+
+            /// Prints the cut flow, and writes it to fCutFlowFilename if that's set
+            void ReportCutFlow() const;
+
+            std::string fCutFlowFilename;
+
+            // true if the memory accounting and the cut flow (which are global) were enabled by this toolbox, which disables them again when it's destroyed
+            bool fEnabledMemoryAccounting;
+            bool fEnabledCutFlow;
 
         private:
             bool ParseSignalSlotName(const std::string& toParse, std::string& nameOfProc, std::string& nameOfSigSlot) const;
+            /// Builds the predicate for a connection from its configuration; the predicate is empty if no conditions were given
+            KTDataPredicate ParseConnectionPredicate(const scarab::param_node& connNode) const;
             static const char fSigSlotNameSep = ':';
 
 
@@ -180,6 +306,17 @@ namespace Nymph
 
     };
 
+    inline bool KTProcessorToolbox::GetProfileConnections() const
+    {
+        return fProfileConnections;
+    }
+
+    inline void KTProcessorToolbox::SetProfileConnections(bool flag)
+    {
+        fProfileConnections = flag;
+        return;
+    }
+
     inline void KTProcessorToolbox::PopBackOfRunQueue()
     {
         fRunQueue.pop_back();
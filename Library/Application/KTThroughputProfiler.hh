@@ -86,9 +86,9 @@ namespace Nymph
             void Start();
             void Stop();
 
-            void StartProfiling(KTDataPtr data);
+            void StartProfiling(const KTDataPtr& data);
 
-            void Data(KTDataPtr data);
+            void Data(const KTDataPtr& data);
 
             void Finish();
 
@@ -82,7 +82,7 @@ namespace Nymph
     }
 
 
-    void KTApplyCut::ApplyCut(KTDataPtr dataPtr)
+    void KTApplyCut::ApplyCut(const KTDataPtr& dataPtr)
     {
         if (fCut == NULL)
         {
@@ -0,0 +1,254 @@
+/*
+ * KTApplyCuts.cc
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: nsoblath
+ */
+
+#include "KTApplyCuts.hh"
+
+#include "KTCut.hh"
+#include "KTTime.hh"
+
+#include <algorithm>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+
+using std::string;
+using std::vector;
+
+
+namespace Nymph
+{
+    KTLOGGER(cutlog, "KTApplyCuts");
+
+    KT_REGISTER_PROCESSOR(KTApplyCuts, "apply-cuts");
+
+    KTApplyCuts::KTApplyCuts(const std::string& name) :
+            KTProcessor(name),
+            fShortCircuit(false),
+            fReorderInterval(0),
+            fCuts(),
+            fOrder(),
+            fNData(0),
+            fNFailed(0),
+            fAfterCutSignal("all", this),
+            fAfterCutPassSignal("pass", this),
+            fAfterCutFailSignal("fail", this)
+    {
+        RegisterSlot("apply", this, &KTApplyCuts::ApplyCuts);
+    }
+
+    KTApplyCuts::~KTApplyCuts()
+    {
+        if (fNData != 0) PrintCutStats();
+        ClearCuts();
+    }
+
+    bool KTApplyCuts::Configure(const scarab::param_node& node)
+    {
+        // Config-file settings
+        SetShortCircuit(node.get_value("short-circuit", fShortCircuit));
+        SetReorderInterval(node.get_value("reorder-interval", fReorderInterval));
+
+        if (node.has("cuts"))
+        {
+            const scarab::param_array& cutArray = node["cuts"].as_array();
+            for (scarab::param_array::const_iterator cutIt = cutArray.begin(); cutIt != cutArray.end(); ++cutIt)
+            {
+                if (cutIt->is_value())
+                {
+                    if (! AddCut((*cutIt)().as_string())) return false;
+                    continue;
+                }
+
+                if (! cutIt->is_node() || ! cutIt->as_node().has("cut"))
+                {
+                    KTERROR(cutlog, "Each element of \"cuts\" must be a cut name, or a node with a \"cut\" entry");
+                    return false;
+                }
+                const scarab::param_node& cutNode = cutIt->as_node();
+                if (! AddCut(cutNode["cut"]().as_string())) return false;
+                if (! fCuts.back().fCut->Configure(cutNode))
+                {
+                    KTERROR(cutlog, "Unable to configure cut <" << fCuts.back().fStats.fName << ">");
+                    return false;
+                }
+            }
+        }
+
+        if (fCuts.empty())
+        {
+            KTERROR(cutlog, "No cuts were selected");
+            return false;
+        }
+        return true;
+    }
+
+    void KTApplyCuts::AddCut(KTCut* cut, const std::string& cutName)
+    {
+        CutInfo info;
+        info.fCut = cut;
+        info.fStats.fName = cutName;
+        info.fStats.fNApplied = 0;
+        info.fStats.fNFailed = 0;
+        info.fStats.fTotalTime = 0;
+        fOrder.push_back(fCuts.size());
+        fCuts.push_back(info);
+        return;
+    }
+
+    bool KTApplyCuts::AddCut(const string& cutName)
+    {
+        KTCut* tempCut = scarab::factory< KTCut, const std::string& >::get_instance()->create(cutName, cutName);
+        if (tempCut == NULL)
+        {
+            KTERROR(cutlog, "Invalid cut name given: <" << cutName << ">.");
+            return false;
+        }
+        AddCut(tempCut, cutName);
+        return true;
+    }
+
+    void KTApplyCuts::ClearCuts()
+    {
+        for (vector< CutInfo >::iterator it = fCuts.begin(); it != fCuts.end(); ++it)
+        {
+            delete it->fCut;
+        }
+        fCuts.clear();
+        fOrder.clear();
+        return;
+    }
+
+    vector< KTApplyCuts::CutStats > KTApplyCuts::GetCutStats() const
+    {
+        vector< CutStats > stats;
+        stats.reserve(fCuts.size());
+        for (vector< CutInfo >::const_iterator it = fCuts.begin(); it != fCuts.end(); ++it)
+        {
+            stats.push_back(it->fStats);
+        }
+        return stats;
+    }
+
+    vector< string > KTApplyCuts::GetOrder() const
+    {
+        vector< string > names;
+        names.reserve(fOrder.size());
+        for (vector< unsigned >::const_iterator it = fOrder.begin(); it != fOrder.end(); ++it)
+        {
+            names.push_back(fCuts[*it].fStats.fName);
+        }
+        return names;
+    }
+
+
+    KTApplyCuts::MoreRejectionPerTime::MoreRejectionPerTime(const vector< CutInfo >& cuts) :
+            fCuts(cuts)
+    {}
+
+    double KTApplyCuts::MoreRejectionPerTime::Score(unsigned iCut) const
+    {
+        const CutStats& stats = fCuts[iCut].fStats;
+        if (stats.fNApplied == 0) return std::numeric_limits< double >::infinity();
+        // (fraction of data cut) / (mean time per application); the 1 ns keeps free cuts finite
+        return (double)stats.fNFailed / ((double)stats.fTotalTime + 1.);
+    }
+
+    bool KTApplyCuts::MoreRejectionPerTime::operator()(unsigned lhs, unsigned rhs) const
+    {
+        return Score(lhs) > Score(rhs);
+    }
+
+    void KTApplyCuts::Reorder()
+    {
+        // stable, so that cuts that score the same keep their order
+        std::stable_sort(fOrder.begin(), fOrder.end(), MoreRejectionPerTime(fCuts));
+        KTDEBUG(cutlog, "Cuts reordered; the first is now <" << fCuts[fOrder.front()].fStats.fName << ">");
+        return;
+    }
+
+    void KTApplyCuts::PrintCutStats() const
+    {
+        size_t nameWidth = 10;
+        for (vector< CutInfo >::const_iterator it = fCuts.begin(); it != fCuts.end(); ++it)
+        {
+            nameWidth = std::max(nameWidth, it->fStats.fName.size());
+        }
+
+        std::stringstream table;
+        table << std::left << std::setw(nameWidth) << "Cut" << std::right
+                << std::setw(12) << "Applied" << std::setw(12) << "Failed"
+                << std::setw(14) << "Rejected (%)" << std::setw(14) << "Total (s)" << std::setw(14) << "Mean (us)" << '\n';
+        table << std::fixed;
+        for (vector< unsigned >::const_iterator it = fOrder.begin(); it != fOrder.end(); ++it)
+        {
+            const CutStats& stats = fCuts[*it].fStats;
+            double rejected = stats.fNApplied == 0 ? 0. : 100. * (double)stats.fNFailed / (double)stats.fNApplied;
+            double mean = stats.fNApplied == 0 ? 0. : (double)stats.fTotalTime / (double)stats.fNApplied;
+            table << std::left << std::setw(nameWidth) << stats.fName << std::right
+                    << std::setw(12) << stats.fNApplied << std::setw(12) << stats.fNFailed
+                    << std::setw(14) << std::setprecision(2) << rejected
+                    << std::setw(14) << std::setprecision(6) << (double)stats.fTotalTime * 1.e-9
+                    << std::setw(14) << std::setprecision(3) << mean * 1.e-3 << '\n';
+        }
+        KTPROG(cutlog, "Cuts applied by <" << GetConfigName() << ">: " << fNData << " data object(s), " << fNFailed << " failed\n" << table.str());
+        return;
+    }
+
+
+    bool KTApplyCuts::Apply(const KTDataPtr& dataPtr)
+    {
+        bool anyFailed = false;
+        struct timespec start, end;
+        for (vector< unsigned >::const_iterator it = fOrder.begin(); it != fOrder.end(); ++it)
+        {
+            CutInfo& info = fCuts[*it];
+
+            GetTimeMonotonic(&start);
+            bool cutFailed = info.fCut->Apply(dataPtr);
+            GetTimeMonotonic(&end);
+
+            info.fStats.fTotalTime += TimeToNSec(end) - TimeToNSec(start);
+            ++info.fStats.fNApplied;
+            if (cutFailed)
+            {
+                ++info.fStats.fNFailed;
+                anyFailed = true;
+                if (fShortCircuit) break;
+            }
+        }
+
+        ++fNData;
+        if (anyFailed) ++fNFailed;
+
+        if (fShortCircuit && fReorderInterval != 0 && fNData % fReorderInterval == 0)
+        {
+            Reorder();
+        }
+        return anyFailed;
+    }
+
+    void KTApplyCuts::ApplyCuts(const KTDataPtr& dataPtr)
+    {
+        if (fCuts.empty())
+        {
+            KTERROR(cutlog, "No cuts were specified");
+            return;
+        }
+
+        if (Apply(dataPtr))
+        {
+            fAfterCutFailSignal(dataPtr);
+        }
+        else
+        {
+            fAfterCutPassSignal(dataPtr);
+        }
+        fAfterCutSignal(dataPtr);
+        return;
+    }
+
+} /* namespace Nymph */
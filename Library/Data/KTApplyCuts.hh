@@ -0,0 +1,160 @@
+/**
+ @file KTApplyCuts.hh
+ @brief Contains KTApplyCuts
+ @details Applies a list of cuts to data
+ @author: N. S. Oblath
+ @date: Oct 18, 2026
+ */
+
+#ifndef KTAPPLYCUTS_HH_
+#define KTAPPLYCUTS_HH_
+
+#include "KTProcessor.hh"
+
+#include "KTLogger.hh"
+#include "KTMemberVariable.hh"
+#include "KTSlot.hh"
+
+#include <inttypes.h>
+#include <string>
+#include <vector>
+
+namespace Nymph
+{
+    class KTCut;
+
+    /*!
+     @class KTApplyCuts
+     @author N. S. Oblath
+
+     @brief Applies a list of cuts to data.
+
+     @details
+     KTApplyCuts applies any number of cuts to data in a single slot call, so that a selection made of many cuts
+     doesn't need an instance of KTApplyCut (and a signal) for each of them.  The types of cut and their parameters are specified at runtime
+     from the set of cuts registered.  The data fails if any of the cuts fail.
+
+     In short-circuit mode, the cuts stop being applied to a data object as soon as one of them fails, so the cuts after it don't add their results to the data.
+     The order in which the cuts are applied can then be adapted to the data: every "reorder-interval" data objects,
+     the cuts are sorted by the fraction of the data they cut divided by the time they take, so that cheap cuts that reject a lot of data are applied first.
+     Cuts that haven't been applied yet go first, so that they're measured.  Without short-circuiting all of the cuts are always applied, and they're never reordered.
+
+     The number of data objects each cut was applied to, the number it cut, and the time it took are recorded,
+     and printed when the processor is destroyed (i.e. at the end of the run).
+
+     Interpretation of boolean returned by KTCut::Apply
+     - TRUE means the cut was failed
+     - FALSE means the cut was passed
+
+     Configuration name: "apply-cuts"
+
+     Available configuration values:
+     - "cuts": array -- the cuts to apply, in order; each element is either the name of a cut (using its default configuration),
+                        or a node with "cut": the name of the cut, and the rest of the cut's configuration
+     - "short-circuit": bool -- if true, stop applying cuts to a data object once one fails (default: false)
+     - "reorder-interval": unsigned int -- in short-circuit mode, the number of data objects between reorderings of the cuts; 0 (the default) disables reordering
+
+     Slots:
+     - "apply": void (KTDataPtr) -- Applies the cuts to the received data; Requirements are set by the cuts; No data is added.
+
+     Signals:
+     - "all": void (KTDataPtr) -- Emitted upon application of the cuts regardless of the result.
+     - "pass": void (KTDataPtr) -- Emitted upon application of the cuts if all of the cuts passed.
+     - "fail": void (KTDataPtr) -- Emitted upon application of the cuts if any of the cuts failed.
+    */
+
+    class KTApplyCuts : public KTProcessor
+    {
+        public:
+            struct CutStats
+            {
+                std::string fName;
+                uint64_t fNApplied;
+                uint64_t fNFailed;
+                /// Total time spent in the cut (ns)
+                uint64_t fTotalTime;
+            };
+
+        public:
+            KTApplyCuts(const std::string& name = "apply-cuts");
+            virtual ~KTApplyCuts();
+
+            bool Configure(const scarab::param_node& node);
+
+            /// Adds a cut to the end of the list; KTApplyCuts takes ownership of the cut
+            void AddCut(KTCut* cut, const std::string& cutName);
+            /// Creates the named cut and adds it to the end of the list
+            bool AddCut(const std::string& cutName);
+            /// Removes all of the cuts
+            void ClearCuts();
+
+            unsigned GetNCuts() const;
+
+            MEMBERVARIABLE(bool, ShortCircuit);
+            MEMBERVARIABLE(unsigned, ReorderInterval);
+
+            /// Statistics for each cut, in the order in which the cuts were added
+            std::vector< CutStats > GetCutStats() const;
+            /// Names of the cuts in the order in which they're currently applied
+            std::vector< std::string > GetOrder() const;
+
+            /// Sorts the cuts by the fraction of the data they cut per unit time
+            void Reorder();
+
+            /// Prints a table of the statistics for each cut
+            void PrintCutStats() const;
+
+        private:
+            struct CutInfo
+            {
+                KTCut* fCut;
+                CutStats fStats;
+            };
+
+            /// Ranks the cuts for Reorder(); cuts that haven't been applied are ranked first
+            struct MoreRejectionPerTime
+            {
+                MoreRejectionPerTime(const std::vector< CutInfo >& cuts);
+                bool operator()(unsigned lhs, unsigned rhs) const;
+                double Score(unsigned iCut) const;
+                const std::vector< CutInfo >& fCuts;
+            };
+
+            std::vector< CutInfo > fCuts;
+            // indices of fCuts in the order in which they're applied
+            std::vector< unsigned > fOrder;
+            uint64_t fNData;
+            uint64_t fNFailed;
+
+        public:
+            /// Applies the cuts to the data; returns true if the data failed any of them
+            bool Apply(const KTDataPtr& dataPtr);
+
+            void ApplyCuts(const KTDataPtr&);
+
+
+            //***************
+            // Signals
+            //***************
+
+        private:
+            KTSignalData fAfterCutSignal;
+            KTSignalData fAfterCutPassSignal;
+            KTSignalData fAfterCutFailSignal;
+
+            //***************
+            // Slots
+            //***************
+
+        private:
+
+    };
+
+
+    inline unsigned KTApplyCuts::GetNCuts() const
+    {
+        return fCuts.size();
+    }
+
+} /* namespace Nymph */
+#endif /* KTAPPLYCUTS_HH_ */
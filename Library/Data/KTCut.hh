@@ -18,6 +18,9 @@
 #include "factory.hh"
 #include "typename.hh"
 
+#include <string>
+#include <tuple>
+
 namespace Nymph
 {
     KTLOGGER(cutlog_h, "KTCut.h");
@@ -31,11 +34,11 @@ namespace Nymph
      @details
      A fully implemented cut MUST have the following:
      - Public nested class called Result, inheriting from KTExtensibleCutResult< Result >, and containing a public static std::string name sName.
-     - Cut registration using the macro KT_REGISTER_CUT([class name])
+     - Cut registration using the macro KT_REGISTER_CUT([class name]), which also gives the cut its bit in the cut summary (see KTCutRegistry)
      - Implementation of bool Configure(const scarab::param_node&)
      - Implementation of bool Apply(KTData&, <DataType(s)>)
 
-     Your cut class should inherit from KTCutOneArg or KTCutTwoArgs, depending on the number of data types involved in your cut.
+     Your cut class should inherit from KTCutOnData< [data type(s)] >, or equivalently KTCutOneArg or KTCutTwoArgs for one or two data types.
 
      The existence of [class name]::Result and [class name]::Result::sName are enforces at compile time by the KT_REGISTER_CUT macro.
 
@@ -115,7 +118,59 @@ namespace Nymph
             KTCut(const std::string& name = "default-cut-name");
             virtual ~KTCut();
 
-            virtual bool Apply(KTDataPtr) = 0;
+            virtual bool Apply(const KTDataPtr&) = 0;
+    };
+
+
+    //*************************************************************************
+    // KTCutOnData -- base class for cuts operating on any number of data types
+    //*************************************************************************
+
+    /// Compile-time list of indices, used to expand the data types of KTCutOnData
+    template< unsigned... XIndices >
+    struct KTCutIndices
+    {};
+
+    template< unsigned XN, unsigned... XIndices >
+    struct KTMakeCutIndices : KTMakeCutIndices< XN - 1, XN - 1, XIndices... >
+    {};
+
+    template< unsigned... XIndices >
+    struct KTMakeCutIndices< 0, XIndices... >
+    {
+        typedef KTCutIndices< XIndices... > type;
+    };
+
+    /*!
+     @class KTCutOnData
+     @author N. S. Oblath
+
+     @brief Base class for cuts operating on any number of data types.
+
+     @details
+     Apply(const KTDataPtr&) looks up each of the data types once in the data's extension chain (a constant-time lookup in the chain's index),
+     and calls Apply(KTData&, XDataTypes&...) with all of them if they're all present.  The lookups and the checks are expanded at compile time,
+     so there's no loop or recursion at run time, and a cut on several data types costs one lookup per type.
+     If a data type is missing, an error is printed for it and the cut is passed, without calling Apply(KTData&, XDataTypes&...).
+
+     The data types are looked up with Get(), so a data type with a generator (see KT_REGISTER_GENERATOR) is made on demand if it's missing.
+    */
+    template< class... XDataTypes >
+    class KTCutOnData : public KTCut
+    {
+        static_assert(sizeof...(XDataTypes) > 0, "KTCutOnData requires at least one data type");
+
+        public:
+            KTCutOnData(const std::string& name = "default-cut-name");
+            virtual ~KTCutOnData();
+
+            virtual bool Apply(KTData& data, XDataTypes&... dataTypes) = 0;
+
+            virtual bool Apply(const KTDataPtr& dataPtr);
+
+        private:
+            template< unsigned... XIndices >
+            bool ApplyToObjects(KTData& data, const std::tuple< XDataTypes*... >& objects, KTCutIndices< XIndices... >);
     };
 
 
@@ -124,15 +179,11 @@ namespace Nymph
     //*****************************************************************
 
     template< class XDataType >
-    class KTCutOneArg : public KTCut
+    class KTCutOneArg : public KTCutOnData< XDataType >
     {
         public:
             KTCutOneArg(const std::string& name = "default-cut-name");
             virtual ~KTCutOneArg();
-
-            virtual bool Apply(KTData& data, XDataType& dataType) = 0;
-
-            virtual bool Apply(KTDataPtr dataPtr);
     };
 
 
@@ -141,15 +192,11 @@ namespace Nymph
     //*******************************************************************
 
     template< class XDataType1, class XDataType2 >
-    class KTCutTwoArgs : public KTCut
+    class KTCutTwoArgs : public KTCutOnData< XDataType1, XDataType2 >
     {
         public:
             KTCutTwoArgs(const std::string& name = "default-cut-name");
             virtual ~KTCutTwoArgs();
-
-            virtual bool Apply(KTData& data, XDataType1& dataType1, XDataType2& dataType2) = 0;
-
-            virtual bool Apply(KTDataPtr dataPtr);
     };
 
 
@@ -157,90 +204,73 @@ namespace Nymph
     // Implementations
     //*******************
 
-    template< class XDataType >
-    KTCutOneArg< XDataType >::KTCutOneArg(const std::string& name) :
+    template< class... XDataTypes >
+    KTCutOnData< XDataTypes... >::KTCutOnData(const std::string& name) :
             KTCut(name)
     {
     }
 
-    template< class XDataType >
-    KTCutOneArg< XDataType >::~KTCutOneArg()
+    template< class... XDataTypes >
+    KTCutOnData< XDataTypes... >::~KTCutOnData()
     {}
 
-    template< class XDataType >
-    bool KTCutOneArg< XDataType >::Apply(KTDataPtr dataPtr)
+    template< class... XDataTypes >
+    bool KTCutOnData< XDataTypes... >::Apply(const KTDataPtr& dataPtr)
     {
-        if (! dataPtr->Has< XDataType >())
-        {
-            KTERROR(cutlog_h, "Data type <" << scarab::type(XDataType()) << "> was not present");
-            return false;
-        }
-        return Apply(dataPtr->Of< KTData >(), dataPtr->Of< XDataType >());
+        std::tuple< XDataTypes*... > objects(dataPtr->Get< XDataTypes >()...);
+        return ApplyToObjects(*dataPtr, objects, typename KTMakeCutIndices< sizeof...(XDataTypes) >::type());
     }
 
-
-    template< class XDataType1, class XDataType2 >
-    KTCutTwoArgs< XDataType1, XDataType2 >::KTCutTwoArgs(const std::string& name) :
-            KTCut(name)
-    {
-    }
-
-    template< class XDataType1, class XDataType2 >
-    KTCutTwoArgs< XDataType1, XDataType2 >::~KTCutTwoArgs()
-    {}
-
-    template< class XDataType1, class XDataType2 >
-    bool KTCutTwoArgs< XDataType1, XDataType2 >::Apply(KTDataPtr dataPtr)
+    template< class... XDataTypes >
+    template< unsigned... XIndices >
+    bool KTCutOnData< XDataTypes... >::ApplyToObjects(KTData& data, const std::tuple< XDataTypes*... >& objects, KTCutIndices< XIndices... >)
     {
-        if (! dataPtr->Has< XDataType1 >())
+        const bool present[] = { (std::get< XIndices >(objects) != 0)... };
+        bool allPresent = true;
+        for (unsigned iType = 0; iType < sizeof...(XDataTypes); ++iType)
         {
-            KTERROR(cutlog_h, "Data type <" << scarab::type(XDataType1()) << "> was not present");
-            return false;
+            allPresent = allPresent && present[iType];
         }
-        if (! dataPtr->Has< XDataType2 >())
+        if (! allPresent)
         {
-            KTERROR(cutlog_h, "Data type <" << scarab::type(XDataType2()) << "> was not present");
+            const std::string names[] = { scarab::type(XDataTypes())... };
+            for (unsigned iType = 0; iType < sizeof...(XDataTypes); ++iType)
+            {
+                if (! present[iType]) KTERROR(cutlog_h, "Data type <" << names[iType] << "> was not present");
+            }
             return false;
         }
-        return Apply(dataPtr->Of< KTData >(), dataPtr->Of< XDataType1 >(), dataPtr->Of< XDataType2 >());
+        return Apply(data, *std::get< XIndices >(objects)...);
     }
 
-/* Playing around: wouldn't it be cool if this could be done with variadic tmeplates?
- * Unfortunately we'll need to be able to iterate over the types in the template pack in the Apply(KTDataPtr) function.
- *
-    template< class ... DataTypes >
-    class KTCutOnData : public KTCut
-    {
-        public:
-            KTCutOnData(const std::string& name = "default-cut-name");
-            virtual ~KTCutOnData();
-
-            virtual bool Apply(DataTypes ...) = 0;
-
-            virtual bool Apply(KTDataPtr dataPtr);
-    };
 
-    template< class ... DataTypes >
-    KTCutOnData< DataTypes... >::KTCutOnData(const std::string& name) :
-            KTCut(name)
+    template< class XDataType >
+    KTCutOneArg< XDataType >::KTCutOneArg(const std::string& name) :
+            KTCutOnData< XDataType >(name)
     {
     }
 
-    template< class ... DataTypes >
-    KTCutOnData< DataTypes... >::~KTCutOnData()
+    template< class XDataType >
+    KTCutOneArg< XDataType >::~KTCutOneArg()
     {}
 
-    template< class ... DataTypes >
-    bool KTCutOnData< DataTypes... >::Apply(KTDataPtr dataPtr)
-    {
 
+    template< class XDataType1, class XDataType2 >
+    KTCutTwoArgs< XDataType1, XDataType2 >::KTCutTwoArgs(const std::string& name) :
+            KTCutOnData< XDataType1, XDataType2 >(name)
+    {
     }
-*/
+
+    template< class XDataType1, class XDataType2 >
+    KTCutTwoArgs< XDataType1, XDataType2 >::~KTCutTwoArgs()
+    {}
 
     // this macro enforces the existence of cut_class::Result and cut_class::Result::sName at compile time
+    // it also assigns the cut its bit in the cut summary (see KTCutRegistry)
 #define KT_REGISTER_CUT(cut_class) \
         static ::scarab::registrar< ::Nymph::KTCut, cut_class, const std::string& > sCut##cut_class##Registrar( cut_class::Result::sName ); \
-        static ::Nymph::KTExtensibleStructRegistrar< ::Nymph::KTCutResultCore, cut_class::Result > sCut##cut_class##ResultRegistrar( cut_class::Result::sName );
+        static ::Nymph::KTExtensibleStructRegistrar< ::Nymph::KTCutResultCore, cut_class::Result > sCut##cut_class##ResultRegistrar( cut_class::Result::sName ); \
+        static ::Nymph::KTCutRegistrar< cut_class::Result > sCut##cut_class##BitRegistrar;
 
 } /* namespace Nymph */
 
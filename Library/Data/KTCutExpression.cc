@@ -0,0 +1,396 @@
+/*
+ * KTCutExpression.cc
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: nsoblath
+ */
+
+#include "KTCutExpression.hh"
+
+#include "KTCutRegistry.hh"
+#include "KTLogger.hh"
+
+#include <cctype>
+#include <memory>
+
+namespace Nymph
+{
+    KTLOGGER(cutlog, "KTCutExpression");
+
+    // Parsed form of an expression; &&'s and ||'s are gathered into nodes with any number of children
+    struct KTCutExpression::Node
+    {
+        enum Type
+        {
+            kName,
+            kNot,
+            kAnd,
+            kOr
+        };
+
+        Node(Type type, unsigned bit = KTCutRegistry::sNoBit) :
+                fType(type),
+                fBit(bit),
+                fChildren()
+        {}
+
+        /// Adds a child; a child of the same type (other than a not) is merged into this node
+        void Add(std::unique_ptr< Node > child)
+        {
+            if (child->fType == fType && fType != kNot)
+            {
+                for (std::vector< std::unique_ptr< Node > >::iterator it = child->fChildren.begin(); it != child->fChildren.end(); ++it)
+                {
+                    fChildren.push_back(std::move(*it));
+                }
+                return;
+            }
+            fChildren.push_back(std::move(child));
+            return;
+        }
+
+        /// True for a name, or an || of names
+        bool IsAnyOfNames() const
+        {
+            if (fType == kName) return true;
+            if (fType != kOr) return false;
+            for (std::vector< std::unique_ptr< Node > >::const_iterator it = fChildren.begin(); it != fChildren.end(); ++it)
+            {
+                if ((*it)->fType != kName) return false;
+            }
+            return true;
+        }
+
+        /// Mask of the names in a node for which IsAnyOfNames() is true
+        bitset_type NameMask() const
+        {
+            bitset_type mask;
+            if (fType == kName)
+            {
+                mask.set(fBit);
+                return mask;
+            }
+            for (std::vector< std::unique_ptr< Node > >::const_iterator it = fChildren.begin(); it != fChildren.end(); ++it)
+            {
+                mask.set((*it)->fBit);
+            }
+            return mask;
+        }
+
+        Type fType;
+        unsigned fBit;
+        std::vector< std::unique_ptr< Node > > fChildren;
+    };
+
+    // Recursive-descent parser:
+    //   or    := and { "||" and }
+    //   and   := unary { "&&" unary }
+    //   unary := "!" unary | "(" or ")" | name
+    class KTCutExpression::Parser
+    {
+        public:
+            Parser(const std::string& text) :
+                    fText(text),
+                    fPos(0)
+            {}
+
+            std::unique_ptr< Node > Parse()
+            {
+                std::unique_ptr< Node > node = ParseOr();
+                if (! node) return node;
+                SkipSpace();
+                if (fPos != fText.size())
+                {
+                    Error("unexpected <" + fText.substr(fPos, 1) + ">");
+                    return std::unique_ptr< Node >();
+                }
+                return node;
+            }
+
+        private:
+            std::unique_ptr< Node > ParseOr()
+            {
+                std::unique_ptr< Node > first = ParseAnd();
+                if (! first || ! Accept("||")) return first;
+
+                std::unique_ptr< Node > node(new Node(Node::kOr));
+                node->Add(std::move(first));
+                do
+                {
+                    std::unique_ptr< Node > next = ParseAnd();
+                    if (! next) return next;
+                    node->Add(std::move(next));
+                } while (Accept("||"));
+                return node;
+            }
+
+            std::unique_ptr< Node > ParseAnd()
+            {
+                std::unique_ptr< Node > first = ParseUnary();
+                if (! first || ! Accept("&&")) return first;
+
+                std::unique_ptr< Node > node(new Node(Node::kAnd));
+                node->Add(std::move(first));
+                do
+                {
+                    std::unique_ptr< Node > next = ParseUnary();
+                    if (! next) return next;
+                    node->Add(std::move(next));
+                } while (Accept("&&"));
+                return node;
+            }
+
+            std::unique_ptr< Node > ParseUnary()
+            {
+                if (Accept("!"))
+                {
+                    std::unique_ptr< Node > child = ParseUnary();
+                    if (! child) return child;
+                    std::unique_ptr< Node > node(new Node(Node::kNot));
+                    node->Add(std::move(child));
+                    return node;
+                }
+                if (Accept("("))
+                {
+                    std::unique_ptr< Node > node = ParseOr();
+                    if (! node) return node;
+                    if (! Accept(")"))
+                    {
+                        Error("expected <)>");
+                        return std::unique_ptr< Node >();
+                    }
+                    return node;
+                }
+                return ParseName();
+            }
+
+            std::unique_ptr< Node > ParseName()
+            {
+                SkipSpace();
+                std::size_t start = fPos;
+                while (fPos < fText.size() && IsNameChar(fText[fPos])) ++fPos;
+                if (fPos == start)
+                {
+                    Error(fPos == fText.size() ? "expected a cut name at the end" : "expected a cut name before <" + fText.substr(fPos, 1) + ">");
+                    return std::unique_ptr< Node >();
+                }
+
+                std::string name = fText.substr(start, fPos - start);
+                unsigned bit = KTCutRegistry::get_instance()->GetBit(name);
+                if (bit == KTCutRegistry::sNoBit)
+                {
+                    fPos = start;
+                    Error("cut <" + name + "> is not registered");
+                    return std::unique_ptr< Node >();
+                }
+                return std::unique_ptr< Node >(new Node(Node::kName, bit));
+            }
+
+            bool Accept(const char* token)
+            {
+                SkipSpace();
+                std::string tokenStr(token);
+                if (fText.compare(fPos, tokenStr.size(), tokenStr) != 0) return false;
+                fPos += tokenStr.size();
+                return true;
+            }
+
+            void SkipSpace()
+            {
+                while (fPos < fText.size() && std::isspace(static_cast< unsigned char >(fText[fPos]))) ++fPos;
+                return;
+            }
+
+            static bool IsNameChar(char aChar)
+            {
+                return ! std::isspace(static_cast< unsigned char >(aChar)) && aChar != '(' && aChar != ')' && aChar != '!' && aChar != '&' && aChar != '|';
+            }
+
+            void Error(const std::string& message) const
+            {
+                KTERROR(cutlog, "Invalid cut expression <" << fText << ">: " << message << " (at character " << fPos << ")");
+                return;
+            }
+
+            const std::string& fText;
+            std::size_t fPos;
+    };
+
+
+    const unsigned KTCutExpression::sMaxDepth;
+
+    KTCutExpression::KTCutExpression() :
+            fExpression(),
+            fProgram()
+    {
+    }
+
+    KTCutExpression::~KTCutExpression()
+    {
+    }
+
+    bool KTCutExpression::Compile(const std::string& expression)
+    {
+        Clear();
+
+        std::unique_ptr< Node > root = Parser(expression).Parse();
+        if (! root) return false;
+
+        Emit(*root);
+
+        // each instruction that tests a mask pushes a value; each and/or pops two and pushes one
+        unsigned depth = 0;
+        for (std::vector< Instruction >::const_iterator it = fProgram.begin(); it != fProgram.end(); ++it)
+        {
+            if (it->fOp == kAny || it->fOp == kAll || it->fOp == kNone)
+            {
+                if (++depth > sMaxDepth)
+                {
+                    KTERROR(cutlog, "Cut expression <" << expression << "> is nested too deeply");
+                    Clear();
+                    return false;
+                }
+            }
+            else if (it->fOp == kAnd || it->fOp == kOr)
+            {
+                --depth;
+            }
+        }
+
+        fExpression = expression;
+        KTDEBUG(cutlog, "Compiled cut expression <" << fExpression << "> to " << fProgram.size() << " instruction(s)");
+        return true;
+    }
+
+    bool KTCutExpression::Evaluate(const bitset_type& summary) const
+    {
+        // the stack of intermediate results is kept in the bits of a word, with the top of the stack in the lowest bit
+        unsigned long long stack = 0;
+        for (std::vector< Instruction >::const_iterator it = fProgram.begin(); it != fProgram.end(); ++it)
+        {
+            switch (it->fOp)
+            {
+                case kAny:
+                    stack = (stack << 1) | (summary & it->fMask).any();
+                    break;
+                case kAll:
+                    stack = (stack << 1) | ((summary & it->fMask) == it->fMask);
+                    break;
+                case kNone:
+                    stack = (stack << 1) | (summary & it->fMask).none();
+                    break;
+                case kNot:
+                    stack ^= 1ull;
+                    break;
+                case kAnd:
+                    stack = (stack >> 1) & (stack | ~1ull);
+                    break;
+                case kOr:
+                    stack = (stack >> 1) | (stack & 1ull);
+                    break;
+            }
+        }
+        return (stack & 1ull) != 0;
+    }
+
+    void KTCutExpression::Clear()
+    {
+        fExpression.clear();
+        fProgram.clear();
+        return;
+    }
+
+    void KTCutExpression::Emit(const Node& node)
+    {
+        switch (node.fType)
+        {
+            case Node::kName:
+                Emit(kAny, node.NameMask());
+                return;
+
+            case Node::kNot:
+            {
+                const Node& child = *node.fChildren.front();
+                if (child.IsAnyOfNames())
+                {
+                    Emit(kNone, child.NameMask());
+                }
+                else if (child.fType == Node::kNot)
+                {
+                    Emit(*child.fChildren.front());
+                }
+                else
+                {
+                    Emit(child);
+                    Emit(kNot);
+                }
+                return;
+            }
+
+            case Node::kOr:
+            {
+                // the names are combined into one mask
+                bitset_type anyMask;
+                unsigned nTerms = 0;
+                for (std::vector< std::unique_ptr< Node > >::const_iterator it = node.fChildren.begin(); it != node.fChildren.end(); ++it)
+                {
+                    if ((*it)->fType == Node::kName) anyMask.set((*it)->fBit);
+                }
+                if (anyMask.any())
+                {
+                    Emit(kAny, anyMask);
+                    ++nTerms;
+                }
+                for (std::vector< std::unique_ptr< Node > >::const_iterator it = node.fChildren.begin(); it != node.fChildren.end(); ++it)
+                {
+                    if ((*it)->fType == Node::kName) continue;
+                    Emit(**it);
+                    if (++nTerms > 1) Emit(kOr);
+                }
+                return;
+            }
+
+            case Node::kAnd:
+            {
+                // the names are combined into one mask, and the negated names and ||'s of names into another
+                bitset_type allMask;
+                bitset_type noneMask;
+                unsigned nTerms = 0;
+                for (std::vector< std::unique_ptr< Node > >::const_iterator it = node.fChildren.begin(); it != node.fChildren.end(); ++it)
+                {
+                    if ((*it)->fType == Node::kName) allMask.set((*it)->fBit);
+                    else if ((*it)->fType == Node::kNot && (*it)->fChildren.front()->IsAnyOfNames()) noneMask |= (*it)->fChildren.front()->NameMask();
+                }
+                if (allMask.any())
+                {
+                    Emit(kAll, allMask);
+                    ++nTerms;
+                }
+                if (noneMask.any())
+                {
+                    Emit(kNone, noneMask);
+                    if (++nTerms > 1) Emit(kAnd);
+                }
+                for (std::vector< std::unique_ptr< Node > >::const_iterator it = node.fChildren.begin(); it != node.fChildren.end(); ++it)
+                {
+                    if ((*it)->fType == Node::kName) continue;
+                    if ((*it)->fType == Node::kNot && (*it)->fChildren.front()->IsAnyOfNames()) continue;
+                    Emit(**it);
+                    if (++nTerms > 1) Emit(kAnd);
+                }
+                return;
+            }
+        }
+        return;
+    }
+
+    void KTCutExpression::Emit(OpCode op, const bitset_type& mask)
+    {
+        Instruction instruction;
+        instruction.fOp = op;
+        instruction.fMask = mask;
+        fProgram.push_back(instruction);
+        return;
+    }
+
+} /* namespace Nymph */
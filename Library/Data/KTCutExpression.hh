@@ -0,0 +1,115 @@
+/*
+ * KTCutExpression.hh
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: nsoblath
+ */
+
+#ifndef KTCUTEXPRESSION_HH_
+#define KTCUTEXPRESSION_HH_
+
+#include "KTCutStatus.hh"
+
+#include <string>
+#include <vector>
+
+namespace Nymph
+{
+    /*!
+     @class KTCutExpression
+     @author N. S. Oblath
+
+     @brief Logical expression of named cuts, compiled to a few operations on the cut summary.
+
+     @details
+     An expression is made of cut names (as given to KT_REGISTER_CUT), combined with the operators && (and), || (or), and ! (not),
+     and grouped with parentheses; ! binds most tightly, and && more tightly than ||.  For example:
+         energy-cut && !(pileup || saturation)
+     A cut name is true if the data is cut by that cut; cuts that haven't been applied to the data are false.
+
+     Compile() parses the expression and resolves the names to their bits in the cut summary (see KTCutRegistry), so the cuts must be registered.
+     The expression is compiled to a short program for a stack machine in which each instruction tests the summary against a mask:
+     the names in a group of ||'s are combined into one "any of" mask, the names in a group of &&'s into one "all of" mask,
+     and negated names and groups of ||'s into "none of" masks.  The example above becomes two instructions and an AND.
+
+     Evaluate() runs the program on the summary of a cut status; it doesn't allocate, and can be called concurrently.
+    */
+    class KTCutExpression
+    {
+        public:
+            typedef KTCutStatus::bitset_type bitset_type;
+
+            /// Maximum nesting of the compiled program
+            static const unsigned sMaxDepth = 64;
+
+        public:
+            KTCutExpression();
+            ~KTCutExpression();
+
+            /// Parses and compiles the expression; returns false (and leaves the expression empty) if it's invalid or uses a cut that isn't registered
+            bool Compile(const std::string& expression);
+
+            /// Returns true if the cut status satisfies the expression; an empty expression is never satisfied
+            bool Evaluate(const KTCutStatus& cutStatus) const;
+            bool Evaluate(const bitset_type& summary) const;
+
+            /// Removes the expression
+            void Clear();
+
+            bool empty() const;
+
+            /// The expression as given to Compile()
+            const std::string& GetExpression() const;
+
+            /// Number of instructions in the compiled program
+            unsigned GetNInstructions() const;
+
+        private:
+            enum OpCode
+            {
+                kAny,  // push whether any of the bits in the mask are set
+                kAll,  // push whether all of the bits in the mask are set
+                kNone, // push whether none of the bits in the mask are set
+                kNot,
+                kAnd,
+                kOr
+            };
+
+            struct Instruction
+            {
+                OpCode fOp;
+                bitset_type fMask;
+            };
+
+            struct Node;
+            class Parser;
+
+            void Emit(const Node& node);
+            void Emit(OpCode op, const bitset_type& mask = bitset_type());
+
+            std::string fExpression;
+            std::vector< Instruction > fProgram;
+    };
+
+    inline bool KTCutExpression::Evaluate(const KTCutStatus& cutStatus) const
+    {
+        return Evaluate(cutStatus.GetSummary());
+    }
+
+    inline bool KTCutExpression::empty() const
+    {
+        return fProgram.empty();
+    }
+
+    inline const std::string& KTCutExpression::GetExpression() const
+    {
+        return fExpression;
+    }
+
+    inline unsigned KTCutExpression::GetNInstructions() const
+    {
+        return fProgram.size();
+    }
+
+} /* namespace Nymph */
+#endif /* KTCUTEXPRESSION_HH_ */
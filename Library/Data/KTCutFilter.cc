@@ -22,8 +22,8 @@ namespace Nymph
             KTProcessor(name),
             fCutMask(),
             fCutMaskInt(0),
-            fConvertToBitset(false),
             fAllBits(true),
+            fCutExpression(),
             fAfterCutSignal("all", this),
             fAfterCutPassSignal("pass", this),
             fAfterCutFailSignal("fail", this)
@@ -50,29 +50,42 @@ namespace Nymph
         {
             SetCutMaskAll();
         }
+        if (node.has("cut-expression"))
+        {
+            if (! SetCutExpression(node["cut-expression"]().as_string()))
+            {
+                KTERROR(cutlog, "Unable to use cut expression <" << node["cut-expression"]().as_string() << ">");
+                return false;
+            }
+        }
+
+        return true;
+    }
 
+    bool KTCutFilter::SetCutExpression(const std::string& expression)
+    {
+        KTCutExpression cutExpression;
+        if (! cutExpression.Compile(expression)) return false;
+        fCutExpression = cutExpression;
+        fAllBits = false;
         return true;
     }
 
     bool KTCutFilter::Filter(KTData& data)
     {
-        if (fAllBits)
+        const KTCutStatus& cutStatus = data.GetCutStatus();
+        if (! fCutExpression.empty())
         {
-            return data.GetCutStatus().IsCut();
+            return fCutExpression.Evaluate(cutStatus);
         }
-
-        KTCutStatus& cutStatus = data.GetCutStatus();
-        if (fConvertToBitset)
+        if (fAllBits)
         {
-            fCutMask = cutStatus.ToBitset(fCutMaskInt);
+            return cutStatus.IsCut();
         }
-
-        if (fCutMask.size() != cutStatus.size()) fCutMask.resize(cutStatus.size());
-
         return cutStatus.IsCut(fCutMask);
     }
 
-    void KTCutFilter::FilterData(KTDataPtr dataPtr)
+    void KTCutFilter::FilterData(const KTDataPtr& dataPtr)
     {
         // all KTDataPtr's have KTData, so we won't bother checking
         if (Filter(dataPtr->Of< KTData >()))
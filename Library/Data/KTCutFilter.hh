@@ -11,6 +11,7 @@
 
 #include "KTProcessor.hh"
 
+#include "KTCutExpression.hh"
 #include "KTCutStatus.hh"
 
 #include "KTLogger.hh"
@@ -32,6 +33,11 @@ namespace Nymph
      @details
      KTCutFilter checks the status of cuts that have already been applied to a data.  If the bitwise AND of the cut status with
      the configurable cut mask is non-zero, than the data fails the filter.
+     Each cut has a fixed bit in the cut status (see KTCutRegistry), so a mask selects the same cuts for all data.
+
+     Alternatively, the filter can use a logical expression of cut names (see KTCutExpression), in which case the data fails the filter
+     if the expression is true; e.g. "energy-cut && !(pileup || saturation)".  The expression is compiled when it's set,
+     so checking each data object takes a few operations on the cut status.
 
      Interpretation of the boolean returned by Filter(KTData&):
      - TRUE means the data failed the cut filter.
@@ -44,6 +50,8 @@ namespace Nymph
      - "cut-mask": string -- Set the cut mask with a string of 1's and 0's. The first character is the highest significant bit, and the last character is the least significant bit.
                              If present, it overrules cut-mask-int.
      - "cut-mask-int": unsigned int -- Set the cut mask with an unsigned integer's bit values.
+     - "cut-expression": string -- Logical expression of cut names, using &&, ||, !, and parentheses; the data fails the filter if it's true.
+                                   If present, it overrules the cut masks.  Configuration fails if the expression is invalid or uses a cut that isn't registered.
 
      Slots:
      - "filter": void (KTDataPtr) -- Checks the cut status of the received data ANDed with the cut mask; No data is added.
@@ -70,17 +78,22 @@ namespace Nymph
             /// Set the cut mask to use all cuts
             void SetCutMaskAll();
 
+            /// Use a logical expression of cut names instead of a mask; returns false, and leaves the filter unchanged, if the expression is invalid
+            bool SetCutExpression(const std::string& expression);
+            const KTCutExpression& GetCutExpression() const;
+
         private:
             KTCutStatus::bitset_type fCutMask;
             MEMBERVARIABLE_NOSET(unsigned long long, CutMaskInt);
 
-            bool fConvertToBitset;
             bool fAllBits;
 
+            KTCutExpression fCutExpression;
+
         public:
             bool Filter(KTData& data);
 
-            void FilterData(KTDataPtr);
+            void FilterData(const KTDataPtr&);
 
 
             //***************
@@ -104,34 +117,37 @@ namespace Nymph
     inline void KTCutFilter::SetCutMask(KTCutStatus::bitset_type mask)
     {
         fCutMask = mask;
-        fConvertToBitset = false;
         fAllBits = false;
+        fCutExpression.Clear();
         return;
     }
 
     inline void KTCutFilter::SetCutMask(unsigned long long mask)
     {
+        // cut bits are fixed, so the mask is only converted once
         fCutMaskInt = mask;
-        fConvertToBitset = true;
-        fAllBits = false;
+        SetCutMask(KTCutStatus::bitset_type(mask));
         return;
     }
 
     inline void KTCutFilter::SetCutMask(const std::string& mask)
     {
-        fCutMask = KTCutStatus::bitset_type(mask);
-        fConvertToBitset = false;
-        fAllBits = false;
+        SetCutMask(KTCutStatus::bitset_type(mask));
         return;
     }
 
     inline void KTCutFilter::SetCutMaskAll()
     {
-        fCutMask.clear();
-        fConvertToBitset = false;
+        fCutMask.reset();
         fAllBits = true;
+        fCutExpression.Clear();
         return;
     }
 
+    inline const KTCutExpression& KTCutFilter::GetCutExpression() const
+    {
+        return fCutExpression;
+    }
+
 } /* namespace Nymph */
 #endif /* KTCUTFILTER_HH_ */
@@ -0,0 +1,377 @@
+/*
+ * KTCutFlow.cc
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: nsoblath
+ */
+
+#include "KTCutFlow.hh"
+
+#include "KTLogger.hh"
+
+#include <boost/thread/locks.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/tss.hpp>
+
+#include <algorithm>
+#include <iomanip>
+
+namespace Nymph
+{
+    KTLOGGER(cutlog, "KTCutFlow");
+
+    namespace
+    {
+        const unsigned sMaxCuts = KTCutRegistry::sMaxCuts;
+
+        // Each accumulator is only written by its own thread; the members are atomic so that GetSummary() can read them safely
+        struct Accumulator
+        {
+            std::atomic< uint64_t > fNData;
+            std::atomic< uint64_t > fNRejected;
+            std::atomic< uint64_t > fNApplied[sMaxCuts];
+            std::atomic< uint64_t > fNFailed[sMaxCuts];
+            std::atomic< uint64_t > fNExclusive[sMaxCuts];
+            // number of data objects for which this was the first cut failed in the cut flow
+            std::atomic< uint64_t > fNFirstFailed[sMaxCuts];
+
+            void Clear()
+            {
+                fNData.store(0, std::memory_order_relaxed);
+                fNRejected.store(0, std::memory_order_relaxed);
+                for (unsigned iBit = 0; iBit < sMaxCuts; ++iBit)
+                {
+                    fNApplied[iBit].store(0, std::memory_order_relaxed);
+                    fNFailed[iBit].store(0, std::memory_order_relaxed);
+                    fNExclusive[iBit].store(0, std::memory_order_relaxed);
+                    fNFirstFailed[iBit].store(0, std::memory_order_relaxed);
+                }
+                return;
+            }
+
+            /// Adds the counts of another accumulator, which must not be recording
+            void Add(const Accumulator& other)
+            {
+                AddCount(fNData, other.fNData);
+                AddCount(fNRejected, other.fNRejected);
+                for (unsigned iBit = 0; iBit < sMaxCuts; ++iBit)
+                {
+                    AddCount(fNApplied[iBit], other.fNApplied[iBit]);
+                    AddCount(fNFailed[iBit], other.fNFailed[iBit]);
+                    AddCount(fNExclusive[iBit], other.fNExclusive[iBit]);
+                    AddCount(fNFirstFailed[iBit], other.fNFirstFailed[iBit]);
+                }
+                return;
+            }
+
+            static void AddCount(std::atomic< uint64_t >& counter, const std::atomic< uint64_t >& other)
+            {
+                counter.store(counter.load(std::memory_order_relaxed) + other.load(std::memory_order_relaxed), std::memory_order_relaxed);
+                return;
+            }
+        };
+
+        // the counters wrap, so a count can be taken back by adding sMinusOne, even by a thread other than the one that added it
+        const uint64_t sMinusOne = ~uint64_t(0);
+
+        inline void Add(std::atomic< uint64_t >& counter, uint64_t delta)
+        {
+            counter.store(counter.load(std::memory_order_relaxed) + delta, std::memory_order_relaxed);
+            return;
+        }
+
+        void RetireAccumulator(Accumulator* acc);
+
+        struct CutFlowState
+        {
+            CutFlowState() :
+                    fLocal(&RetireAccumulator),
+                    fAccumulators(),
+                    fSpareAccumulators(),
+                    fRetired(),
+                    fMutex(),
+                    fOrder()
+            {
+                fRetired.Clear();
+                for (unsigned iBit = 0; iBit < sMaxCuts; ++iBit)
+                {
+                    fRanks[iBit] = sMaxCuts + iBit;
+                }
+            }
+
+            // the accumulators are owned by the cut-flow state, not by the thread-specific pointer
+            boost::thread_specific_ptr< Accumulator > fLocal;
+            // accumulators of the threads that are recording
+            std::vector< Accumulator* > fAccumulators;
+            // accumulators of threads that have exited, to be reused by new threads
+            std::vector< Accumulator* > fSpareAccumulators;
+            // combined counts of the threads that have exited
+            Accumulator fRetired;
+            boost::mutex fMutex;
+            // bits of the cuts given to SetOrder()
+            std::vector< unsigned > fOrder;
+            // position of each bit in the cut flow; the bits that weren't given to SetOrder() follow the ones that were
+            unsigned fRanks[sMaxCuts];
+        };
+
+        CutFlowState& State()
+        {
+            // never deleted, so that cut statuses destroyed during static destruction can still be recorded
+            static CutFlowState* sState = new CutFlowState();
+            return *sState;
+        }
+
+        Accumulator* CreateAccumulator(CutFlowState& state)
+        {
+            boost::lock_guard< boost::mutex > lock(state.fMutex);
+            Accumulator* acc = NULL;
+            if (state.fSpareAccumulators.empty())
+            {
+                acc = new Accumulator();
+                acc->Clear();
+            }
+            else
+            {
+                acc = state.fSpareAccumulators.back();
+                state.fSpareAccumulators.pop_back();
+            }
+            state.fAccumulators.push_back(acc);
+            state.fLocal.reset(acc);
+            return acc;
+        }
+
+        // called when a thread that has recorded exits: its counts are kept, and its accumulator is set aside for another thread,
+        // so the number of accumulators is the most threads that have been recording at once
+        void RetireAccumulator(Accumulator* acc)
+        {
+            CutFlowState& state = State();
+            boost::lock_guard< boost::mutex > lock(state.fMutex);
+            state.fRetired.Add(*acc);
+            acc->Clear();
+            state.fAccumulators.erase(std::find(state.fAccumulators.begin(), state.fAccumulators.end(), acc));
+            state.fSpareAccumulators.push_back(acc);
+            return;
+        }
+
+        inline unsigned LowestBit(unsigned long long bits)
+        {
+            return __builtin_ctzll(bits);
+        }
+
+        Accumulator* LocalAccumulator(CutFlowState& state)
+        {
+            Accumulator* acc = state.fLocal.get();
+            if (acc == NULL) acc = CreateAccumulator(state);
+            return acc;
+        }
+
+        // adds (delta is 1) or takes back (delta is sMinusOne) the counts of one data object
+        void Count(const CutFlowState& state, Accumulator* acc, unsigned long long appliedBits, unsigned long long failedBits, uint64_t delta)
+        {
+            Add(acc->fNData, delta);
+
+            for (unsigned long long bits = appliedBits; bits != 0; bits &= bits - 1)
+            {
+                Add(acc->fNApplied[LowestBit(bits)], delta);
+            }
+
+            if (failedBits == 0) return;
+
+            Add(acc->fNRejected, delta);
+            unsigned firstFailed = LowestBit(failedBits);
+            for (unsigned long long bits = failedBits; bits != 0; bits &= bits - 1)
+            {
+                unsigned bit = LowestBit(bits);
+                Add(acc->fNFailed[bit], delta);
+                if (state.fRanks[bit] < state.fRanks[firstFailed]) firstFailed = bit;
+            }
+            Add(acc->fNFirstFailed[firstFailed], delta);
+            // exactly one bit set
+            if ((failedBits & (failedBits - 1)) == 0) Add(acc->fNExclusive[firstFailed], delta);
+            return;
+        }
+
+        std::string EscapeJSON(const std::string& text)
+        {
+            std::string escaped;
+            for (std::string::const_iterator it = text.begin(); it != text.end(); ++it)
+            {
+                if (*it == '"' || *it == '\\') escaped += '\\';
+                escaped += *it;
+            }
+            return escaped;
+        }
+    }
+
+
+    std::atomic< bool > KTCutFlow::sIsEnabled(false);
+    std::atomic< unsigned > KTCutFlow::sGeneration(0);
+
+    void KTCutFlow::SetIsEnabled(bool flag)
+    {
+        // a data object recorded before the cut flow was disabled may have changed since, so it's recorded afresh once it's enabled again
+        if (sIsEnabled.exchange(flag, std::memory_order_relaxed) != flag) sGeneration.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    void KTCutFlow::Record(const bitset_type& applied, const bitset_type& failed)
+    {
+        CutFlowState& state = State();
+        Count(state, LocalAccumulator(state), applied.to_ullong(), failed.to_ullong(), 1);
+        return;
+    }
+
+    void KTCutFlow::Update(const bitset_type& prevApplied, const bitset_type& prevFailed, const bitset_type& applied, const bitset_type& failed)
+    {
+        if (applied == prevApplied && failed == prevFailed) return;
+        CutFlowState& state = State();
+        Accumulator* acc = LocalAccumulator(state);
+        Count(state, acc, prevApplied.to_ullong(), prevFailed.to_ullong(), sMinusOne);
+        Count(state, acc, applied.to_ullong(), failed.to_ullong(), 1);
+        return;
+    }
+
+    bool KTCutFlow::SetOrder(const std::vector< std::string >& cutNames)
+    {
+        KTCutRegistry* registry = KTCutRegistry::get_instance();
+        std::vector< unsigned > order;
+        for (std::vector< std::string >::const_iterator it = cutNames.begin(); it != cutNames.end(); ++it)
+        {
+            unsigned bit = registry->GetBit(*it);
+            if (bit == KTCutRegistry::sNoBit)
+            {
+                KTERROR(cutlog, "Cannot order the cut flow: cut <" << *it << "> is not registered");
+                return false;
+            }
+            if (std::find(order.begin(), order.end(), bit) == order.end()) order.push_back(bit);
+        }
+
+        CutFlowState& state = State();
+        {
+            boost::lock_guard< boost::mutex > lock(state.fMutex);
+            state.fOrder = order;
+            for (unsigned iBit = 0; iBit < sMaxCuts; ++iBit)
+            {
+                state.fRanks[iBit] = sMaxCuts + iBit;
+            }
+            for (unsigned iPos = 0; iPos < order.size(); ++iPos)
+            {
+                state.fRanks[order[iPos]] = iPos;
+            }
+        }
+        Reset();
+        return true;
+    }
+
+    KTCutFlow::Summary KTCutFlow::GetSummary()
+    {
+        Summary summary;
+        summary.fNData = 0;
+        summary.fNRejected = 0;
+
+        uint64_t nApplied[sMaxCuts] = {};
+        uint64_t nFailed[sMaxCuts] = {};
+        uint64_t nExclusive[sMaxCuts] = {};
+        uint64_t nFirstFailed[sMaxCuts] = {};
+        std::vector< unsigned > order;
+
+        CutFlowState& state = State();
+        {
+            boost::lock_guard< boost::mutex > lock(state.fMutex);
+            std::vector< const Accumulator* > accumulators(state.fAccumulators.begin(), state.fAccumulators.end());
+            accumulators.push_back(&state.fRetired);
+            for (std::vector< const Accumulator* >::const_iterator it = accumulators.begin(); it != accumulators.end(); ++it)
+            {
+                summary.fNData += (*it)->fNData.load(std::memory_order_relaxed);
+                summary.fNRejected += (*it)->fNRejected.load(std::memory_order_relaxed);
+                for (unsigned iBit = 0; iBit < sMaxCuts; ++iBit)
+                {
+                    nApplied[iBit] += (*it)->fNApplied[iBit].load(std::memory_order_relaxed);
+                    nFailed[iBit] += (*it)->fNFailed[iBit].load(std::memory_order_relaxed);
+                    nExclusive[iBit] += (*it)->fNExclusive[iBit].load(std::memory_order_relaxed);
+                    nFirstFailed[iBit] += (*it)->fNFirstFailed[iBit].load(std::memory_order_relaxed);
+                }
+            }
+            order = state.fOrder;
+        }
+
+        // the cuts that weren't ordered follow in the order in which they were registered
+        KTCutRegistry* registry = KTCutRegistry::get_instance();
+        unsigned nCuts = registry->GetNCuts();
+        for (unsigned iBit = 0; iBit < nCuts; ++iBit)
+        {
+            if (nApplied[iBit] != 0 && std::find(order.begin(), order.end(), iBit) == order.end()) order.push_back(iBit);
+        }
+
+        uint64_t nCumulative = 0;
+        for (std::vector< unsigned >::const_iterator it = order.begin(); it != order.end(); ++it)
+        {
+            nCumulative += nFirstFailed[*it];
+
+            Entry entry;
+            entry.fName = registry->GetName(*it);
+            entry.fNApplied = nApplied[*it];
+            entry.fNFailed = nFailed[*it];
+            entry.fNPassed = entry.fNApplied - entry.fNFailed;
+            entry.fNExclusive = nExclusive[*it];
+            entry.fNCumulative = nCumulative;
+            summary.fEntries.push_back(entry);
+        }
+        return summary;
+    }
+
+    void KTCutFlow::Reset()
+    {
+        CutFlowState& state = State();
+        boost::lock_guard< boost::mutex > lock(state.fMutex);
+        for (std::vector< Accumulator* >::iterator it = state.fAccumulators.begin(); it != state.fAccumulators.end(); ++it)
+        {
+            (*it)->Clear();
+        }
+        state.fRetired.Clear();
+        // the data objects that were recorded before are recorded afresh when their cuts next change
+        sGeneration.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    void KTCutFlow::PrintTable(std::ostream& out)
+    {
+        Summary summary = GetSummary();
+        std::size_t nameWidth = 10;
+        for (std::vector< Entry >::const_iterator it = summary.fEntries.begin(); it != summary.fEntries.end(); ++it)
+        {
+            nameWidth = std::max(nameWidth, it->fName.size() + 2);
+        }
+
+        out << "Data objects: " << summary.fNData << "; rejected: " << summary.fNRejected << '\n';
+        out << std::left << std::setw(nameWidth) << "Cut" << std::right
+                << std::setw(12) << "Applied" << std::setw(12) << "Passed" << std::setw(12) << "Failed"
+                << std::setw(12) << "Exclusive" << std::setw(12) << "Cumulative" << std::setw(12) << "Remaining" << '\n';
+        for (std::vector< Entry >::const_iterator it = summary.fEntries.begin(); it != summary.fEntries.end(); ++it)
+        {
+            out << std::left << std::setw(nameWidth) << it->fName << std::right
+                    << std::setw(12) << it->fNApplied << std::setw(12) << it->fNPassed << std::setw(12) << it->fNFailed
+                    << std::setw(12) << it->fNExclusive << std::setw(12) << it->fNCumulative << std::setw(12) << summary.fNData - it->fNCumulative << '\n';
+        }
+        return;
+    }
+
+    void KTCutFlow::WriteJSON(std::ostream& out)
+    {
+        Summary summary = GetSummary();
+        out << "{\n";
+        out << "    \"n-data\": " << summary.fNData << ",\n";
+        out << "    \"n-rejected\": " << summary.fNRejected << ",\n";
+        out << "    \"cuts\": [";
+        for (std::vector< Entry >::const_iterator it = summary.fEntries.begin(); it != summary.fEntries.end(); ++it)
+        {
+            if (it != summary.fEntries.begin()) out << ",";
+            out << "\n        {\"name\": \"" << EscapeJSON(it->fName) << "\", \"applied\": " << it->fNApplied
+                    << ", \"passed\": " << it->fNPassed << ", \"failed\": " << it->fNFailed
+                    << ", \"exclusive\": " << it->fNExclusive << ", \"cumulative\": " << it->fNCumulative << "}";
+        }
+        out << "\n    ]\n}\n";
+        return;
+    }
+
+} /* namespace Nymph */
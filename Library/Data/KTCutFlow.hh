@@ -0,0 +1,124 @@
+/*
+ * KTCutFlow.hh
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: nsoblath
+ */
+
+#ifndef KTCUTFLOW_HH_
+#define KTCUTFLOW_HH_
+
+#include "KTCutRegistry.hh"
+
+#include <atomic>
+#include <bitset>
+#include <inttypes.h>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace Nymph
+{
+    /*!
+     @class KTCutFlow
+     @author N. S. Oblath
+
+     @brief Opt-in cut-flow statistics: how many data objects each cut was applied to, passed, and rejected.
+
+     @details
+     When the cut flow is enabled, a KTCutStatus is recorded with Record() when cut results are first added to or set on it,
+     and each later change to its cuts is recorded with Update(), which takes back the counts of its previous state and adds those of the new one.
+     The counts therefore always reflect the current state of every data object, whether it's still alive or has been reset
+     (e.g. when it's recycled by KTDataPool) or destroyed.  Copies of a cut status are only recorded if cut results are added to
+     or set on them after the copy is made, and then only with those cuts (see KTCutStatus).
+
+     For each cut, in the order of the cut flow, the statistics are:
+     - Applied: the number of data objects the cut was applied to;
+     - Passed and Failed: how many of those passed and failed the cut;
+     - Exclusive: the number of data objects that failed this cut and no other;
+     - Cumulative: the number of data objects that failed this cut or any cut before it in the cut flow.
+
+     The order of the cut flow is the order in which the cuts were registered (see KTCutRegistry), unless it's set with SetOrder(),
+     in which case the cuts that weren't named follow in the order in which they were registered.
+
+     Each thread records into its own set of counters, so recording takes no locks and doesn't contend with other threads;
+     each change costs a few counter updates for each cut applied to the data object.  There's no cost beyond checking a flag when the cut flow is disabled.
+     A count taken back by one thread may have been added by another; the counters wrap, so their sum is still right.
+     When a thread that has recorded exits, its counts are kept, and its counters are reused by the next thread that starts recording,
+     so the memory used is set by the most threads recording at once, not by the number of threads over the life of the program.
+     The counters of all of the threads are combined by GetSummary(), which is meant to be called once the threads recording are done.
+
+     Changes made to a cut status while the cut flow is disabled aren't recorded.  Once it's reset (see Reset()), or disabled and enabled again,
+     the data objects that were recorded are left out until their cuts next change, when they're recorded afresh.
+     KTProcessorToolbox prints the cut flow after Run(), and optionally writes it to a JSON file (see its "cut-flow" options).
+    */
+    class KTCutFlow
+    {
+        public:
+            typedef std::bitset< KTCutRegistry::sMaxCuts > bitset_type;
+
+            struct Entry
+            {
+                std::string fName;
+                uint64_t fNApplied;
+                uint64_t fNPassed;
+                uint64_t fNFailed;
+                uint64_t fNExclusive;
+                uint64_t fNCumulative;
+            };
+
+            struct Summary
+            {
+                /// Number of data objects recorded
+                uint64_t fNData;
+                /// Number of data objects that failed any cut
+                uint64_t fNRejected;
+                /// The cuts that were applied, or were named in SetOrder(), in the order of the cut flow
+                std::vector< Entry > fEntries;
+            };
+
+        public:
+            static bool GetIsEnabled();
+            /// Changes to cut statuses made while the cut flow is enabled are recorded
+            static void SetIsEnabled(bool flag);
+            /// Changes when the cut flow is reset, or enabled or disabled; a data object recorded in an earlier generation is recorded afresh
+            static unsigned GetGeneration();
+
+            /// Records the cut state of a new data object: the bits (see KTCutRegistry) of the cuts that were applied, and of the cuts that it failed
+            static void Record(const bitset_type& applied, const bitset_type& failed);
+            /// Records a change to the cut state of a data object that has been recorded
+            static void Update(const bitset_type& prevApplied, const bitset_type& prevFailed, const bitset_type& applied, const bitset_type& failed);
+
+            /// Sets the order of the cut flow, and resets the counters; returns false (and leaves the order unchanged) if a cut isn't registered.
+            /// Must not be called while cut statuses are being recorded.
+            static bool SetOrder(const std::vector< std::string >& cutNames);
+
+            /// Combines the counters of all threads
+            static Summary GetSummary();
+
+            /// Sets all of the counters to zero, and starts a new generation; must not be called while cut statuses are being recorded
+            static void Reset();
+
+            /// Writes the cut flow as a table
+            static void PrintTable(std::ostream& out);
+            /// Writes the cut flow as a JSON object
+            static void WriteJSON(std::ostream& out);
+
+        private:
+            static std::atomic< bool > sIsEnabled;
+            static std::atomic< unsigned > sGeneration;
+    };
+
+
+    inline bool KTCutFlow::GetIsEnabled()
+    {
+        return sIsEnabled.load(std::memory_order_relaxed);
+    }
+
+    inline unsigned KTCutFlow::GetGeneration()
+    {
+        return sGeneration.load(std::memory_order_relaxed);
+    }
+
+} /* namespace Nymph */
+#endif /* KTCUTFLOW_HH_ */
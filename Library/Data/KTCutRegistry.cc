@@ -0,0 +1,67 @@
+/*
+ * KTCutRegistry.cc
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: nsoblath
+ */
+
+#include "KTCutRegistry.hh"
+
+#include "KTLogger.hh"
+
+#include <boost/thread/locks.hpp>
+
+namespace Nymph
+{
+    const unsigned KTCutRegistry::sMaxCuts;
+    const unsigned KTCutRegistry::sNoBit;
+
+    KTCutRegistry::KTCutRegistry() :
+            fBits(),
+            fNames(),
+            fTypeIds(),
+            fNCuts(0)
+    {
+    }
+
+    KTCutRegistry::~KTCutRegistry()
+    {
+    }
+
+    unsigned KTCutRegistry::Register(const std::string& name, unsigned typeId)
+    {
+        // A local (static) logger is created inside this function to avoid static initialization order problems
+        KTLOGGER(cutlog_reg, "KTCutRegistry-Register");
+
+        boost::unique_lock< boost::mutex > lock(fMutex);
+        std::unordered_map< std::string, unsigned >::const_iterator it = fBits.find(name);
+        if (it != fBits.end())
+        {
+            return it->second;
+        }
+
+        unsigned bit = fNCuts.load(std::memory_order_relaxed);
+        if (bit == sMaxCuts)
+        {
+            KTERROR(cutlog_reg, "Cannot register cut <" << name << ">: all " << sMaxCuts << " bits have been assigned; it will not be included in cut summaries");
+            fBits.insert(std::make_pair(name, sNoBit));
+            return sNoBit;
+        }
+        fNames[bit] = name;
+        fTypeIds[bit] = typeId;
+        fBits.insert(std::make_pair(name, bit));
+        // the entry is complete before it's published
+        fNCuts.store(bit + 1, std::memory_order_release);
+        KTDEBUG(cutlog_reg, "Registered cut <" << name << "> with bit " << bit);
+        return bit;
+    }
+
+    unsigned KTCutRegistry::GetBit(const std::string& name) const
+    {
+        boost::unique_lock< boost::mutex > lock(fMutex);
+        std::unordered_map< std::string, unsigned >::const_iterator it = fBits.find(name);
+        if (it == fBits.end()) return sNoBit;
+        return it->second;
+    }
+
+} /* namespace Nymph */
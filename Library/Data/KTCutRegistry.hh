@@ -0,0 +1,108 @@
+/*
+ * KTCutRegistry.hh
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: nsoblath
+ */
+
+#ifndef KTCUTREGISTRY_HH_
+#define KTCUTREGISTRY_HH_
+
+#include "singleton.hh"
+
+#include <boost/thread/mutex.hpp>
+
+#include <atomic>
+#include <string>
+#include <unordered_map>
+
+namespace Nymph
+{
+    /*!
+     @class KTCutRegistry
+     @author N. S. Oblath
+
+     @brief Assigns each type of cut result a fixed bit in the cut summary of KTCutStatus.
+
+     @details
+     Cut result types are registered by KT_REGISTER_CUT when the program starts, and otherwise the first time they're used
+     (see KTExtensibleCutResult::Bit()).  Bits are assigned in the order in which the types are registered, and they don't change,
+     so a cut mask selects the same cuts for every data object, regardless of the order in which the cuts were applied.
+
+     There are sMaxCuts bits; cut result types registered after they've all been assigned are given sNoBit, and don't appear in the cut summary.
+
+     Registration and GetBit() are thread-safe.  GetName() and GetTypeId() don't lock, since the entry for a bit never changes once it's assigned.
+    */
+    class KTCutRegistry : public scarab::singleton< KTCutRegistry >
+    {
+        public:
+            static const unsigned sMaxCuts = 64;
+            static const unsigned sNoBit = ~0u;
+
+        public:
+            /// Assigns the next bit to the cut result with the given name and type id (see KTExtensibleStruct::TypeId()), if it doesn't have one already.
+            /// Returns the bit, or sNoBit if all of the bits have been assigned.
+            unsigned Register(const std::string& name, unsigned typeId);
+
+            /// Returns the bit of the named cut result, or sNoBit if it hasn't been registered
+            unsigned GetBit(const std::string& name) const;
+            /// Returns the name of the cut result with the given bit, which must have been assigned
+            const std::string& GetName(unsigned bit) const;
+            /// Returns the type id of the cut result with the given bit, which must have been assigned
+            unsigned GetTypeId(unsigned bit) const;
+
+            /// Number of bits that have been assigned
+            unsigned GetNCuts() const;
+
+        protected:
+            friend class scarab::singleton< KTCutRegistry >;
+            friend class scarab::destroyer< KTCutRegistry >;
+            KTCutRegistry();
+            ~KTCutRegistry();
+
+        private:
+            std::unordered_map< std::string, unsigned > fBits;
+            std::string fNames[sMaxCuts];
+            unsigned fTypeIds[sMaxCuts];
+            std::atomic< unsigned > fNCuts;
+            mutable boost::mutex fMutex;
+    };
+
+    /// Registers XCutResult with the cut registry; use with the macro KT_REGISTER_CUT
+    template< class XCutResult >
+    class KTCutRegistrar
+    {
+        public:
+            KTCutRegistrar();
+            ~KTCutRegistrar();
+    };
+
+
+    inline const std::string& KTCutRegistry::GetName(unsigned bit) const
+    {
+        return fNames[bit];
+    }
+
+    inline unsigned KTCutRegistry::GetTypeId(unsigned bit) const
+    {
+        return fTypeIds[bit];
+    }
+
+    inline unsigned KTCutRegistry::GetNCuts() const
+    {
+        return fNCuts.load(std::memory_order_acquire);
+    }
+
+
+    template< class XCutResult >
+    KTCutRegistrar< XCutResult >::KTCutRegistrar()
+    {
+        XCutResult::Bit();
+    }
+
+    template< class XCutResult >
+    KTCutRegistrar< XCutResult >::~KTCutRegistrar()
+    {}
+
+} /* namespace Nymph */
+#endif /* KTCUTREGISTRY_HH_ */
@@ -8,6 +8,7 @@
 #ifndef KTCUTRESULT_HH_
 #define KTCUTRESULT_HH_
 
+#include "KTCutRegistry.hh"
 #include "KTExtensibleStruct.hh"
 
 #include "KTMemberVariable.hh"
@@ -25,6 +26,8 @@ namespace Nymph
             virtual ~KTCutResultCore() {}
 
             virtual const std::string& Name() const = 0;
+            /// Bit of this cut in the cut summary (see KTCutRegistry)
+            virtual unsigned GetBit() const = 0;
 
             MEMBERVARIABLE_PROTECTED(bool, State);
     };
@@ -39,6 +42,10 @@ namespace Nymph
             virtual ~KTExtensibleCutResult() {}
 
             const std::string& Name() const;
+            unsigned GetBit() const;
+
+            /// Bit of XDerivedType in the cut summary; the type is registered with KTCutRegistry the first time this is called, if it wasn't already
+            static unsigned Bit();
     };
 
     template< class XDerivedType >
@@ -47,6 +54,19 @@ namespace Nymph
         return XDerivedType::sName;
     }
 
+    template< class XDerivedType >
+    inline unsigned KTExtensibleCutResult< XDerivedType >::GetBit() const
+    {
+        return Bit();
+    }
+
+    template< class XDerivedType >
+    inline unsigned KTExtensibleCutResult< XDerivedType >::Bit()
+    {
+        static const unsigned sBit = KTCutRegistry::get_instance()->Register(XDerivedType::sName, KTExtensibleCutResult::TypeId());
+        return sBit;
+    }
+
 } /* namespace Nymph */
 
 #endif /* KTCUTRESULT_HH_ */
@@ -10,60 +10,118 @@
 #include "KTExtensibleStructFactory.hh"
 #include "KTLogger.hh"
 
+#include <boost/thread/locks.hpp>
+#include <boost/thread/mutex.hpp>
+
+#include <cstdint>
+#include <functional>
+#include <map>
+
 namespace Nymph
 {
     KTLOGGER(cutlog, "KTCut");
 
+    namespace
+    {
+        // Lock held while the summary of the given status is changed, since cut results can be added to it from several threads at once;
+        // statuses share a fixed set of locks, so that a data object doesn't need one of its own
+        boost::mutex& SummaryMutex(const KTCutStatus* status)
+        {
+            static const std::size_t sNMutexes = 61;
+            static boost::mutex sMutexes[sNMutexes];
+            return sMutexes[(reinterpret_cast< std::uintptr_t >(status) >> 4) % sNMutexes];
+        }
+    }
+
     KTCutStatus::KTCutStatus() :
             fCutResults(new KTCutResultHandle()),
-            fSummary()
+            fSummary(),
+            fApplied(),
+            fInherited(),
+            fIsInCutFlow(false),
+            fCutFlowGeneration(0)
     {
+        fCutResults->SetIsCopyOnWrite(true);
     }
 
     KTCutStatus::KTCutStatus(const KTCutStatus& orig) :
             fCutResults(dynamic_cast< KTCutResultHandle* >(orig.fCutResults->Clone())),
-            fSummary()
+            fSummary(orig.fSummary),
+            fApplied(orig.fApplied),
+            fInherited(orig.fApplied),
+            fIsInCutFlow(false),
+            fCutFlowGeneration(0)
+    {
+    }
+
+    KTCutStatus::KTCutStatus(KTCutStatus&& orig) :
+            fCutResults(new KTCutResultHandle()),
+            fSummary(orig.fSummary),
+            fApplied(orig.fApplied),
+            fInherited(orig.fInherited),
+            fIsInCutFlow(orig.fIsInCutFlow),
+            fCutFlowGeneration(orig.fCutFlowGeneration)
     {
-        UpdateStatus();
+        fCutResults.swap(orig.fCutResults);
+        orig.fCutResults->SetIsCopyOnWrite(true);
+        orig.fSummary.reset();
+        orig.fApplied.reset();
+        orig.fInherited.reset();
+        orig.fIsInCutFlow = false;
     }
 
     KTCutStatus::~KTCutStatus()
-    {}
+    {
+    }
 
     KTCutStatus& KTCutStatus::operator=(const KTCutStatus& rhs)
     {
+        if (&rhs == this) return *this;
+        // the record of the data object this status held is kept
+        fIsInCutFlow = false;
         fCutResults.reset(dynamic_cast< KTCutResultHandle* >(rhs.fCutResults->Clone()));
-        UpdateStatus();
+        fSummary = rhs.fSummary;
+        fApplied = rhs.fApplied;
+        fInherited = rhs.fApplied;
+        return *this;
+    }
+
+    KTCutStatus& KTCutStatus::operator=(KTCutStatus&& rhs)
+    {
+        if (&rhs == this) return *this;
+        fCutResults.swap(rhs.fCutResults);
+        fSummary = rhs.fSummary;
+        fApplied = rhs.fApplied;
+        fInherited = rhs.fInherited;
+        fIsInCutFlow = rhs.fIsInCutFlow;
+        fCutFlowGeneration = rhs.fCutFlowGeneration;
+        // the cut results that were here are removed with the original's; the original's record now belongs to this status
+        rhs.Reset();
         return *this;
     }
 
     void KTCutStatus::UpdateStatus()
     {
         KTDEBUG(cutlog, "Updating cut summary");
-        KTCutResult* cut = fCutResults.get()->Next(); // skip over KTCutResultHandle
-        if (cut == NULL)
-        {
-            KTDEBUG(cutlog, "No cuts");
-            fSummary.resize(1, false);
-            return;
-        }
-
-        // loop through once to count cuts
-        unsigned nCuts = 0;
+        boost::lock_guard< boost::mutex > lock(SummaryMutex(this));
+        bitset_type prevApplied = fApplied & ~fInherited;
+        bitset_type prevFailed = fSummary & ~fInherited;
+        fSummary.reset();
+        fApplied.reset();
+        const KTCutResult* cut = fCutResults.get()->Next(); // skip over KTCutResultHandle
         while (cut != NULL)
         {
-            ++nCuts;
-            cut = cut->Next();
-        }
-        KTDEBUG(cutlog, nCuts << " cuts");
-        fSummary.resize(nCuts, false);
-        // loop through again to set cuts
-        cut = fCutResults.get()->Next(); // skip over KTCutResultHandle
-        for (unsigned iCut = 0; iCut < nCuts; ++iCut)
-        {
-            fSummary[iCut] = cut->GetState();
+            unsigned bit = cut->GetBit();
+            if (bit != KTCutRegistry::sNoBit)
+            {
+                fSummary.set(bit, cut->GetState());
+                fApplied.set(bit);
+            }
             cut = cut->Next();
         }
+        // rebuilding the summary doesn't make the inherited cuts this status's own
+        fInherited &= fApplied;
+        RecordCutFlow(prevApplied, prevFailed);
         KTDEBUG(cutlog, "Cut summary bitset: " << fSummary);
         return;
     }
@@ -81,7 +139,7 @@ namespace Nymph
             }
             newCut->SetState(state);
 
-            if (doUpdateStatus) UpdateStatus();
+            if (doUpdateStatus) SetSummaryBit(newCut->GetBit(), state);
             return true;
         }
         return false;
@@ -104,17 +162,29 @@ namespace Nymph
 
     const KTCutResult* KTCutStatus::GetCutResult(const std::string& cutName) const
     {
-        const KTCutResult* cut = fCutResults.get()->Next(); // skip over KTCutResultHandle
-        while (cut != NULL)
-        {
-            if (cut->Name() == cutName) return cut;
-            cut = cut->Next();
-        }
-        return NULL;
+        return FindCutResult(cutName);
     }
 
     KTCutResult* KTCutStatus::GetCutResult(const std::string& cutName)
     {
+        KTCutResult* cut = FindCutResult(cutName);
+        if (cut == NULL) return NULL;
+        // a shared cut result is replaced with a private copy before it can be modified
+        return fCutResults->FindPrivate(cut->GetTypeId());
+    }
+
+    KTCutResult* KTCutStatus::FindCutResult(const std::string& cutName) const
+    {
+        KTCutRegistry* registry = KTCutRegistry::get_instance();
+        unsigned bit = registry->GetBit(cutName);
+        if (bit != KTCutRegistry::sNoBit)
+        {
+            // the registry gives the type of the cut result, which is looked up directly
+            KTCutResult* cut = fCutResults->Find(registry->GetTypeId(bit));
+            return cut == fCutResults.get() ? NULL : cut;
+        }
+
+        // cut results that aren't registered yet are found by name
         KTCutResult* cut = fCutResults.get()->Next(); // skip over KTCutResultHandle
         while (cut != NULL)
         {
@@ -134,10 +204,50 @@ namespace Nymph
         }
         cut->SetState(state);
 
-        if (doUpdateStatus) UpdateStatus();
+        if (doUpdateStatus) SetSummaryBit(cut->GetBit(), state);
         return true;
     }
 
+    void KTCutStatus::SetSummaryBit(unsigned bit, bool state)
+    {
+        boost::lock_guard< boost::mutex > lock(SummaryMutex(this));
+        bitset_type prevApplied = fApplied & ~fInherited;
+        bitset_type prevFailed = fSummary & ~fInherited;
+        if (bit != KTCutRegistry::sNoBit)
+        {
+            fSummary.set(bit, state);
+            fApplied.set(bit);
+            fInherited.reset(bit);
+        }
+        RecordCutFlow(prevApplied, prevFailed);
+        return;
+    }
+
+    void KTCutStatus::ClearSummaryBit(unsigned bit)
+    {
+        if (bit == KTCutRegistry::sNoBit) return;
+        boost::lock_guard< boost::mutex > lock(SummaryMutex(this));
+        bitset_type prevApplied = fApplied & ~fInherited;
+        bitset_type prevFailed = fSummary & ~fInherited;
+        fSummary.reset(bit);
+        fApplied.reset(bit);
+        fInherited.reset(bit);
+        // removing a cut doesn't record a status that hasn't been recorded
+        if (fIsInCutFlow) RecordCutFlow(prevApplied, prevFailed);
+        return;
+    }
+
+    void KTCutStatus::Reset()
+    {
+        // the record of the data object this status held is kept
+        fIsInCutFlow = false;
+        fCutResults->Clear();
+        fSummary.reset();
+        fApplied.reset();
+        fInherited.reset();
+        return;
+    }
+
     /*
     void KTCutStatus::RemoveCutResult(const std::string& cutName, bool doUpdateStatus)
     {
@@ -157,16 +267,20 @@ namespace Nymph
 
     std::string KTCutStatus::CutResultsPresent() const
     {
-        KTCutResult* cut = fCutResults.get()->Next(); // skip over KTCutResultHandle
-        if (cut == NULL ) return "";
+        // ordered by bit, highest first (cuts without a bit go first)
+        std::multimap< unsigned, std::string, std::greater< unsigned > > cuts;
+        const KTCutResult* cut = fCutResults.get()->Next(); // skip over KTCutResultHandle
+        while (cut != NULL)
+        {
+            cuts.insert(std::make_pair(cut->GetBit(), cut->Name()));
+            cut = cut->Next();
+        }
 
         std::string cutsPresent;
-        while (true)
+        for (std::multimap< unsigned, std::string, std::greater< unsigned > >::const_iterator it = cuts.begin(); it != cuts.end(); ++it)
         {
-            cutsPresent = cut->Name() + cutsPresent;
-            cut = cut->Next();
-            if (cut != NULL) cutsPresent = " " + cutsPresent;
-            else break;
+            if (! cutsPresent.empty()) cutsPresent += " ";
+            cutsPresent += it->second;
         }
         return cutsPresent;
     }
@@ -186,7 +300,9 @@ namespace Nymph
 
     std::ostream& operator<<(std::ostream& out, const KTCutStatus& status)
     {
-        out << "Cut summary: " << status.fSummary << '\n';
+        // only the bits that have been assigned to cuts are printed
+        std::string summary = status.fSummary.to_string();
+        out << "Cut summary: " << summary.substr(summary.size() - status.size()) << '\n';
         return out;
     }
 
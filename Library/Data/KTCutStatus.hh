@@ -9,11 +9,12 @@
 #define KTCUTSTATUS_HH_
 
 
+#include "KTCutFlow.hh"
 #include "KTCutResult.hh"
 
-#include <boost/dynamic_bitset.hpp>
 #include <boost/scoped_ptr.hpp>
 
+#include <bitset>
 #include <string>
 
 namespace Nymph
@@ -28,7 +29,11 @@ namespace Nymph
      KTCutStatus is typically used as a member variable of KTData, the top-level data object.
 
      KTCutStatus owns the set of cut results that have been added to a data object.
-     It also owns a summary of those cuts (implemented with boost::dynamic_bitset).
+     It also owns a summary of those cuts (implemented with std::bitset).
+
+     Each type of cut result has a fixed bit in the summary, which is assigned by KTCutRegistry when the cut is registered (see KT_REGISTER_CUT),
+     so a given bit refers to the same cut for every data object, regardless of which cuts have been applied to it, or in what order.
+     The summary has room for KTCutRegistry::sMaxCuts cuts; the bits of cuts that haven't been applied to the data object are 0.
 
      You can check if the data has been cut with the IsCut functions.
      - IsCut() returns true if any cut results are true;
@@ -36,7 +41,7 @@ namespace Nymph
        a cut mask, and return true if any of the cut results specified by the mask are true.
 
      When specifying a cut mask, bits set to true specify cuts that should be used:
-     - bitset_type is boost::dynamic_bitset;
+     - bitset_type is std::bitset;
      - unsigned integer masks use the bits of the integer;
      - std::string masks are strings with each character either a 0 or 1.
 
@@ -49,12 +54,29 @@ namespace Nymph
      - Remove a cut result with RemoveCutResult.
 
      For all except KTCutStatus::RemoveCutResult, the cut result can be identified by type or string name.
+     All of the cut results can be removed with Reset.
+
+     Adding, setting, and removing a cut result updates its bit in the summary directly, and looking up a cut result by type or by name
+     doesn't search the cut results.  If doUpdateStatus is false, the summary is not updated; UpdateStatus() brings it up to date,
+     and is also needed after a cut result is modified through the pointer returned by GetCutResult().
+
+     Copies of a KTCutStatus share their cut results (see KTExtensibleStruct, copy-on-write).  Adding a cut result to a copy doesn't copy
+     the shared ones; a shared cut result is only copied (along with those added before it) when it's set, removed, or accessed with the non-const GetCutResult().
+     Moving a KTCutStatus hands its cut results over to the new one without copying them.
+
+     Cut results of different cuts can be added to the same status from several threads at once (e.g. by the slots of a parallel group, see KTSignalData),
+     as long as the cuts are registered (see KTCutRegistry).  Setting and removing cut results, and reading the summary, must not be done while that's happening.
+
+     When the cut flow is enabled (see KTCutFlow), a cut status records which cuts were applied and which failed as soon as cut results are added or set
+     with doUpdateStatus (or it's updated with UpdateStatus()), and records each change to its summary after that, so the cut flow is up to date
+     even while the data object is still alive.  Once it's reset or assigned to, its record is kept, and it's recorded as a new data object if cut results are added again.
+     A copy only records the cuts that were added or set after it was made; the cuts it inherited are recorded with the original.
      */
 
     class KTCutStatus
     {
         public:
-            typedef boost::dynamic_bitset< > bitset_type;
+            typedef std::bitset< KTCutRegistry::sMaxCuts > bitset_type;
 
         private:
             // private class KTCutStatus::KTCutResultHandle
@@ -71,12 +93,17 @@ namespace Nymph
         public:
             KTCutStatus();
             KTCutStatus(const KTCutStatus& orig);
+            /// Takes the cut results of the original, which is left without any
+            KTCutStatus(KTCutStatus&& orig);
             ~KTCutStatus();
 
             KTCutStatus& operator=(const KTCutStatus& rhs);
+            /// Takes the cut results of the original, which is left without any
+            KTCutStatus& operator=(KTCutStatus&& rhs);
 
             const KTCutResult* CutResults() const;
 
+            /// Rebuilds the summary from the cut results
             void UpdateStatus();
 
             template< typename XCutType >
@@ -112,16 +139,38 @@ namespace Nymph
             // cannot currently update by cut name
             //void RemoveCutResult(const std::string& cutName, bool doUpdateStatus=true);
 
+            /// Removes all cut results
+            void Reset();
+
             /// Returns a string with the names of the cuts that are present in bitset order
             std::string CutResultsPresent() const;
 
+            /// Number of bits in the summary that have been assigned to cuts (see KTCutRegistry)
             size_t size() const;
         private:
             friend std::ostream& operator<<(std::ostream& out, const KTCutStatus& status);
 
+            /// Marks the cut as applied, with the given state
+            void SetSummaryBit(unsigned bit, bool state);
+            /// Marks the cut as not applied
+            void ClearSummaryBit(unsigned bit);
+            /// Records a change to the summary from the given applied and failed bits (not including the inherited ones) in the cut flow, if it's enabled;
+            /// must be called with the summary lock held
+            void RecordCutFlow(const bitset_type& prevApplied, const bitset_type& prevFailed);
+            /// Returns the named cut result, or NULL if it isn't present
+            KTCutResult* FindCutResult(const std::string& cutName) const;
+
             boost::scoped_ptr< KTCutResultHandle > fCutResults;
 
             bitset_type fSummary;
+            // bits of the cuts that have been applied
+            bitset_type fApplied;
+            // bits of the cuts that were applied to the status this one was copied from, and haven't been added or set since;
+            // they're recorded with the original, so they're left out when this one is recorded
+            bitset_type fInherited;
+            // true if the status has been recorded in the cut flow since it was made, copied, or reset, in generation fCutFlowGeneration (see KTCutFlow)
+            bool fIsInCutFlow;
+            unsigned fCutFlowGeneration;
 
         public:
             bool IsCut() const;
@@ -132,6 +181,9 @@ namespace Nymph
             bitset_type ToBitset(unsigned long long mask) const;
             bitset_type ToBitset(const std::string& mask) const;
 
+            /// The bit of each cut (see KTCutRegistry) is set if the data is cut by it
+            const bitset_type& GetSummary() const;
+
     };
 
     std::ostream& operator<<(std::ostream& out, const KTCutStatus& status);
@@ -148,7 +200,7 @@ namespace Nymph
         if (! HasCutResult< XCutType >())
         {
             fCutResults.get()->Of< XCutType >().SetState(state);
-            if (doUpdateStatus) UpdateStatus();
+            if (doUpdateStatus) SetSummaryBit(XCutType::Bit(), state);
             return true;
         }
         return false;
@@ -164,8 +216,9 @@ namespace Nymph
     {
         if (! HasCutResult< XCutType >())
         {
-            fCutResults.get()->Of< XCutType >() = cut;
-            if (doUpdateStatus) UpdateStatus();
+            XCutType& newCut = fCutResults.get()->Of< XCutType >();
+            newCut = cut;
+            if (doUpdateStatus) SetSummaryBit(XCutType::Bit(), newCut.GetState());
             return true;
         }
         return false;
@@ -182,7 +235,9 @@ namespace Nymph
     {
         if (HasCutResult< XCutType >())
         {
-            return fCutResults.get()->Of< XCutType >().GetState();
+            // the const Of() doesn't make a private copy of a shared cut result
+            const KTCutResultHandle* cutResults = fCutResults.get();
+            return cutResults->Of< XCutType >().GetState();
         }
         return false;
     }
@@ -192,7 +247,8 @@ namespace Nymph
     {
         if (HasCutResult< XCutType >())
         {
-            return &(fCutResults.get()->Of< XCutType >());
+            const KTCutResultHandle* cutResults = fCutResults.get();
+            return &(cutResults->Of< XCutType >());
         }
         return NULL;
     }
@@ -207,17 +263,46 @@ namespace Nymph
         return NULL;
     }
 
+    template< typename XCutType >
+    bool KTCutStatus::SetCutState(bool state, bool doUpdateStatus)
+    {
+        KTCutResult* cut = GetCutResult< XCutType >();
+        if (cut == NULL)
+        {
+            return false;
+        }
+        cut->SetState(state);
+
+        if (doUpdateStatus) SetSummaryBit(XCutType::Bit(), state);
+        return true;
+    }
+
     template< typename XCutType >
     inline void KTCutStatus::RemoveCutResult(bool doUpdateStatus)
     {
         delete fCutResults.get()->Detatch< XCutType >();
-        if (doUpdateStatus) UpdateStatus();
+        if (doUpdateStatus) ClearSummaryBit(XCutType::Bit());
         return;
     }
 
     inline size_t KTCutStatus::size() const
     {
-        return fSummary.size();
+        return KTCutRegistry::get_instance()->GetNCuts();
+    }
+
+    inline void KTCutStatus::RecordCutFlow(const bitset_type& prevApplied, const bitset_type& prevFailed)
+    {
+        if (! KTCutFlow::GetIsEnabled()) return;
+        unsigned generation = KTCutFlow::GetGeneration();
+        if (fIsInCutFlow && fCutFlowGeneration == generation)
+        {
+            KTCutFlow::Update(prevApplied, prevFailed, fApplied & ~fInherited, fSummary & ~fInherited);
+            return;
+        }
+        KTCutFlow::Record(fApplied & ~fInherited, fSummary & ~fInherited);
+        fIsInCutFlow = true;
+        fCutFlowGeneration = generation;
+        return;
     }
 
     inline bool KTCutStatus::IsCut() const
@@ -242,7 +327,7 @@ namespace Nymph
 
     inline KTCutStatus::bitset_type KTCutStatus::ToBitset(unsigned long long mask) const
     {
-        return bitset_type(fSummary.size(), mask);
+        return bitset_type(mask);
     }
 
     inline KTCutStatus::bitset_type KTCutStatus::ToBitset(const std::string& mask) const
@@ -250,6 +335,11 @@ namespace Nymph
         return bitset_type(mask);
     }
 
+    inline const KTCutStatus::bitset_type& KTCutStatus::GetSummary() const
+    {
+        return fSummary;
+    }
+
 } /* namespace Nymph */
 
 #endif /* KTCUTSTATUS_HH_ */
@@ -15,7 +15,8 @@ namespace Nymph
             KTExtensibleData< KTData >(),
             fCounter(0),
             fLastData(false),
-            fCutStatus()
+            fCutStatus(),
+            fRecycler()
     {
     }
 
@@ -23,10 +24,69 @@ namespace Nymph
             KTExtensibleData< KTData >(orig),
             fCounter(orig.fCounter),
             fLastData(orig.fLastData),
-            fCutStatus(orig.fCutStatus)
+            fCutStatus(orig.fCutStatus),
+            fRecycler()
     {}
 
-    KTData::~KTData()
+    KTData::KTData(KTData&& orig) :
+            KTExtensibleData< KTData >(std::move(orig)),
+            fCounter(orig.fCounter),
+            fLastData(orig.fLastData),
+            fCutStatus(std::move(orig.fCutStatus)),
+            fRecycler()
     {}
 
+    KTData::~KTData()
+    {
+        // the memory owned by the extensions is sampled one last time, so that it's included in the peaks
+        if (KTMemoryAccounting::GetIsEnabled()) UpdateAccounts();
+    }
+
+    KTData& KTData::operator=(const KTData& rhs)
+    {
+        KTExtensibleData< KTData >::operator=(rhs);
+        fCounter = rhs.fCounter;
+        fLastData = rhs.fLastData;
+        fCutStatus = rhs.fCutStatus;
+        return *this;
+    }
+
+    KTData& KTData::operator=(KTData&& rhs)
+    {
+        KTExtensibleData< KTData >::operator=(std::move(rhs));
+        fCounter = rhs.fCounter;
+        fLastData = rhs.fLastData;
+        fCutStatus = std::move(rhs.fCutStatus);
+        return *this;
+    }
+
+    bool KTData::Reset()
+    {
+        fCounter = 0;
+        fLastData = false;
+        fCutStatus.Reset();
+
+        // shared extensions belong to other data objects as well
+        DropShared();
+
+        KTExtensibleStructCore< KTDataCore >* object = this;
+        while (object->Next() != NULL)
+        {
+            KTExtensibleStructCore< KTDataCore >* next = object->Next();
+            if (next->Reset())
+            {
+                object = next;
+                continue;
+            }
+            Unlink(next);
+            delete next;
+        }
+        // once all of the extensions are gone, the arena (if there is one) can be reused
+        KTArena* arena = GetArena();
+        if (arena != NULL && arena->IsUnused()) arena->Reset();
+        // the extensions that were kept may still own memory (e.g. buffers kept for reuse)
+        if (KTMemoryAccounting::GetIsEnabled()) UpdateAccounts();
+        return true;
+    }
+
 } /* namespace Nymph */
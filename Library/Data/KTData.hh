@@ -13,29 +13,62 @@
 #include "KTCutStatus.hh"
 #include "KTMemberVariable.hh"
 
+#include <boost/intrusive_ptr.hpp>
 #include <boost/shared_ptr.hpp>
 
+#include <atomic>
 #include <string>
+#include <vector>
 
 namespace Nymph
 {
+    class KTData;
+    void intrusive_ptr_add_ref(const KTData* data);
+    void intrusive_ptr_release(const KTData* data);
+
     class KTDataCore
     {
         public:
-            KTDataCore() {}
+            KTDataCore() : fNReferences(0) {}
+            /// The reference count is not copied
+            KTDataCore(const KTDataCore&) : fNReferences(0) {}
             virtual ~KTDataCore() {}
 
+            KTDataCore& operator=(const KTDataCore&) {return *this;}
+
             virtual const std::string& Name() const = 0;
 
+            /// Prepares the object to be reused when its data object is recycled (see KTDataPool).
+            /// Extensions that hold large buffers should override this to clear their contents while keeping the buffers, and return true;
+            /// extensions for which it returns false (the default) are removed from the recycled data.
+            virtual bool Reset();
+
+        private:
+            friend void intrusive_ptr_add_ref(const KTData* data);
+            friend void intrusive_ptr_release(const KTData* data);
+
+            // number of KTDataPtrs to this object; only used for KTData
+            mutable std::atomic< unsigned > fNReferences;
+
     };
 
+    inline bool KTDataCore::Reset()
+    {
+        return false;
+    }
+
     template< class XDerivedType >
     class KTExtensibleData : public KTExtensibleStruct< XDerivedType, KTDataCore >
     {
         public:
             KTExtensibleData() {}
+            KTExtensibleData(const KTExtensibleData& orig) : KTExtensibleStruct< XDerivedType, KTDataCore >(orig) {}
+            KTExtensibleData(KTExtensibleData&& orig) : KTExtensibleStruct< XDerivedType, KTDataCore >(std::move(orig)) {}
             virtual ~KTExtensibleData() {}
 
+            KTExtensibleData& operator=(const KTExtensibleData& rhs);
+            KTExtensibleData& operator=(KTExtensibleData&& rhs);
+
             const std::string& Name() const;
 
     };
@@ -46,6 +79,35 @@ namespace Nymph
         return XDerivedType::sName;
     }
 
+    template< class XDerivedType >
+    inline KTExtensibleData< XDerivedType >& KTExtensibleData< XDerivedType >::operator=(const KTExtensibleData& rhs)
+    {
+        KTExtensibleStruct< XDerivedType, KTDataCore >::operator=(rhs);
+        return *this;
+    }
+
+    template< class XDerivedType >
+    inline KTExtensibleData< XDerivedType >& KTExtensibleData< XDerivedType >::operator=(KTExtensibleData&& rhs)
+    {
+        KTExtensibleStruct< XDerivedType, KTDataCore >::operator=(std::move(rhs));
+        return *this;
+    }
+
+
+
+    /// Takes data objects whose last KTDataPtr is gone, instead of them being deleted (e.g. KTDataPool)
+    class KTDataRecycler
+    {
+        public:
+            KTDataRecycler() {}
+            virtual ~KTDataRecycler() {}
+
+            /// Takes ownership of the data object; should either keep it or delete it
+            virtual void Recycle(KTData* data) = 0;
+    };
+
+    typedef boost::shared_ptr< KTDataRecycler > KTDataRecyclerPtr;
+
 
 
     class KTData : public KTExtensibleData< KTData >
@@ -53,18 +115,57 @@ namespace Nymph
         public:
             KTData();
             KTData(const KTData& orig);
+            /// Takes the extensions and cut results of the original without copying them
+            KTData(KTData&& orig);
             ~KTData();
 
+            KTData& operator=(const KTData& rhs);
+            /// Takes the extensions and cut results of the original without copying them
+            KTData& operator=(KTData&& rhs);
+
+            /// Resets the counter, last-data flag, and cut status, resets the extensions, and removes those that can't be reset
+            bool Reset();
+
             MEMBERVARIABLE(unsigned, Counter);
             MEMBERVARIABLE(bool, LastData);
 
             MEMBERVARIABLEREF_NOSET(KTCutStatus, CutStatus);
 
+            /// Recycler that the data object goes to when its last KTDataPtr is gone; it's deleted if there isn't one.
+            /// The recycler isn't copied or moved with the data.
+            MEMBERVARIABLEREF(KTDataRecyclerPtr, Recycler);
+
         public:
             static const std::string sName;
     };
 
-    typedef boost::shared_ptr< KTData > KTDataPtr;
+    /// Reference-counted pointer to a data object; the count is kept in the data object, so no separate allocation is needed
+    typedef boost::intrusive_ptr< KTData > KTDataPtr;
+
+    inline void intrusive_ptr_add_ref(const KTData* data)
+    {
+        data->fNReferences.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    inline void intrusive_ptr_release(const KTData* data)
+    {
+        if (data->fNReferences.fetch_sub(1, std::memory_order_acq_rel) != 1) return;
+
+        KTData* released = const_cast< KTData* >(data);
+        if (released->GetRecycler())
+        {
+            // the recycler is kept alive here in case the data object is deleted
+            KTDataRecyclerPtr recycler(released->GetRecycler());
+            recycler->Recycle(released);
+            return;
+        }
+        delete released;
+        return;
+    }
+
+    /// Contiguous group of data objects passed through a single signal (see KTSignalDataBatch)
+    typedef std::vector< KTDataPtr > KTDataPtrBatch;
 
 } /* namespace Nymph */
 #endif /* KTDATA_HH_ */
@@ -0,0 +1,391 @@
+/*
+ * KTDataBatch.hh
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: nsoblath
+ */
+
+#ifndef KTDATABATCH_HH_
+#define KTDATABATCH_HH_
+
+#include "KTData.hh"
+
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+/**
+ * Creates a field description for KTDataBatch, named FIELD, for the member variable NAME of the data type DATA,
+ * which has type TYPE and is accessed with Get[NAME]() and Set[NAME]() (e.g. a variable created with MEMBERVARIABLE).
+ *
+ * Usage example:
+ *     KTDATAFIELD(KTCounterField, KTData, unsigned, Counter);
+ *
+ * Fields that aren't accessed that way can be described with a struct of the same form:
+ *     struct FIELD
+ *     {
+ *         typedef DATA data_type;
+ *         typedef TYPE value_type;
+ *         static value_type Get(const data_type& data);
+ *         static void Set(data_type& data, const value_type& value);
+ *     };
+ */
+#define KTDATAFIELD(FIELD, DATA, TYPE, NAME) \
+        struct FIELD \
+        { \
+            typedef DATA data_type; \
+            typedef TYPE value_type; \
+            static value_type Get(const data_type& data) {return data.Get##NAME();} \
+            static void Set(data_type& data, const value_type& value) {data.Set##NAME(value); return;} \
+        }
+
+namespace Nymph
+{
+    /// Element type of the column for a field with type XValueType; bool fields are stored as unsigned char, so that the column is a plain array
+    template< typename XValueType >
+    struct KTDataColumnValue
+    {
+        typedef XValueType type;
+    };
+
+    template<>
+    struct KTDataColumnValue< bool >
+    {
+        typedef unsigned char type;
+    };
+
+    /// Position of XField in XFields
+    template< class XField, class... XFields >
+    struct KTDataFieldIndex;
+
+    template< class XField, class... XRest >
+    struct KTDataFieldIndex< XField, XField, XRest... > : std::integral_constant< unsigned, 0 >
+    {};
+
+    template< class XField, class XFirst, class... XRest >
+    struct KTDataFieldIndex< XField, XFirst, XRest... > : std::integral_constant< unsigned, 1 + KTDataFieldIndex< XField, XRest... >::value >
+    {};
+
+
+    /// Recursion over the fields of a KTDataBatch; XIndex is the position of XFirst in the batch
+    template< unsigned XIndex, class... XFields >
+    struct KTDataBatchLink;
+
+    template< unsigned XIndex, class XFirst, class... XRest >
+    struct KTDataBatchLink< XIndex, XFirst, XRest... >
+    {
+        static bool Has(const KTData& data)
+        {
+            return data.Has< typename XFirst::data_type >() && KTDataBatchLink< XIndex + 1, XRest... >::Has(data);
+        }
+
+        template< class XColumns >
+        static void Reserve(XColumns& columns, std::size_t size)
+        {
+            std::get< XIndex >(columns).reserve(size);
+            KTDataBatchLink< XIndex + 1, XRest... >::Reserve(columns, size);
+            return;
+        }
+
+        template< class XColumns >
+        static void Clear(XColumns& columns)
+        {
+            std::get< XIndex >(columns).clear();
+            KTDataBatchLink< XIndex + 1, XRest... >::Clear(columns);
+            return;
+        }
+
+        template< class XColumns >
+        static void Gather(XColumns& columns, const KTData& data)
+        {
+            std::get< XIndex >(columns).push_back(XFirst::Get(data.Of< typename XFirst::data_type >()));
+            KTDataBatchLink< XIndex + 1, XRest... >::Gather(columns, data);
+            return;
+        }
+
+        template< class XColumns >
+        static void Scatter(const XColumns& columns, const KTDataPtrBatch& batch)
+        {
+            KTDataBatchLink< XIndex, XFirst >::ScatterOne(columns, batch);
+            KTDataBatchLink< XIndex + 1, XRest... >::Scatter(columns, batch);
+            return;
+        }
+
+        template< class XColumns >
+        static void ScatterOne(const XColumns& columns, const KTDataPtrBatch& batch)
+        {
+            const typename std::tuple_element< XIndex, XColumns >::type& column = std::get< XIndex >(columns);
+            for (std::size_t iData = 0; iData < batch.size(); ++iData)
+            {
+                XFirst::Set(batch[iData]->Of< typename XFirst::data_type >(), column[iData]);
+            }
+            return;
+        }
+    };
+
+    template< unsigned XIndex >
+    struct KTDataBatchLink< XIndex >
+    {
+        static bool Has(const KTData&)
+        {
+            return true;
+        }
+
+        template< class XColumns >
+        static void Reserve(XColumns&, std::size_t)
+        {
+            return;
+        }
+
+        template< class XColumns >
+        static void Clear(XColumns&)
+        {
+            return;
+        }
+
+        template< class XColumns >
+        static void Gather(XColumns&, const KTData&)
+        {
+            return;
+        }
+
+        template< class XColumns >
+        static void Scatter(const XColumns&, const KTDataPtrBatch&)
+        {
+            return;
+        }
+    };
+
+
+    /*!
+     @class KTDataBatch
+     @author N. S. Oblath
+
+     @brief Gathers fields from the extensions of a group of data objects into contiguous arrays (one per field), and scatters them back.
+
+     @details
+     Looking at one value in each of many data objects means following the extension chain of each of them.
+     KTDataBatch copies the values of selected fields from a batch of data objects into a column (a std::vector) for each field,
+     so that reductions and cuts over the batch are tight loops over arrays that the compiler can vectorize.
+     After the columns are modified, Scatter() writes them back into the data objects.
+
+     Each field is described by a type that gives the data type it belongs to, its value type, and how to get and set it (see KTDATAFIELD):
+         KTDATAFIELD(KTAmplitudeField, KTMyData, double, Amplitude);
+         KTDataBatch< KTCounterField, KTAmplitudeField > columns;
+         columns.Gather(batch);
+         const std::vector< double >& amplitudes = columns.Column< KTAmplitudeField >();
+
+     Data objects that don't have all of the data types used by the fields are left out; the ones that are used are given by Data(),
+     in the same order as the entries of the columns.  Fields of type bool are stored as unsigned char.
+
+     The cut status of each data object is gathered as well: IsCut() holds KTCutStatus::IsCut(mask) for each one, using the mask given by
+     SetCutMask() (all cuts by default).  A cut computed over the columns can be stored in the data objects with ScatterCut().
+    */
+    template< class... XFields >
+    class KTDataBatch
+    {
+        public:
+            typedef std::tuple< std::vector< typename KTDataColumnValue< typename XFields::value_type >::type >... > columns_type;
+
+            /// Column type for XField
+            template< class XField >
+            struct column
+            {
+                typedef typename std::tuple_element< KTDataFieldIndex< XField, XFields... >::value, columns_type >::type type;
+            };
+
+            typedef std::vector< unsigned char > cut_column_type;
+
+            static const unsigned sNFields = sizeof...(XFields);
+
+        public:
+            KTDataBatch();
+            ~KTDataBatch();
+
+            /// Replaces the contents of the batch with the fields of the data objects that have all of them; returns the number of data objects used
+            std::size_t Gather(const KTDataPtrBatch& batch);
+
+            /// Writes all of the columns back into the data objects
+            void Scatter() const;
+            /// Writes the column for XField back into the data objects
+            template< class XField >
+            void Scatter() const;
+
+            /// Sets the result of XCutResult to the corresponding value in isCut (non-zero means cut) for each data object, and updates IsCut()
+            template< class XCutResult >
+            void ScatterCut(const cut_column_type& isCut);
+
+            /// Removes the data objects and the contents of the columns
+            void Clear();
+
+            template< class XField >
+            typename column< XField >::type& Column();
+            template< class XField >
+            const typename column< XField >::type& Column() const;
+
+            /// Whether each data object is cut, according to the cut mask
+            const cut_column_type& IsCut() const;
+
+            /// Cut mask used for IsCut() (see KTCutStatus::IsCut(unsigned long long)); it applies to the next Gather()
+            unsigned long long GetCutMask() const;
+            void SetCutMask(unsigned long long mask);
+
+            /// Data objects that the columns were gathered from
+            const KTDataPtrBatch& Data() const;
+
+            /// Number of data objects in the batch
+            std::size_t size() const;
+            bool empty() const;
+
+            /// Number of data objects left out of the last Gather() because they didn't have all of the fields
+            std::size_t GetNSkipped() const;
+
+        private:
+            KTDataPtrBatch fData;
+            columns_type fColumns;
+            cut_column_type fIsCut;
+            unsigned long long fCutMask;
+            std::size_t fNSkipped;
+    };
+
+
+    template< class... XFields >
+    KTDataBatch< XFields... >::KTDataBatch() :
+            fData(),
+            fColumns(),
+            fIsCut(),
+            fCutMask(~0ull),
+            fNSkipped(0)
+    {
+    }
+
+    template< class... XFields >
+    KTDataBatch< XFields... >::~KTDataBatch()
+    {
+    }
+
+    template< class... XFields >
+    std::size_t KTDataBatch< XFields... >::Gather(const KTDataPtrBatch& batch)
+    {
+        Clear();
+        fData.reserve(batch.size());
+        fIsCut.reserve(batch.size());
+        KTDataBatchLink< 0, XFields... >::Reserve(fColumns, batch.size());
+
+        for (KTDataPtrBatch::const_iterator it = batch.begin(); it != batch.end(); ++it)
+        {
+            const KTData& data = **it;
+            if (! KTDataBatchLink< 0, XFields... >::Has(data))
+            {
+                ++fNSkipped;
+                continue;
+            }
+            fData.push_back(*it);
+            KTDataBatchLink< 0, XFields... >::Gather(fColumns, data);
+            fIsCut.push_back(data.GetCutStatus().IsCut(fCutMask));
+        }
+        return fData.size();
+    }
+
+    template< class... XFields >
+    void KTDataBatch< XFields... >::Scatter() const
+    {
+        KTDataBatchLink< 0, XFields... >::Scatter(fColumns, fData);
+        return;
+    }
+
+    template< class... XFields >
+    template< class XField >
+    void KTDataBatch< XFields... >::Scatter() const
+    {
+        KTDataBatchLink< KTDataFieldIndex< XField, XFields... >::value, XField >::ScatterOne(fColumns, fData);
+        return;
+    }
+
+    template< class... XFields >
+    template< class XCutResult >
+    void KTDataBatch< XFields... >::ScatterCut(const cut_column_type& isCut)
+    {
+        for (std::size_t iData = 0; iData < fData.size() && iData < isCut.size(); ++iData)
+        {
+            KTCutStatus& cutStatus = fData[iData]->GetCutStatus();
+            bool state = isCut[iData] != 0;
+            if (! cutStatus.AddCutResult< XCutResult >(state))
+            {
+                cutStatus.SetCutState< XCutResult >(state);
+            }
+            fIsCut[iData] = cutStatus.IsCut(fCutMask);
+        }
+        return;
+    }
+
+    template< class... XFields >
+    void KTDataBatch< XFields... >::Clear()
+    {
+        fData.clear();
+        KTDataBatchLink< 0, XFields... >::Clear(fColumns);
+        fIsCut.clear();
+        fNSkipped = 0;
+        return;
+    }
+
+    template< class... XFields >
+    template< class XField >
+    inline typename KTDataBatch< XFields... >::template column< XField >::type& KTDataBatch< XFields... >::Column()
+    {
+        return std::get< KTDataFieldIndex< XField, XFields... >::value >(fColumns);
+    }
+
+    template< class... XFields >
+    template< class XField >
+    inline const typename KTDataBatch< XFields... >::template column< XField >::type& KTDataBatch< XFields... >::Column() const
+    {
+        return std::get< KTDataFieldIndex< XField, XFields... >::value >(fColumns);
+    }
+
+    template< class... XFields >
+    inline const typename KTDataBatch< XFields... >::cut_column_type& KTDataBatch< XFields... >::IsCut() const
+    {
+        return fIsCut;
+    }
+
+    template< class... XFields >
+    inline unsigned long long KTDataBatch< XFields... >::GetCutMask() const
+    {
+        return fCutMask;
+    }
+
+    template< class... XFields >
+    inline void KTDataBatch< XFields... >::SetCutMask(unsigned long long mask)
+    {
+        fCutMask = mask;
+        return;
+    }
+
+    template< class... XFields >
+    inline const KTDataPtrBatch& KTDataBatch< XFields... >::Data() const
+    {
+        return fData;
+    }
+
+    template< class... XFields >
+    inline std::size_t KTDataBatch< XFields... >::size() const
+    {
+        return fData.size();
+    }
+
+    template< class... XFields >
+    inline bool KTDataBatch< XFields... >::empty() const
+    {
+        return fData.empty();
+    }
+
+    template< class... XFields >
+    inline std::size_t KTDataBatch< XFields... >::GetNSkipped() const
+    {
+        return fNSkipped;
+    }
+
+} /* namespace Nymph */
+#endif /* KTDATABATCH_HH_ */
@@ -0,0 +1,160 @@
+/*
+ * KTDataPool.cc
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: nsoblath
+ */
+
+#include "KTDataPool.hh"
+
+#include "KTLogger.hh"
+
+#include <boost/thread/locks.hpp>
+
+namespace Nymph
+{
+    KTLOGGER(poollog, "KTDataPool");
+
+    KTDataPool::Store::Store(unsigned capacity) :
+            fCapacity(capacity),
+            fAvailable(),
+            fIsOpen(true),
+            fNCreated(0),
+            fNReused(0),
+            fMutex()
+    {
+        fAvailable.reserve(capacity);
+    }
+
+    KTDataPool::Store::~Store()
+    {
+        for (std::vector< KTData* >::iterator it = fAvailable.begin(); it != fAvailable.end(); ++it)
+        {
+            delete *it;
+        }
+    }
+
+    void KTDataPool::Store::Recycle(KTData* data)
+    {
+        // the data object doesn't keep the store alive while it's in the store
+        data->SetRecycler(KTDataRecyclerPtr());
+
+        bool hasRoom = false;
+        {
+            boost::lock_guard< boost::mutex > lock(fMutex);
+            hasRoom = fIsOpen && fAvailable.size() < fCapacity;
+        }
+        if (! hasRoom)
+        {
+            delete data;
+            return;
+        }
+
+        // reset outside of the lock; it can involve deleting extensions
+        bool isReset = false;
+        try
+        {
+            isReset = data->Reset();
+        }
+        catch (std::exception& e)
+        {
+            KTWARN(poollog, "Exception while resetting a data object; it will not be reused:\n" << e.what());
+        }
+
+        if (isReset)
+        {
+            boost::lock_guard< boost::mutex > lock(fMutex);
+            if (fIsOpen && fAvailable.size() < fCapacity)
+            {
+                fAvailable.push_back(data);
+                return;
+            }
+        }
+        delete data;
+        return;
+    }
+
+    KTDataPool::KTDataPool(unsigned capacity) :
+            fStore(new Store(capacity))
+    {
+    }
+
+    KTDataPool::~KTDataPool()
+    {
+        std::vector< KTData* > available;
+        {
+            boost::lock_guard< boost::mutex > lock(fStore->fMutex);
+            fStore->fIsOpen = false;
+            available.swap(fStore->fAvailable);
+        }
+        for (std::vector< KTData* >::iterator it = available.begin(); it != available.end(); ++it)
+        {
+            delete *it;
+        }
+    }
+
+    KTDataPtr KTDataPool::Get()
+    {
+        KTData* data = NULL;
+        {
+            boost::lock_guard< boost::mutex > lock(fStore->fMutex);
+            if (fStore->fAvailable.empty())
+            {
+                ++fStore->fNCreated;
+            }
+            else
+            {
+                data = fStore->fAvailable.back();
+                fStore->fAvailable.pop_back();
+                ++fStore->fNReused;
+            }
+        }
+        if (data == NULL) data = new KTData();
+        data->SetRecycler(fStore);
+        return KTDataPtr(data);
+    }
+
+    unsigned KTDataPool::GetCapacity() const
+    {
+        boost::lock_guard< boost::mutex > lock(fStore->fMutex);
+        return fStore->fCapacity;
+    }
+
+    void KTDataPool::SetCapacity(unsigned capacity)
+    {
+        std::vector< KTData* > extras;
+        {
+            boost::lock_guard< boost::mutex > lock(fStore->fMutex);
+            fStore->fCapacity = capacity;
+            if (fStore->fAvailable.size() > capacity)
+            {
+                extras.assign(fStore->fAvailable.begin() + capacity, fStore->fAvailable.end());
+                fStore->fAvailable.resize(capacity);
+            }
+        }
+        for (std::vector< KTData* >::iterator it = extras.begin(); it != extras.end(); ++it)
+        {
+            delete *it;
+        }
+        return;
+    }
+
+    unsigned KTDataPool::GetNAvailable() const
+    {
+        boost::lock_guard< boost::mutex > lock(fStore->fMutex);
+        return fStore->fAvailable.size();
+    }
+
+    uint64_t KTDataPool::GetNCreated() const
+    {
+        boost::lock_guard< boost::mutex > lock(fStore->fMutex);
+        return fStore->fNCreated;
+    }
+
+    uint64_t KTDataPool::GetNReused() const
+    {
+        boost::lock_guard< boost::mutex > lock(fStore->fMutex);
+        return fStore->fNReused;
+    }
+
+} /* namespace Nymph */
@@ -0,0 +1,93 @@
+/*
+ * KTDataPool.hh
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: nsoblath
+ */
+
+#ifndef KTDATAPOOL_HH_
+#define KTDATAPOOL_HH_
+
+#include "KTData.hh"
+
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/mutex.hpp>
+
+#include <stdint.h>
+#include <vector>
+
+namespace Nymph
+{
+    /*!
+     @class KTDataPool
+     @author N. S. Oblath
+
+     @brief Recycles data objects, so that they and the buffers in their extensions aren't reallocated for every slice.
+
+     @details
+     Get() returns a KTDataPtr to a data object that's either taken from the pool or newly created.
+     When the last copy of that pointer is gone, the data object is reset (see KTData::Reset()) and returned to the pool,
+     rather than being deleted.  If the pool is already full, or if it has been destroyed, the data object is deleted.
+
+     Extensions are kept with the data object if their Reset() function returns true, so a producer that asks for
+     the same extensions with Of() for every slice gets back the objects (and buffers) that it used before.
+     Extensions that don't override KTDataCore::Reset() are removed when the data object is recycled.
+
+     The pool is set as the recycler of each data object that it hands out (see KTDataRecycler), which is how the data objects get back to it.
+
+     The data objects are reset by whichever thread releases the last pointer; the pool is thread-safe.
+
+     A primary processor can use its own pool with KTPrimaryProcessor::NewData().
+    */
+    class KTDataPool
+    {
+        public:
+            KTDataPool(unsigned capacity = sDefaultCapacity);
+            ~KTDataPool();
+
+        private:
+            KTDataPool(const KTDataPool&);
+            KTDataPool& operator=(const KTDataPool&);
+
+        public:
+            /// Returns a data object from the pool, or a new one if the pool is empty
+            KTDataPtr Get();
+
+            /// Maximum number of data objects kept in the pool
+            unsigned GetCapacity() const;
+            /// Sets the capacity; if there are more objects in the pool than the new capacity, the extras are deleted
+            void SetCapacity(unsigned capacity);
+
+            /// Number of data objects currently in the pool
+            unsigned GetNAvailable() const;
+            /// Number of data objects that have been created by the pool
+            uint64_t GetNCreated() const;
+            /// Number of times a data object has been reused
+            uint64_t GetNReused() const;
+
+            static const unsigned sDefaultCapacity = 16;
+
+        private:
+            // The store is the recycler for the data objects handed out by the pool,
+            // and it outlives the pool if any of them are still in use
+            struct Store : public KTDataRecycler
+            {
+                Store(unsigned capacity);
+                ~Store();
+
+                void Recycle(KTData* data);
+
+                unsigned fCapacity;
+                std::vector< KTData* > fAvailable;
+                bool fIsOpen;
+                uint64_t fNCreated;
+                uint64_t fNReused;
+                mutable boost::mutex fMutex;
+            };
+            typedef boost::shared_ptr< Store > StorePtr;
+
+            StorePtr fStore;
+    };
+
+} /* namespace Nymph */
+#endif /* KTDATAPOOL_HH_ */
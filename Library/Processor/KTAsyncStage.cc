@@ -0,0 +1,138 @@
+/*
+ * KTAsyncStage.cc
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: nsoblath
+ */
+
+#include "KTAsyncStage.hh"
+
+#include "KTLogger.hh"
+
+#include <exception>
+
+namespace Nymph
+{
+    KTLOGGER(asynclog, "KTAsyncStage");
+
+    const unsigned KTAsyncStage::sDefaultQueueDepth;
+
+    KTAsyncStage::KTAsyncStage(const std::string& name, unsigned queueDepth) :
+            fName(name),
+            fQueueDepth(queueDepth == 0 ? 1 : queueDepth),
+            fTasks(),
+            fIsBusy(false),
+            fIsStopping(false),
+            fNTasksCompleted(0),
+            fException(),
+            fMutex(),
+            fNotEmptyCondition(),
+            fNotFullCondition(),
+            fIdleCondition(),
+            fThread()
+    {
+        fThread = boost::thread(&KTAsyncStage::Consume, this);
+        KTDEBUG(asynclog, "Started asynchronous stage <" << fName << "> with queue depth " << fQueueDepth);
+    }
+
+    KTAsyncStage::~KTAsyncStage()
+    {
+        Stop();
+    }
+
+    void KTAsyncStage::Push(const Task& task)
+    {
+        boost::unique_lock< boost::mutex > lock(fMutex);
+        bool isOwnThread = boost::this_thread::get_id() == fThread.get_id();
+        if (fIsStopping && ! isOwnThread)
+        {
+            lock.unlock();
+            task();
+            return;
+        }
+        // the stage's own thread can't wait for room in the queue, since it's the one that would make it
+        while (! isOwnThread && fTasks.size() >= fQueueDepth)
+        {
+            fNotFullCondition.wait(lock);
+        }
+        fTasks.push_back(task);
+        lock.unlock();
+        fNotEmptyCondition.notify_one();
+        return;
+    }
+
+    void KTAsyncStage::Drain()
+    {
+        boost::unique_lock< boost::mutex > lock(fMutex);
+        while (! fTasks.empty() || fIsBusy)
+        {
+            fIdleCondition.wait(lock);
+        }
+        if (fException)
+        {
+            std::exception_ptr exception = fException;
+            fException = std::exception_ptr();
+            lock.unlock();
+            std::rethrow_exception(exception);
+        }
+        return;
+    }
+
+    void KTAsyncStage::Stop()
+    {
+        boost::unique_lock< boost::mutex > lock(fMutex);
+        if (fIsStopping) return;
+        fIsStopping = true;
+        lock.unlock();
+        fNotEmptyCondition.notify_all();
+
+        if (fThread.joinable()) fThread.join();
+        KTDEBUG(asynclog, "Stopped asynchronous stage <" << fName << "> after " << fNTasksCompleted << " tasks");
+        return;
+    }
+
+    void KTAsyncStage::Consume()
+    {
+        boost::unique_lock< boost::mutex > lock(fMutex);
+        while (true)
+        {
+            while (fTasks.empty() && ! fIsStopping)
+            {
+                fNotEmptyCondition.wait(lock);
+            }
+            // remaining tasks are finished before stopping
+            if (fTasks.empty()) break;
+
+            Task task = fTasks.front();
+            fTasks.pop_front();
+            fIsBusy = true;
+            lock.unlock();
+            fNotFullCondition.notify_one();
+
+            std::exception_ptr exception;
+            try
+            {
+                task();
+            }
+            catch (std::exception& e)
+            {
+                KTERROR(asynclog, "Exception caught in asynchronous stage <" << fName << ">:\n" << e.what());
+                exception = std::current_exception();
+            }
+            catch (...)
+            {
+                KTERROR(asynclog, "Unknown exception caught in asynchronous stage <" << fName << ">");
+                exception = std::current_exception();
+            }
+
+            lock.lock();
+            if (exception && ! fException) fException = exception;
+            fIsBusy = false;
+            ++fNTasksCompleted;
+            if (fTasks.empty()) fIdleCondition.notify_all();
+        }
+        fIdleCondition.notify_all();
+        return;
+    }
+
+} /* namespace Nymph */
@@ -0,0 +1,146 @@
+/*
+ * KTAsyncStage.hh
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: nsoblath
+ */
+
+#ifndef KTASYNCSTAGE_HH_
+#define KTASYNCSTAGE_HH_
+
+#include <boost/bind.hpp>
+#include <boost/function.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread.hpp>
+#include <boost/utility.hpp>
+
+#include <deque>
+#include <exception>
+#include <string>
+
+namespace Nymph
+{
+    /*!
+     @class KTAsyncStage
+     @author N. S. Oblath
+
+     @brief A bounded queue of slot calls, and a dedicated thread that executes them in order.
+
+     @details
+     An asynchronous signal-slot connection hands each slot call to a KTAsyncStage instead of executing it on the emitting thread.
+     The emitting thread only blocks if the queue is full.
+
+     The processor toolbox creates one stage per processor that receives asynchronous connections,
+     so that processor's slots always run on a single thread, in the order in which they were queued.
+
+     A task pushed from the stage's own thread (i.e. by another task) is added to the back of the queue like any other,
+     so the order is preserved; it doesn't wait for room in the queue, which would deadlock, so the queue can briefly exceed its depth.
+
+     Exceptions thrown by a task are caught and logged, and the stage carries on with the next task.
+     The first exception is kept, and rethrown by the next call to Drain(), so that the failure is reported to whoever is waiting for the stage.
+
+     The tasks run concurrently with the thread that pushed them, so any data they're given must not be modified by that thread
+     (or anything else) until they're done with it.
+    */
+    class KTAsyncStage : public boost::noncopyable
+    {
+        public:
+            typedef boost::function< void () > Task;
+
+            static const unsigned sDefaultQueueDepth = 1024;
+
+        public:
+            KTAsyncStage(const std::string& name, unsigned queueDepth = sDefaultQueueDepth);
+            ~KTAsyncStage();
+
+            /// Add a task to the queue; blocks while the queue is full
+            void Push(const Task& task);
+
+            /// Blocks until the queue is empty and no task is running.
+            /// If any task has thrown an exception since the last call, the first one is rethrown.
+            void Drain();
+
+            /// Waits for the queued tasks to finish, then stops the consumer thread.
+            /// Tasks pushed after the stage has stopped are executed on the calling thread.
+            void Stop();
+
+            const std::string& GetName() const;
+            unsigned GetQueueDepth() const;
+            unsigned long GetNTasksCompleted() const;
+
+        private:
+            void Consume();
+
+            std::string fName;
+            unsigned fQueueDepth;
+
+            std::deque< Task > fTasks;
+            bool fIsBusy;
+            bool fIsStopping;
+            unsigned long fNTasksCompleted;
+            // first exception thrown by a task since the last Drain()
+            std::exception_ptr fException;
+
+            mutable boost::mutex fMutex;
+            boost::condition_variable fNotEmptyCondition;
+            boost::condition_variable fNotFullCondition;
+            boost::condition_variable fIdleCondition;
+
+            boost::thread fThread;
+    };
+
+    inline const std::string& KTAsyncStage::GetName() const
+    {
+        return fName;
+    }
+
+    inline unsigned KTAsyncStage::GetQueueDepth() const
+    {
+        return fQueueDepth;
+    }
+
+    inline unsigned long KTAsyncStage::GetNTasksCompleted() const
+    {
+        boost::unique_lock< boost::mutex > lock(fMutex);
+        return fNTasksCompleted;
+    }
+
+
+    /*!
+     @class KTAsyncSlotForwarder
+     @author N. S. Oblath
+
+     @brief Function object that is connected to a signal in place of a slot, and queues calls to that slot on a KTAsyncStage.
+
+     @details
+     The arguments are copied into the queued task, so reference arguments refer to the copy when the slot is eventually called.
+     Slot return values are discarded; a default-constructed value is returned to the signal.
+    */
+    template< typename XSignature >
+    class KTAsyncSlotForwarder;
+
+    template< typename XReturn, typename... XArgs >
+    class KTAsyncSlotForwarder< XReturn (XArgs...) >
+    {
+        public:
+            typedef XReturn result_type;
+
+        public:
+            KTAsyncSlotForwarder(const boost::function< XReturn (XArgs...) >& slot, boost::shared_ptr< KTAsyncStage > stage) :
+                    fSlot(slot),
+                    fStage(stage)
+            {}
+
+            XReturn operator()(XArgs... args) const
+            {
+                fStage->Push(boost::bind(fSlot, args...));
+                return XReturn();
+            }
+
+        private:
+            boost::function< XReturn (XArgs...) > fSlot;
+            boost::shared_ptr< KTAsyncStage > fStage;
+    };
+
+} /* namespace Nymph */
+#endif /* KTASYNCSTAGE_HH_ */
@@ -8,10 +8,86 @@
 #ifndef KTCONNECTION_HH_
 #define KTCONNECTION_HH_
 
-#include <boost/signals2.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/weak_ptr.hpp>
 
 namespace Nymph
 {
-    typedef boost::signals2::connection KTConnection;
+    /*!
+     @class KTConnectionTarget
+     @author N. S. Oblath
+
+     @brief Interface for objects (i.e. signals) that slots can be connected to and disconnected from.
+
+     @details
+     Connections are identified by an ID that is unique within a given target.
+    */
+    class KTConnectionTarget
+    {
+        public:
+            KTConnectionTarget() {}
+            virtual ~KTConnectionTarget() {}
+
+            virtual void Disconnect(unsigned long id) = 0;
+            virtual bool IsConnected(unsigned long id) const = 0;
+    };
+
+    /*!
+     @class KTConnection
+     @author N. S. Oblath
+
+     @brief Handle for a single signal-to-slot connection.
+
+     @details
+     The connection only holds a weak reference to the signal, so it's safe to disconnect (or to query)
+     a connection after the signal has been destroyed.
+
+     The lower-case function names match those of boost::signals2::connection, which KTConnection replaces.
+    */
+    class KTConnection
+    {
+        public:
+            KTConnection();
+            KTConnection(const boost::shared_ptr< KTConnectionTarget >& target, unsigned long id);
+
+            /// Removes the slot from the signal; does nothing if the connection is already broken
+            void disconnect();
+
+            /// Returns true if the signal still exists and the slot is still attached to it
+            bool connected() const;
+
+        private:
+            boost::weak_ptr< KTConnectionTarget > fTarget;
+            unsigned long fID;
+    };
+
+    inline KTConnection::KTConnection() :
+            fTarget(),
+            fID(0)
+    {}
+
+    inline KTConnection::KTConnection(const boost::shared_ptr< KTConnectionTarget >& target, unsigned long id) :
+            fTarget(target),
+            fID(id)
+    {}
+
+    inline void KTConnection::disconnect()
+    {
+        boost::shared_ptr< KTConnectionTarget > target = fTarget.lock();
+        if (target)
+        {
+            target->Disconnect(fID);
+        }
+        fTarget.reset();
+        return;
+    }
+
+    inline bool KTConnection::connected() const
+    {
+        boost::shared_ptr< KTConnectionTarget > target = fTarget.lock();
+        if (! target) return false;
+        return target->IsConnected(fID);
+    }
+
 } /* namespace Nymph */
 #endif /* KTCONNECTION_HH_ */
@@ -0,0 +1,65 @@
+/*
+ * KTConnectionStats.cc
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: nsoblath
+ */
+
+#include "KTConnectionStats.hh"
+
+#include <boost/thread/locks.hpp>
+
+namespace Nymph
+{
+    KTConnectionStats::KTConnectionStats(const std::string& name) :
+            fName(name),
+            fLocal(&KTConnectionStats::NoCleanup),
+            fAccumulators(),
+            fMutex()
+    {
+    }
+
+    KTConnectionStats::~KTConnectionStats()
+    {
+        for (std::vector< Accumulator* >::iterator it = fAccumulators.begin(); it != fAccumulators.end(); ++it)
+        {
+            delete *it;
+        }
+    }
+
+    KTConnectionStats::Summary KTConnectionStats::GetSummary() const
+    {
+        Summary summary = {0, 0, 0, 0};
+
+        boost::lock_guard< boost::mutex > lock(fMutex);
+        for (std::vector< Accumulator* >::const_iterator it = fAccumulators.begin(); it != fAccumulators.end(); ++it)
+        {
+            summary.fNCalls += (*it)->fNCalls.load(std::memory_order_relaxed);
+            summary.fNExceptions += (*it)->fNExceptions.load(std::memory_order_relaxed);
+            summary.fTotalTime += (*it)->fTotalTime.load(std::memory_order_relaxed);
+            uint64_t maxTime = (*it)->fMaxTime.load(std::memory_order_relaxed);
+            if (maxTime > summary.fMaxTime) summary.fMaxTime = maxTime;
+        }
+        return summary;
+    }
+
+    KTConnectionStats::Accumulator* KTConnectionStats::CreateAccumulator()
+    {
+        Accumulator* acc = new Accumulator();
+        acc->fNCalls.store(0);
+        acc->fNExceptions.store(0);
+        acc->fTotalTime.store(0);
+        acc->fMaxTime.store(0);
+
+        boost::lock_guard< boost::mutex > lock(fMutex);
+        fAccumulators.push_back(acc);
+        fLocal.reset(acc);
+        return acc;
+    }
+
+    void KTConnectionStats::NoCleanup(Accumulator*)
+    {
+        return;
+    }
+
+} /* namespace Nymph */
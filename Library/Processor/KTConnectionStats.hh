@@ -0,0 +1,179 @@
+/*
+ * KTConnectionStats.hh
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: nsoblath
+ */
+
+#ifndef KTCONNECTIONSTATS_HH_
+#define KTCONNECTIONSTATS_HH_
+
+#include "KTTime.hh"
+
+#include <boost/function.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/tss.hpp>
+#include <boost/utility.hpp>
+
+#include <atomic>
+#include <string>
+#include <vector>
+
+namespace Nymph
+{
+    /*!
+     @class KTConnectionStats
+     @author N. S. Oblath
+
+     @brief Call count, timing, and exception count for a single signal-slot connection.
+
+     @details
+     Each thread that calls the slot records into its own accumulator, so recording a call takes no locks
+     and doesn't contend with other threads.  The per-thread accumulators are combined by GetSummary(),
+     which is meant to be called once the threads calling the slot are done.
+
+     Times are in nanoseconds, measured with the monotonic clock.
+    */
+    class KTConnectionStats : public boost::noncopyable
+    {
+        public:
+            struct Summary
+            {
+                uint64_t fNCalls;
+                uint64_t fNExceptions;
+                uint64_t fTotalTime;
+                uint64_t fMaxTime;
+            };
+
+        public:
+            KTConnectionStats(const std::string& name);
+            ~KTConnectionStats();
+
+            const std::string& GetName() const;
+
+            /// Record one call of the slot that took time (ns); threw should be true if the slot exited with an exception
+            void Record(uint64_t time, bool threw);
+
+            /// Combines the accumulators of all threads
+            Summary GetSummary() const;
+
+            /// Records the time from its construction to its destruction as one call
+            class Timer : public boost::noncopyable
+            {
+                public:
+                    Timer(KTConnectionStats& stats);
+                    ~Timer();
+
+                    void SetThrew();
+
+                private:
+                    KTConnectionStats& fStats;
+                    timespec fStart;
+                    bool fThrew;
+            };
+
+        private:
+            // Each accumulator is only written by its own thread; the members are atomic so that GetSummary() can read them safely
+            struct Accumulator
+            {
+                std::atomic< uint64_t > fNCalls;
+                std::atomic< uint64_t > fNExceptions;
+                std::atomic< uint64_t > fTotalTime;
+                std::atomic< uint64_t > fMaxTime;
+            };
+
+            Accumulator* CreateAccumulator();
+            // the accumulators are owned by fAccumulators, not by the thread-specific pointer
+            static void NoCleanup(Accumulator*);
+
+            std::string fName;
+            boost::thread_specific_ptr< Accumulator > fLocal;
+            std::vector< Accumulator* > fAccumulators;
+            mutable boost::mutex fMutex;
+    };
+
+    inline const std::string& KTConnectionStats::GetName() const
+    {
+        return fName;
+    }
+
+    inline void KTConnectionStats::Record(uint64_t time, bool threw)
+    {
+        Accumulator* acc = fLocal.get();
+        if (acc == NULL) acc = CreateAccumulator();
+        acc->fNCalls.store(acc->fNCalls.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        acc->fTotalTime.store(acc->fTotalTime.load(std::memory_order_relaxed) + time, std::memory_order_relaxed);
+        if (time > acc->fMaxTime.load(std::memory_order_relaxed)) acc->fMaxTime.store(time, std::memory_order_relaxed);
+        if (threw) acc->fNExceptions.store(acc->fNExceptions.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        return;
+    }
+
+    inline KTConnectionStats::Timer::Timer(KTConnectionStats& stats) :
+            fStats(stats),
+            fStart(),
+            fThrew(false)
+    {
+        GetTimeMonotonic(&fStart);
+    }
+
+    inline KTConnectionStats::Timer::~Timer()
+    {
+        timespec end;
+        GetTimeMonotonic(&end);
+        fStats.Record(TimeToNSec(end) - TimeToNSec(fStart), fThrew);
+    }
+
+    inline void KTConnectionStats::Timer::SetThrew()
+    {
+        fThrew = true;
+        return;
+    }
+
+
+    /*!
+     @class KTProfiledSlotForwarder
+     @author N. S. Oblath
+
+     @brief Function object that is connected to a signal in place of a slot, and records each call of that slot in a KTConnectionStats.
+
+     @details
+     Exceptions thrown by the slot are counted and rethrown.
+     The forwarder is only used for connections that are being profiled, so connections that aren't profiled pay nothing.
+    */
+    template< typename XSignature >
+    class KTProfiledSlotForwarder;
+
+    template< typename XReturn, typename... XArgs >
+    class KTProfiledSlotForwarder< XReturn (XArgs...) >
+    {
+        public:
+            typedef XReturn result_type;
+
+        public:
+            KTProfiledSlotForwarder(const boost::function< XReturn (XArgs...) >& slot, boost::shared_ptr< KTConnectionStats > stats) :
+                    fSlot(slot),
+                    fStats(stats)
+            {}
+
+            XReturn operator()(XArgs... args) const
+            {
+                KTConnectionStats::Timer timer(*fStats);
+                try
+                {
+                    return fSlot(args...);
+                }
+                catch (...)
+                {
+                    timer.SetThrew();
+                    throw;
+                }
+            }
+
+        private:
+            boost::function< XReturn (XArgs...) > fSlot;
+            boost::shared_ptr< KTConnectionStats > fStats;
+    };
+
+} /* namespace Nymph */
+#endif /* KTCONNECTIONSTATS_HH_ */
@@ -0,0 +1,67 @@
+/*
+ * KTDataPredicate.cc
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: nsoblath
+ */
+
+#include "KTDataPredicate.hh"
+
+namespace Nymph
+{
+    KTRequireDataNamed::KTRequireDataNamed(const std::string& name) :
+            fName(name)
+    {
+    }
+
+
+    KTRequirePassCuts::KTRequirePassCuts() :
+            fCutMask(),
+            fAllBits(true)
+    {
+    }
+
+    void KTRequirePassCuts::SetCutMask(const KTCutStatus::bitset_type& mask)
+    {
+        fCutMask = mask;
+        fAllBits = false;
+        return;
+    }
+
+    void KTRequirePassCuts::SetCutMask(unsigned long long mask)
+    {
+        SetCutMask(KTCutStatus::bitset_type(mask));
+        return;
+    }
+
+    void KTRequirePassCuts::SetCutMask(const std::string& mask)
+    {
+        SetCutMask(KTCutStatus::bitset_type(mask));
+        return;
+    }
+
+    void KTRequirePassCuts::SetCutMaskAll()
+    {
+        fCutMask.reset();
+        fAllBits = true;
+        return;
+    }
+
+    bool KTRequirePassCuts::operator()(const KTData& data) const
+    {
+        const KTCutStatus& cutStatus = data.GetCutStatus();
+        if (fAllBits)
+        {
+            return ! cutStatus.IsCut();
+        }
+        return ! cutStatus.IsCut(fCutMask);
+    }
+
+
+    KTRequireBoth::KTRequireBoth(const KTDataPredicate& first, const KTDataPredicate& second) :
+            fFirst(first),
+            fSecond(second)
+    {
+    }
+
+} /* namespace Nymph */
@@ -0,0 +1,170 @@
+/*
+ * KTDataPredicate.hh
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: nsoblath
+ */
+
+#ifndef KTDATAPREDICATE_HH_
+#define KTDATAPREDICATE_HH_
+
+#include "KTData.hh"
+
+#include <boost/function.hpp>
+
+#include <string>
+
+namespace Nymph
+{
+    /*!
+     @typedef KTDataPredicate
+
+     @brief Condition that data must meet to be passed through a filtered connection.
+
+     @details
+     A predicate can be given when a data slot is connected to a signal (see KTProcessor::ConnectASlot()).
+     It is evaluated in the signal's dispatch loop, before the slot is called; data for which it returns false never reaches the slot.
+     This replaces the extra processor (e.g. a KTCutFilter) and signal emission otherwise needed to select data for a slot,
+     and means a slot that requires a particular data type is not called (and doesn't complain) when that type is missing.
+
+     Predicates can only be used with slots that take a KTDataPtr.
+
+     Predicates provided here:
+     - KTRequireData< XDataType >: the data must have type XDataType;
+     - KTRequireDataNamed: the data must have a type with the given name (i.e. the type's sName);
+     - KTRequirePassCuts: the data must not be cut by any of the cuts selected by a cut mask (as in KTCutFilter);
+     - KTRequireBoth: both of two predicates must be true.
+    */
+    typedef boost::function< bool (const KTData&) > KTDataPredicate;
+
+
+    template< class XDataType >
+    struct KTRequireData
+    {
+        bool operator()(const KTData& data) const
+        {
+            return data.Has< XDataType >();
+        }
+    };
+
+
+    class KTRequireDataNamed
+    {
+        public:
+            KTRequireDataNamed(const std::string& name);
+
+            bool operator()(const KTData& data) const;
+
+        private:
+            std::string fName;
+    };
+
+
+    /// The mask is interpreted as in KTCutFilter; the default mask uses all cuts
+    class KTRequirePassCuts
+    {
+        public:
+            KTRequirePassCuts();
+
+            void SetCutMask(const KTCutStatus::bitset_type& mask);
+            void SetCutMask(unsigned long long mask);
+            /// Set the mask with a string; String must consist of all 0's and 1's.
+            void SetCutMask(const std::string& mask);
+
+            /// Set the cut mask to use all cuts
+            void SetCutMaskAll();
+
+            bool operator()(const KTData& data) const;
+
+        private:
+            KTCutStatus::bitset_type fCutMask;
+            bool fAllBits;
+    };
+
+
+    class KTRequireBoth
+    {
+        public:
+            KTRequireBoth(const KTDataPredicate& first, const KTDataPredicate& second);
+
+            bool operator()(const KTData& data) const;
+
+        private:
+            KTDataPredicate fFirst;
+            KTDataPredicate fSecond;
+    };
+
+
+    /*!
+     @class KTFilteredSlotForwarder
+     @author N. S. Oblath
+
+     @brief Function object that is connected to a signal in place of a data slot, and only calls the slot if the data satisfies a predicate.
+
+     @details
+     Only defined for the data-slot signatures, void (const KTDataPtr&) and void (KTDataPtr&).
+     Use KTFilterSlot() to wrap a slot of arbitrary signature.
+    */
+    template< typename XSignature >
+    class KTFilteredSlotForwarder;
+
+    template< typename XDataPtr >
+    class KTFilteredSlotForwarder< void (XDataPtr&) >
+    {
+        public:
+            typedef void result_type;
+
+        public:
+            KTFilteredSlotForwarder(const boost::function< void (XDataPtr&) >& slot, const KTDataPredicate& predicate) :
+                    fSlot(slot),
+                    fPredicate(predicate)
+            {}
+
+            void operator()(XDataPtr& data) const
+            {
+                if (fPredicate(*data)) fSlot(data);
+                return;
+            }
+
+        private:
+            boost::function< void (XDataPtr&) > fSlot;
+            KTDataPredicate fPredicate;
+    };
+
+    /// Wraps the slot so that it is only called for data that satisfies the predicate.
+    /// Returns false, and leaves the slot unchanged, if the slot doesn't take a KTDataPtr.
+    template< typename XSignature >
+    bool KTFilterSlot(boost::function< XSignature >&, const KTDataPredicate&)
+    {
+        return false;
+    }
+
+    inline bool KTFilterSlot(boost::function< void (const KTDataPtr&) >& slot, const KTDataPredicate& predicate)
+    {
+        slot = KTFilteredSlotForwarder< void (const KTDataPtr&) >(slot, predicate);
+        return true;
+    }
+
+    inline bool KTFilterSlot(boost::function< void (KTDataPtr&) >& slot, const KTDataPredicate& predicate)
+    {
+        slot = KTFilteredSlotForwarder< void (KTDataPtr&) >(slot, predicate);
+        return true;
+    }
+
+
+    inline bool KTRequireDataNamed::operator()(const KTData& data) const
+    {
+        for (const KTExtensibleStructCore< KTDataCore >* ext = &data; ext != NULL; ext = ext->Next())
+        {
+            if (ext->Name() == fName) return true;
+        }
+        return false;
+    }
+
+    inline bool KTRequireBoth::operator()(const KTData& data) const
+    {
+        return fFirst(data) && fSecond(data);
+    }
+
+} /* namespace Nymph */
+#endif /* KTDATAPREDICATE_HH_ */
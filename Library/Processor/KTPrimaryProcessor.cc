@@ -14,7 +14,8 @@ namespace Nymph
     KTLOGGER(proclog, "KTPrimaryProcessor");
 
     KTPrimaryProcessor::KTPrimaryProcessor(const std::string& name) :
-            KTProcessor(name)
+            KTProcessor(name),
+            fDataPool()
     {
     }
 
@@ -10,6 +10,7 @@
 
 #include "KTProcessor.hh"
 
+#include "KTDataPool.hh"
 #include "KTLogger.hh"
 
 namespace Nymph
@@ -29,7 +30,27 @@ namespace Nymph
             /// Starts the  main action of the processor
             virtual bool Run() = 0;
 
+        public:
+            /// Pool from which NewData() draws data objects
+            KTDataPool& GetDataPool();
+
+        protected:
+            /// Returns a data object to be filled and emitted; data objects are recycled through the processor's data pool
+            KTDataPtr NewData();
+
+            KTDataPool fDataPool;
+
     };
 
+    inline KTDataPool& KTPrimaryProcessor::GetDataPool()
+    {
+        return fDataPool;
+    }
+
+    inline KTDataPtr KTPrimaryProcessor::NewData()
+    {
+        return fDataPool.Get();
+    }
+
 } /* namespace Nymph */
 #endif /* KTPRIMARYPROCESSOR_HH_ */
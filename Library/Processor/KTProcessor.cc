@@ -44,14 +44,14 @@ namespace Nymph
         }
     }
 
-    void KTProcessor::ConnectASlot(const std::string& signalName, KTProcessor* processor, const std::string& slotName, int groupNum)
+    void KTProcessor::ConnectASlot(const std::string& signalName, KTProcessor* processor, const std::string& slotName, int groupNum, boost::shared_ptr< KTConnectionStats > stats, const KTDataPredicate& predicate)
     {
         KTSignalWrapper* signal = GetSignal(signalName);
         KTSlotWrapper* slot = processor->GetSlot(slotName);
 
         try
         {
-            ConnectSignalToSlot(signal, slot, groupNum);
+            ConnectSignalToSlot(signal, slot, groupNum, boost::shared_ptr< KTAsyncStage >(), stats, predicate);
         }
         catch (std::exception& e)
         {
@@ -88,7 +88,34 @@ namespace Nymph
         return;
     }
 
-    void KTProcessor::ConnectSignalToSlot(KTSignalWrapper* signal, KTSlotWrapper* slot, int groupNum)
+    void KTProcessor::ConnectASlotAsync(const std::string& signalName, KTProcessor* processor, const std::string& slotName, boost::shared_ptr< KTAsyncStage > stage, int groupNum, boost::shared_ptr< KTConnectionStats > stats, const KTDataPredicate& predicate)
+    {
+        KTSignalWrapper* signal = GetSignal(signalName);
+        KTSlotWrapper* slot = processor->GetSlot(slotName);
+
+        try
+        {
+            if (! stage)
+            {
+                throw ProcessorException("Asynchronous stage pointer was NULL");
+            }
+            ConnectSignalToSlot(signal, slot, groupNum, stage, stats, predicate);
+        }
+        catch (std::exception& e)
+        {
+            string errorMsg = string("Exception caught in KTProcessor::ConnectASlotAsync; signal: ") +
+                    signalName + string(", slot: ") + slotName + string("\n") + e.what() + string("\n") +
+                    string("\tIf the signal wrapper cannot be cast correctly, check that the signatures of the signal and slot match exactly.\n") +
+                    string("\tIf the signal pointer is NULL, you may have the signal name wrong.\n") +
+                    string("\tIf the slot pointer is NULL, you may have the slot name wrong.");
+            throw std::logic_error(errorMsg);
+        }
+        KTDEBUG(processorlog, "Connected signal <" << signalName << "> to slot <" << slotName << "> asynchronously, via stage <" << stage->GetName() << ">");
+
+        return;
+    }
+
+    void KTProcessor::ConnectSignalToSlot(KTSignalWrapper* signal, KTSlotWrapper* slot, int groupNum, boost::shared_ptr< KTAsyncStage > stage, boost::shared_ptr< KTConnectionStats > stats, const KTDataPredicate& predicate)
     {
         if (signal == NULL)
         {
@@ -99,7 +126,7 @@ namespace Nymph
             throw ProcessorException("Slot pointer was NULL");
         }
 
-        slot->SetConnection(signal, groupNum);
+        slot->SetConnection(signal, groupNum, stage, stats, predicate);
 
         return;
     }
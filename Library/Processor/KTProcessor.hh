@@ -20,7 +20,6 @@
 
 #include <boost/bind.hpp>
 #include <boost/function.hpp>
-#include <boost/signals2.hpp>
 
 #include <exception>
 #include <map>
@@ -54,9 +53,13 @@ namespace Nymph
 
         public:
 
-            void ConnectASlot(const std::string& signalName, KTProcessor* processor, const std::string& slotName, int groupNum=-1);
+            /// If stats is given, each call to the slot is recorded in it (see KTConnectionStats)
+            /// If predicate is given, the slot is only called for data that satisfy it (see KTDataPredicate); the slot must take a KTDataPtr
+            void ConnectASlot(const std::string& signalName, KTProcessor* processor, const std::string& slotName, int groupNum=-1, boost::shared_ptr< KTConnectionStats > stats=boost::shared_ptr< KTConnectionStats >(), const KTDataPredicate& predicate=KTDataPredicate());
             void ConnectASignal(KTProcessor* processor, const std::string& signalName, const std::string& slotName, int groupNum=-1);
-            void ConnectSignalToSlot(KTSignalWrapper* signal, KTSlotWrapper* slot, int groupNum=-1);
+            /// Connect a slot that is called asynchronously: calls are queued on stage and executed by the stage's thread
+            void ConnectASlotAsync(const std::string& signalName, KTProcessor* processor, const std::string& slotName, boost::shared_ptr< KTAsyncStage > stage, int groupNum=-1, boost::shared_ptr< KTConnectionStats > stats=boost::shared_ptr< KTConnectionStats >(), const KTDataPredicate& predicate=KTDataPredicate());
+            void ConnectSignalToSlot(KTSignalWrapper* signal, KTSlotWrapper* slot, int groupNum=-1, boost::shared_ptr< KTAsyncStage > stage=boost::shared_ptr< KTAsyncStage >(), boost::shared_ptr< KTConnectionStats > stats=boost::shared_ptr< KTConnectionStats >(), const KTDataPredicate& predicate=KTDataPredicate());
 
             template< class XProcessor >
             void RegisterSignal(std::string name, XProcessor* signalPtr);
@@ -70,9 +73,9 @@ namespace Nymph
             template< class XTarget, typename XReturn, typename XArg1, typename XArg2 >
             void RegisterSlot(std::string name, XTarget* target, XReturn (XTarget::* funcPtr)(XArg1, XArg2));
 
-            KTSignalWrapper* GetSignal(const std::string& name);
+            virtual KTSignalWrapper* GetSignal(const std::string& name);
 
-            KTSlotWrapper* GetSlot(const std::string& name);
+            virtual KTSlotWrapper* GetSlot(const std::string& name);
 
         protected:
 
@@ -111,9 +114,10 @@ namespace Nymph
     {
         KTDEBUG(processorlog, "Registering slot <" << name << "> in processor <" << fConfigName << ">");
 
-        KTSignalConcept< XReturn (XArg1) > signalConcept;
+        typedef XReturn (Signature)(typename KTSlotArgument< XArg1 >::type);
+        KTSignalConcept< Signature > signalConcept;
 
-        boost::function< XReturn (XArg1) > *func = new boost::function< XReturn (XArg1) >(boost::bind(funcPtr, target, _1));
+        boost::function< Signature > *func = new boost::function< Signature >(boost::bind(funcPtr, target, _1));
 
         KTSlotWrapper* slot = new KTSlotWrapper(func, &signalConcept);
         fSlotMap.insert(SlotMapVal(name, slot));
@@ -125,9 +129,10 @@ namespace Nymph
     {
         KTDEBUG(processorlog, "Registering slot <" << name << "> in processor <" << fConfigName << ">");
 
-        KTSignalConcept< XReturn (XArg1, XArg2) > signalConcept;
+        typedef XReturn (Signature)(typename KTSlotArgument< XArg1 >::type, typename KTSlotArgument< XArg2 >::type);
+        KTSignalConcept< Signature > signalConcept;
 
-        boost::function< XReturn (XArg1, XArg2) > *func = new boost::function< XReturn (XArg1, XArg2) >(boost::bind(funcPtr, target, _1, _2));
+        boost::function< Signature > *func = new boost::function< Signature >(boost::bind(funcPtr, target, _1, _2));
 
         KTSlotWrapper* slot = new KTSlotWrapper(func, &signalConcept);
         fSlotMap.insert(SlotMapVal(name, slot));
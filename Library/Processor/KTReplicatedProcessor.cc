@@ -0,0 +1,316 @@
+/*
+ * KTReplicatedProcessor.cc
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: nsoblath
+ */
+
+#include "KTReplicatedProcessor.hh"
+
+#include "KTLogger.hh"
+#include "KTSignal.hh"
+
+#include <boost/thread/locks.hpp>
+
+#include <exception>
+#include <sstream>
+
+namespace Nymph
+{
+    KTLOGGER(replog, "KTReplicatedProcessor");
+
+    KTReplicatedProcessor::KTReplicatedProcessor(const std::string& name, const std::vector< KTProcessor* >& replicas, unsigned queueDepth) :
+            KTProcessor(name),
+            fReplicas(replicas),
+            fStages(),
+            fShardKey(&KTReplicatedProcessor::ShardByCounter),
+            fRoutes(),
+            fOutputs(),
+            fReplicaStates(replicas.size()),
+            fPending(),
+            fNextInput(0),
+            fNextOutput(0),
+            fIsEmitting(false),
+            fMergeMutex()
+    {
+        for (unsigned iReplica = 0; iReplica < fReplicas.size(); ++iReplica)
+        {
+            std::stringstream stageName;
+            stageName << name << "[" << iReplica << "]";
+            fStages.push_back(boost::shared_ptr< KTAsyncStage >(new KTAsyncStage(stageName.str(), queueDepth)));
+            fReplicaStates[iReplica].fInput = 0;
+            fReplicaStates[iReplica].fIsRunning = false;
+        }
+    }
+
+    KTReplicatedProcessor::~KTReplicatedProcessor()
+    {
+        // the stage threads call into the replicas, so they have to be stopped first
+        for (std::vector< boost::shared_ptr< KTAsyncStage > >::iterator it = fStages.begin(); it != fStages.end(); ++it)
+        {
+            (*it)->Stop();
+        }
+        for (std::vector< KTProcessor* >::iterator it = fReplicas.begin(); it != fReplicas.end(); ++it)
+        {
+            delete *it;
+        }
+        for (std::vector< Route >::iterator it = fRoutes.begin(); it != fRoutes.end(); ++it)
+        {
+            for (unsigned iReplica = 0; iReplica < it->fSignals.size(); ++iReplica)
+            {
+                delete it->fSignalWrappers[2*iReplica];
+                delete it->fSignalWrappers[2*iReplica + 1];
+                delete it->fSignals[iReplica];
+            }
+        }
+        for (std::vector< Output >::iterator it = fOutputs.begin(); it != fOutputs.end(); ++it)
+        {
+            for (std::vector< KTSlotWrapper* >::iterator collIt = it->fCollectors.begin(); collIt != it->fCollectors.end(); ++collIt)
+            {
+                delete *collIt;
+            }
+            // the wrappers registered for the signal are deleted by KTProcessor
+            delete it->fSignal;
+        }
+    }
+
+    bool KTReplicatedProcessor::Configure(const scarab::param_node& node)
+    {
+        for (std::vector< KTProcessor* >::iterator it = fReplicas.begin(); it != fReplicas.end(); ++it)
+        {
+            if (! (*it)->Configure(node))
+            {
+                KTERROR(replog, "Unable to configure a replica of processor <" << GetConfigName() << ">");
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void KTReplicatedProcessor::Drain()
+    {
+        // all of the replicas are drained even if one has failed; the first failure is then rethrown
+        std::exception_ptr exception;
+        for (std::vector< boost::shared_ptr< KTAsyncStage > >::iterator it = fStages.begin(); it != fStages.end(); ++it)
+        {
+            try
+            {
+                (*it)->Drain();
+            }
+            catch (...)
+            {
+                if (! exception) exception = std::current_exception();
+            }
+        }
+        if (exception) std::rethrow_exception(exception);
+        return;
+    }
+
+    KTSlotWrapper* KTReplicatedProcessor::GetSlot(const std::string& name)
+    {
+        if (fSlotMap.find(name) == fSlotMap.end() && ! AddRoute(name))
+        {
+            return NULL;
+        }
+        return KTProcessor::GetSlot(name);
+    }
+
+    KTSignalWrapper* KTReplicatedProcessor::GetSignal(const std::string& name)
+    {
+        if (fSignalMap.find(name) == fSignalMap.end())
+        {
+            // KTSignalData registers ref-[name] along with [name]
+            if (! AddOutput(name.compare(0, 4, "ref-") == 0 ? name.substr(4) : name))
+            {
+                return NULL;
+            }
+        }
+        return KTProcessor::GetSignal(name);
+    }
+
+    bool KTReplicatedProcessor::AddRoute(const std::string& slotName)
+    {
+        if (fReplicas.empty()) return false;
+
+        typedef void (Signature)(const KTDataPtr&);
+        typedef void (RefSignature)(KTDataPtr&);
+
+        Route route;
+        for (unsigned iReplica = 0; iReplica < fReplicas.size(); ++iReplica)
+        {
+            KTSignalData* signal = new KTSignalData();
+            route.fSignals.push_back(signal);
+            route.fSignalWrappers.push_back(new KTSignalWrapper(static_cast< KTSignalConnector< Signature >* >(signal)));
+            route.fSignalWrappers.push_back(new KTSignalWrapper(static_cast< KTSignalConnector< RefSignature >* >(signal)));
+
+            KTSlotWrapper* replicaSlot = fReplicas[iReplica]->GetSlot(slotName);
+            bool isConnected = false;
+            for (unsigned iWrapper = 2*iReplica; iWrapper < 2*iReplica + 2 && ! isConnected; ++iWrapper)
+            {
+                try
+                {
+                    ConnectSignalToSlot(route.fSignalWrappers[iWrapper], replicaSlot);
+                    isConnected = true;
+                }
+                catch (std::exception& e)
+                {
+                    KTDEBUG(replog, "Unable to connect to slot <" << slotName << "> of a replica of processor <" << GetConfigName() << ">:\n" << e.what());
+                }
+            }
+            if (! isConnected)
+            {
+                KTERROR(replog, "Processor <" << GetConfigName() << "> does not have a data slot called <" << slotName << ">");
+                for (unsigned iToDelete = 0; iToDelete < route.fSignals.size(); ++iToDelete)
+                {
+                    if (iToDelete < iReplica) fReplicas[iToDelete]->GetSlot(slotName)->Disconnect();
+                    delete route.fSignalWrappers[2*iToDelete];
+                    delete route.fSignalWrappers[2*iToDelete + 1];
+                    delete route.fSignals[iToDelete];
+                }
+                return false;
+            }
+        }
+        fRoutes.push_back(route);
+
+        KTDEBUG(processorlog, "Registering slot <" << slotName << "> in processor <" << fConfigName << ">");
+        KTSignalConcept< Signature > signalConcept;
+        boost::function< Signature >* func = new boost::function< Signature >(boost::bind(&KTReplicatedProcessor::RouteData, this, fRoutes.size() - 1, _1));
+        fSlotMap.insert(SlotMapVal(slotName, new KTSlotWrapper(func, &signalConcept)));
+        return true;
+    }
+
+    bool KTReplicatedProcessor::AddOutput(const std::string& signalName)
+    {
+        if (fReplicas.empty()) return false;
+
+        typedef void (Signature)(const KTDataPtr&);
+        KTSignalConcept< Signature > signalConcept;
+
+        Output output;
+        for (unsigned iReplica = 0; iReplica < fReplicas.size(); ++iReplica)
+        {
+            boost::function< Signature >* func = new boost::function< Signature >(boost::bind(&KTReplicatedProcessor::CollectOutput, this, fOutputs.size(), iReplica, _1));
+            output.fCollectors.push_back(new KTSlotWrapper(func, &signalConcept));
+            try
+            {
+                ConnectSignalToSlot(fReplicas[iReplica]->GetSignal(signalName), output.fCollectors.back());
+            }
+            catch (std::exception& e)
+            {
+                KTDEBUG(replog, "Unable to connect to signal <" << signalName << "> of a replica of processor <" << GetConfigName() << ">:\n" << e.what());
+                KTERROR(replog, "Processor <" << GetConfigName() << "> does not have a data signal called <" << signalName << ">");
+                for (std::vector< KTSlotWrapper* >::iterator it = output.fCollectors.begin(); it != output.fCollectors.end(); ++it)
+                {
+                    delete *it;
+                }
+                return false;
+            }
+        }
+        output.fSignal = new KTSignalData(signalName, this);
+        fOutputs.push_back(output);
+        return true;
+    }
+
+    void KTReplicatedProcessor::RouteData(unsigned iRoute, const KTDataPtr& data)
+    {
+        uint64_t input = 0;
+        {
+            boost::lock_guard< boost::mutex > lock(fMergeMutex);
+            input = fNextInput++;
+        }
+        unsigned iReplica = (fShardKey ? fShardKey(*data) : input) % fReplicas.size();
+        fStages[iReplica]->Push(boost::bind(&KTReplicatedProcessor::RunReplica, this, iReplica, iRoute, input, data));
+        return;
+    }
+
+    void KTReplicatedProcessor::RunReplica(unsigned iReplica, unsigned iRoute, uint64_t input, KTDataPtr data)
+    {
+        fReplicaStates[iReplica].fInput = input;
+        fReplicaStates[iReplica].fIsRunning = true;
+        // the output is emitted whether or not the slot succeeds; the slot's exception takes precedence over one from the output
+        std::exception_ptr exception;
+        try
+        {
+            (*fRoutes[iRoute].fSignals[iReplica])(data);
+        }
+        catch (...)
+        {
+            exception = std::current_exception();
+        }
+        try
+        {
+            FinishInput(iReplica, input);
+        }
+        catch (std::exception& e)
+        {
+            if (! exception) exception = std::current_exception();
+            else KTERROR(replog, "Exception caught while emitting the output of processor <" << GetConfigName() << ">: " << e.what());
+        }
+        catch (...)
+        {
+            if (! exception) exception = std::current_exception();
+            else KTERROR(replog, "Unknown exception caught while emitting the output of processor <" << GetConfigName() << ">");
+        }
+        if (exception) std::rethrow_exception(exception);
+        return;
+    }
+
+    void KTReplicatedProcessor::CollectOutput(unsigned iOutput, unsigned iReplica, const KTDataPtr& data)
+    {
+        if (! fReplicaStates[iReplica].fIsRunning)
+        {
+            // not emitted in response to a routed data, so there's nothing to keep it in order with
+            (*fOutputs[iOutput].fSignal)(data);
+            return;
+        }
+        boost::lock_guard< boost::mutex > lock(fMergeMutex);
+        fPending[fReplicaStates[iReplica].fInput].fOutput.push_back(std::make_pair(iOutput, data));
+        return;
+    }
+
+    void KTReplicatedProcessor::FinishInput(unsigned iReplica, uint64_t input)
+    {
+        fReplicaStates[iReplica].fIsRunning = false;
+
+        boost::unique_lock< boost::mutex > lock(fMergeMutex);
+        fPending[input].fIsFinished = true;
+        // only one thread emits at a time, so that the output stays in order; the others leave their output for it
+        if (fIsEmitting) return;
+        fIsEmitting = true;
+        // a slot that throws doesn't stop the rest of the output from being emitted; the first exception is rethrown once it has been,
+        // and reaches Drain() through the replica's stage
+        std::exception_ptr exception;
+        while (! fPending.empty() && fPending.begin()->first == fNextOutput && fPending.begin()->second.fIsFinished)
+        {
+            OutputList output;
+            output.swap(fPending.begin()->second.fOutput);
+            fPending.erase(fPending.begin());
+            ++fNextOutput;
+
+            lock.unlock();
+            for (OutputList::const_iterator it = output.begin(); it != output.end(); ++it)
+            {
+                try
+                {
+                    (*fOutputs[it->first].fSignal)(it->second);
+                }
+                catch (std::exception& e)
+                {
+                    if (! exception) exception = std::current_exception();
+                    else KTERROR(replog, "Exception caught while emitting the output of processor <" << GetConfigName() << ">: " << e.what());
+                }
+                catch (...)
+                {
+                    if (! exception) exception = std::current_exception();
+                    else KTERROR(replog, "Unknown exception caught while emitting the output of processor <" << GetConfigName() << ">");
+                }
+            }
+            lock.lock();
+        }
+        fIsEmitting = false;
+        lock.unlock();
+        if (exception) std::rethrow_exception(exception);
+        return;
+    }
+
+} /* namespace Nymph */
@@ -0,0 +1,185 @@
+/**
+ @file KTReplicatedProcessor.hh
+ @brief Contains KTReplicatedProcessor
+ @details Runs several instances of a processor concurrently, and merges their output in order
+ @author: N. S. Oblath
+ @date: Oct 18, 2026
+ */
+
+#ifndef KTREPLICATEDPROCESSOR_HH_
+#define KTREPLICATEDPROCESSOR_HH_
+
+#include "KTProcessor.hh"
+
+#include "KTAsyncStage.hh"
+#include "KTData.hh"
+
+#include <boost/function.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/mutex.hpp>
+
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace Nymph
+{
+    class KTSignalData;
+
+    /*!
+     @class KTReplicatedProcessor
+     @author N. S. Oblath
+
+     @brief Spreads the data sent to a processor over several instances (replicas) of that processor, each running on its own thread.
+
+     @details
+     A stateless processor that does a lot of work on each data object is a serial bottleneck in a chain.
+     KTReplicatedProcessor owns N replicas of such a processor and an asynchronous stage (KTAsyncStage) for each one.
+     It presents the same slots and signals as the replicas, so it can be connected in place of a single instance:
+     - A data sent to one of its slots is routed to one replica, chosen by the shard key of the data modulo N,
+       and that replica's slot is called on the replica's thread.
+       The default shard key is KTData::Counter; with an empty key, data are distributed in the order in which they arrive.
+       Data with the same key always go to the same replica.
+     - The data emitted by the replicas' signals are merged back into the order in which the data arrived,
+       and then emitted by the corresponding signal of the KTReplicatedProcessor.
+       The signals for a given input data are emitted once the replica has returned from its slot for that data, and after the signals for all earlier inputs.
+
+     Slots and signals are set up the first time they're requested with GetSlot() or GetSignal() (e.g. when a connection is made).
+     Only data slots and signals (i.e. those that take a KTDataPtr) can be used.
+
+     The replicas work on the data while the processor that sent them carries on, so a replicated processor must be the only consumer that modifies its input:
+     the other slots connected to the signal that feeds it, and the processor that emits that signal, must not modify the data (as for any asynchronous connection),
+     and nothing should read the data while the replica may be modifying it.  Downstream processors get the data once the replica is done with it.
+
+     If a replica's slot throws an exception, it's logged, and the output for the data that follow it is still emitted in order;
+     likewise, if a slot connected to one of this processor's signals throws, the rest of the output is still emitted.
+     The first exception is rethrown by Drain() (which the processor toolbox calls at the end of each run-queue group, so that the run fails);
+     later ones are logged.
+
+     The processor toolbox creates a KTReplicatedProcessor for a processor entry with the "replicas" option.
+
+     Configuration: each replica is configured with the node given to Configure().
+    */
+    class KTReplicatedProcessor : public KTProcessor
+    {
+        public:
+            typedef boost::function< uint64_t (const KTData&) > ShardKey;
+
+            /// Shard key that uses KTData::Counter
+            static uint64_t ShardByCounter(const KTData& data);
+
+        public:
+            /// Takes ownership of the replicas, which should all be of the same type
+            KTReplicatedProcessor(const std::string& name, const std::vector< KTProcessor* >& replicas, unsigned queueDepth = KTAsyncStage::sDefaultQueueDepth);
+            virtual ~KTReplicatedProcessor();
+
+            bool Configure(const scarab::param_node& node);
+
+            unsigned GetNReplicas() const;
+            KTProcessor* GetReplica(unsigned iReplica) const;
+            /// The stage on which the replica's slots are called
+            boost::shared_ptr< KTAsyncStage > GetStage(unsigned iReplica) const;
+
+            const ShardKey& GetShardKey() const;
+            /// Set the shard key; if it's empty, data are distributed in the order in which they arrive
+            void SetShardKey(const ShardKey& key);
+
+            /// Blocks until all of the data that have been sent to the replicas have been processed and their output emitted.
+            /// If a replica's slot (or a slot connected to this processor's signals) has thrown an exception since the last call, the first one is rethrown.
+            void Drain();
+
+            /// Returns the slot, setting it up if it hasn't been used before; returns NULL if the replicas don't have a data slot with that name
+            virtual KTSlotWrapper* GetSlot(const std::string& name);
+            /// Returns the signal, setting it up if it hasn't been used before; returns NULL if the replicas don't have a data signal with that name
+            virtual KTSignalWrapper* GetSignal(const std::string& name);
+
+        private:
+            /// Connects a slot of this processor to the slot of the same name of each replica
+            bool AddRoute(const std::string& slotName);
+            /// Connects the signal of the same name of each replica to a signal of this processor
+            bool AddOutput(const std::string& signalName);
+
+            void RouteData(unsigned iRoute, const KTDataPtr& data);
+            void RunReplica(unsigned iReplica, unsigned iRoute, uint64_t input, KTDataPtr data);
+            void CollectOutput(unsigned iOutput, unsigned iReplica, const KTDataPtr& data);
+            void FinishInput(unsigned iReplica, uint64_t input);
+
+            std::vector< KTProcessor* > fReplicas;
+            std::vector< boost::shared_ptr< KTAsyncStage > > fStages;
+            ShardKey fShardKey;
+
+            // Route: the signals used to call a slot of each replica
+            struct Route
+            {
+                std::vector< KTSignalData* > fSignals;
+                std::vector< KTSignalWrapper* > fSignalWrappers;
+            };
+            std::vector< Route > fRoutes;
+
+            // Output: the signal of this processor that emits the merged output of a signal of the replicas
+            struct Output
+            {
+                KTSignalData* fSignal;
+                std::vector< KTSlotWrapper* > fCollectors;
+            };
+            std::vector< Output > fOutputs;
+
+            // Each replica's state is only used by that replica's thread
+            struct ReplicaState
+            {
+                uint64_t fInput;
+                bool fIsRunning;
+            };
+            std::vector< ReplicaState > fReplicaStates;
+
+            // Output waiting to be emitted, by input number
+            typedef std::vector< std::pair< unsigned, KTDataPtr > > OutputList;
+            struct PendingInput
+            {
+                PendingInput() : fIsFinished(false), fOutput() {}
+                bool fIsFinished;
+                OutputList fOutput;
+            };
+            typedef std::map< uint64_t, PendingInput > PendingMap;
+
+            PendingMap fPending;
+            uint64_t fNextInput;
+            uint64_t fNextOutput;
+            bool fIsEmitting;
+            boost::mutex fMergeMutex;
+    };
+
+    inline uint64_t KTReplicatedProcessor::ShardByCounter(const KTData& data)
+    {
+        return data.GetCounter();
+    }
+
+    inline unsigned KTReplicatedProcessor::GetNReplicas() const
+    {
+        return fReplicas.size();
+    }
+
+    inline KTProcessor* KTReplicatedProcessor::GetReplica(unsigned iReplica) const
+    {
+        return fReplicas[iReplica];
+    }
+
+    inline boost::shared_ptr< KTAsyncStage > KTReplicatedProcessor::GetStage(unsigned iReplica) const
+    {
+        return fStages[iReplica];
+    }
+
+    inline const KTReplicatedProcessor::ShardKey& KTReplicatedProcessor::GetShardKey() const
+    {
+        return fShardKey;
+    }
+
+    inline void KTReplicatedProcessor::SetShardKey(const ShardKey& key)
+    {
+        fShardKey = key;
+        return;
+    }
+
+} /* namespace Nymph */
+#endif /* KTREPLICATEDPROCESSOR_HH_ */
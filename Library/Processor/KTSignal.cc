@@ -31,22 +31,103 @@ namespace Nymph
 
 
     KTSignalData::KTSignalData(const std::string& name, KTProcessor* proc) :
-            KTSignalOneArg(name, proc),
-            fRefSignal()
+            KTSignalConnector< signature >(),
+            KTSignalConnector< ref_signature >(),
+            fSlots(new SlotList())
     {
-        proc->RegisterSignal("ref-"+name, &fRefSignal);
+        proc->RegisterSignal(name, static_cast< KTSignalConnector< signature >* >(this));
+        proc->RegisterSignal("ref-"+name, static_cast< KTSignalConnector< ref_signature >* >(this));
     }
 
     KTSignalData::~KTSignalData()
     {
     }
 
-    KTSignalData::KTSignalData()
+    KTSignalData::KTSignalData() :
+            KTSignalConnector< signature >(),
+            KTSignalConnector< ref_signature >(),
+            fSlots(new SlotList())
     {
     }
 
-    KTSignalData::KTSignalData(const KTSignalData&)
+    KTSignalData::KTSignalData(const KTSignalData&) :
+            KTSignalConnector< signature >(),
+            KTSignalConnector< ref_signature >(),
+            fSlots(new SlotList())
     {
     }
 
+    KTConnection KTSignalData::Connect(const slot_type& slot, int group, bool isGrouped)
+    {
+        DataSlot entry;
+        entry.fKind = DataSlot::kValue;
+        entry.fFunc = slot;
+        return KTConnection(fSlots, fSlots->Insert(entry, group, isGrouped, DataSlot::kValue));
+    }
+
+    KTConnection KTSignalData::Connect(const ref_slot_type& slot, int group, bool isGrouped)
+    {
+        DataSlot entry;
+        entry.fKind = DataSlot::kReference;
+        entry.fRefFunc = slot;
+        return KTConnection(fSlots, fSlots->Insert(entry, group, isGrouped, DataSlot::kReference));
+    }
+
+    void KTSignalData::SetParallelGroup(int group, bool isParallel)
+    {
+        fSlots->SetParallelGroup(group, isParallel);
+        return;
+    }
+
+
+
+    KTSignalDataBatch::KTSignalDataBatch(const std::string& name, KTProcessor* proc) :
+            KTSignalConnector< signature >(),
+            KTSignalConnector< item_signature >(),
+            fSlots(new SlotList())
+    {
+        proc->RegisterSignal(name, static_cast< KTSignalConnector< signature >* >(this));
+        proc->RegisterSignal("each-"+name, static_cast< KTSignalConnector< item_signature >* >(this));
+    }
+
+    KTSignalDataBatch::~KTSignalDataBatch()
+    {
+    }
+
+    KTSignalDataBatch::KTSignalDataBatch() :
+            KTSignalConnector< signature >(),
+            KTSignalConnector< item_signature >(),
+            fSlots(new SlotList())
+    {
+    }
+
+    KTSignalDataBatch::KTSignalDataBatch(const KTSignalDataBatch&) :
+            KTSignalConnector< signature >(),
+            KTSignalConnector< item_signature >(),
+            fSlots(new SlotList())
+    {
+    }
+
+    KTConnection KTSignalDataBatch::Connect(const slot_type& slot, int group, bool isGrouped)
+    {
+        BatchSlot entry;
+        entry.fKind = BatchSlot::kBatch;
+        entry.fFunc = slot;
+        return KTConnection(fSlots, fSlots->Insert(entry, group, isGrouped, BatchSlot::kBatch));
+    }
+
+    KTConnection KTSignalDataBatch::Connect(const item_slot_type& slot, int group, bool isGrouped)
+    {
+        BatchSlot entry;
+        entry.fKind = BatchSlot::kItem;
+        entry.fItemFunc = slot;
+        return KTConnection(fSlots, fSlots->Insert(entry, group, isGrouped, BatchSlot::kItem));
+    }
+
+    void KTSignalDataBatch::SetParallelGroup(int group, bool isParallel)
+    {
+        fSlots->SetParallelGroup(group, isParallel);
+        return;
+    }
+
 }
@@ -11,8 +11,7 @@
 #include "KTProcessor.hh"
 
 #include "KTData.hh"
-
-#include <boost/signals2.hpp>
+#include "KTSignalDispatcher.hh"
 
 #include <string>
 
@@ -26,6 +25,7 @@ namespace Nymph
 
      @details
      The signal is emitted by calling operator().
+     Slots are called through a KTSignalDispatcher, so emitting the signal takes no locks and makes no allocations.
      If a KTDataSlot is being used, and the Slot has been given a pointer to this signal, the Slot will emit the Signal.
 
      Usage:
@@ -39,9 +39,12 @@ namespace Nymph
     class KTSignalOneArg
     {
         public:
-            typedef void (signature)(XSignalArgument);
-            typedef boost::signals2::signal< signature > boost_signal;
-            typedef typename boost::signals2::signal< signature >::slot_type slot_type;
+            /// the argument is passed to slots as given by KTSlotArgument (i.e. a KTDataPtr is passed by const reference)
+            typedef typename KTSlotArgument< XSignalArgument >::type argument_type;
+            typedef void (signature)(argument_type);
+            typedef KTSignalDispatcher< signature > signal_type;
+            typedef signal_type boost_signal; // retained for source compatibility
+            typedef typename signal_type::slot_type slot_type;
 
         public:
             KTSignalOneArg();
@@ -52,12 +55,12 @@ namespace Nymph
             KTSignalOneArg(const KTSignalOneArg&);
 
         public:
-            void operator()(XSignalArgument arg);
+            void operator()(argument_type arg);
 
-            boost_signal* Signal();
+            signal_type* Signal();
 
         protected:
-            boost_signal fSignal;
+            signal_type fSignal;
 
     };
 
@@ -67,12 +70,9 @@ namespace Nymph
     {
         public:
             typedef void (signature)(void);
-            typedef boost::signals2::signal< signature > boost_signal;
-            // the following line is, technically, not valid C++03 code because the 'typename' keyword
-            // is appearing outside of a template (since the template here is fully specified, this counts).
-            // It should compiler with most new-ish compilers, even when compiling under C++03 mode.
-            // It has been tested successfully with GCC 4.6 and Clang 3.1
-            typedef typename boost::signals2::signal< signature >::slot_type slot_type;
+            typedef KTSignalDispatcher< signature > signal_type;
+            typedef signal_type boost_signal; // retained for source compatibility
+            typedef signal_type::slot_type slot_type;
 
         public:
             KTSignalOneArg();
@@ -85,10 +85,10 @@ namespace Nymph
         public:
             void operator()();
 
-            boost_signal* Signal();
+            signal_type* Signal();
 
         protected:
-            boost_signal fSignal;
+            signal_type fSignal;
 
     };
 
@@ -108,6 +108,27 @@ namespace Nymph
      The signal is emitted by calling operator().
      If a KTDataSlot is being used, and the Slot has been given a pointer to this signal, the Slot will emit the Signal.
 
+     Two signals are registered with the processor:
+     - [name]: for slots with signature void (const KTDataPtr&) (including slot functions declared as void (KTDataPtr); see KTSlotArgument);
+     - ref-[name]: for slots with signature void (KTDataPtr&).
+
+     Slots on [name] borrow the pointer that the signal was emitted with, so emitting the signal doesn't change the
+     pointer's reference count.  The first reference slot that is called gets a copy of the pointer,
+     which is then passed to all of the reference slots after it.  Value slots are always given the pointer that the signal was emitted with,
+     so a reference slot that modifies the pointer (e.g. moves it into a queue) doesn't affect any value slot.
+
+     Both kinds of slot are kept in a single ordered dispatch list, so emitting the signal is one pass over
+     that list, and nothing at all is done if no slots are connected.
+     All of the value slots are called before any of the reference slots, as when they were separate signals,
+     and each kind is ordered by group number (see KTSlotList).
+
+     The slots in a parallel group (see KTSlotList::SetParallelGroup()) are called concurrently, and the signal returns once they have all finished.
+     Value slots and reference slots in the same group are run as separate batches, and each reference slot in a parallel batch
+     is given its own copy of the pointer.
+     The slots in a parallel group share the data, so each should only modify its own extensions of it: adding data objects (KTData::Of())
+     and cut results (KTCutStatus::AddCutResult()) is thread-safe, and so is looking up the objects that are already there,
+     but modifying an object that another slot uses, or removing one, is not.
+
      Usage:
      In your Processor's header add a member variable of type KTSignalData.
 
@@ -116,16 +137,34 @@ namespace Nymph
      That's it!
     */
 
-    class KTSignalData : public KTSignalOneArg< KTDataPtr >
+    class KTSignalData : public KTSignalConnector< void (const KTDataPtr&) >, public KTSignalConnector< void (KTDataPtr&) >
     {
         public:
-            typedef void (signature)(KTDataPtr);
-            typedef boost::signals2::signal< signature > boost_signal;
-            typedef boost::signals2::signal< signature >::slot_type slot_type;
+            typedef void (signature)(const KTDataPtr&);
+            typedef boost::function< signature > slot_type;
 
             typedef void (ref_signature)(KTDataPtr&);
-            typedef boost::signals2::signal< ref_signature > ref_boost_signal;
-            typedef boost::signals2::signal< ref_signature >::slot_type ref_slot_type;
+            typedef boost::function< ref_signature > ref_slot_type;
+
+        private:
+            /// Entry in the dispatch list; fKind determines how the data is passed to the slot.
+            /// Other ways of delivering data (e.g. batched or asynchronous) should be added as new kinds,
+            /// and handled in KTSignalData::operator().
+            struct DataSlot
+            {
+                enum Kind
+                {
+                    kValue,
+                    kReference
+                };
+                Kind fKind;
+                slot_type fFunc;
+                ref_slot_type fRefFunc;
+
+                void Call(const KTDataPtr& arg) const;
+                void CallRef(KTDataPtr& arg) const;
+            };
+            typedef KTSlotList< DataSlot > SlotList;
 
         public:
             KTSignalData();
@@ -136,12 +175,101 @@ namespace Nymph
             KTSignalData(const KTSignalData&);
 
         public:
-            void operator()(KTDataPtr arg);
+            KTConnection Connect(const slot_type& slot, int group, bool isGrouped);
+            KTConnection Connect(const ref_slot_type& slot, int group, bool isGrouped);
+
+            void SetParallelGroup(int group, bool isParallel);
+
+            void operator()(const KTDataPtr& arg);
+
+            bool empty() const;
+            unsigned num_slots() const;
+
+            KTSignalConnector< signature >* Signal();
+            KTSignalConnector< ref_signature >* RefSignal();
+
+        protected:
+            boost::shared_ptr< SlotList > fSlots;
+    };
+
+
+    /*!
+     @class KTSignalDataBatch
+     @author N. S. Oblath
+
+     @brief Creates a signal that passes a batch of KTDataPtr objects (KTDataPtrBatch) to its slots in a single call.
+
+     @details
+     For high-rate streams of small data objects, the cost of dispatching each object separately (a function call per slot,
+     the type checks in the data slot, logging checks, etc.) can be comparable to the cost of the analysis itself.
+     Passing a batch pays that cost once per batch.
+
+     Two signals are registered with the processor:
+     - [name]: for slots with signature void (const KTDataPtrBatch&), e.g. KTSlotDataBatch;
+     - each-[name]: for slots with signature void (const KTDataPtr&), e.g. KTSlotDataOneType; the slot is called once for each data object in the batch.
+       This allows batch signals to drive existing single-object slots.
+
+     Both kinds of slot are kept in a single ordered dispatch list, as in KTSignalData; all of the batch slots are called before any of the per-object slots.
+     The slots in a parallel group share the data objects in the batch, with the same restrictions as in KTSignalData.
+
+     To feed a batch slot from a single-object signal, use KTBatchAccumulator.
+
+     Usage:
+     In your Processor's header add a member variable of type KTSignalDataBatch.
+
+     Initialize the signal with the processor's 'this' pointer and the name of the signal.
+    */
+
+    class KTSignalDataBatch : public KTSignalConnector< void (const KTDataPtrBatch&) >, public KTSignalConnector< void (const KTDataPtr&) >
+    {
+        public:
+            typedef void (signature)(const KTDataPtrBatch&);
+            typedef boost::function< signature > slot_type;
+
+            typedef void (item_signature)(const KTDataPtr&);
+            typedef boost::function< item_signature > item_slot_type;
+
+        private:
+            /// Entry in the dispatch list; fKind determines how the batch is passed to the slot
+            struct BatchSlot
+            {
+                enum Kind
+                {
+                    kBatch,
+                    kItem
+                };
+                Kind fKind;
+                slot_type fFunc;
+                item_slot_type fItemFunc;
+
+                void Call(const KTDataPtrBatch& arg) const;
+            };
+            typedef KTSlotList< BatchSlot > SlotList;
+
+        public:
+            KTSignalDataBatch();
+            KTSignalDataBatch(const std::string& name, KTProcessor* proc);
+            virtual ~KTSignalDataBatch();
+
+        protected:
+            KTSignalDataBatch(const KTSignalDataBatch&);
+
+        public:
+            KTConnection Connect(const slot_type& slot, int group, bool isGrouped);
+            KTConnection Connect(const item_slot_type& slot, int group, bool isGrouped);
+
+            void SetParallelGroup(int group, bool isParallel);
 
-            ref_boost_signal* RefSignal();
+            void operator()(const KTDataPtrBatch& arg);
+
+            bool empty() const;
+            unsigned num_slots() const;
+
+            KTSignalConnector< signature >* Signal();
+            KTSignalConnector< item_signature >* ItemSignal();
 
         protected:
-            ref_boost_signal fRefSignal;
+            boost::shared_ptr< SlotList > fSlots;
     };
 
 
@@ -169,13 +297,13 @@ namespace Nymph
     }
 
     template< class XSignalArgument >
-    inline void KTSignalOneArg< XSignalArgument >::operator()(XSignalArgument arg)
+    inline void KTSignalOneArg< XSignalArgument >::operator()(argument_type arg)
     {
         fSignal(arg);
     }
 
     template< class XSignalArgument >
-    inline typename KTSignalOneArg< XSignalArgument >::boost_signal* KTSignalOneArg< XSignalArgument >::Signal()
+    inline typename KTSignalOneArg< XSignalArgument >::signal_type* KTSignalOneArg< XSignalArgument >::Signal()
     {
         return &fSignal;
     }
@@ -186,21 +314,145 @@ namespace Nymph
         fSignal();
     }
 
-    inline typename KTSignalOneArg< void >::boost_signal* KTSignalOneArg< void >::Signal()
+    inline typename KTSignalOneArg< void >::signal_type* KTSignalOneArg< void >::Signal()
     {
         return &fSignal;
     }
 
 
-    inline void KTSignalData::operator()(KTDataPtr arg)
+    inline void KTSignalData::DataSlot::Call(const KTDataPtr& arg) const
     {
-        fSignal(arg);
-        fRefSignal(arg);
+        fFunc(arg);
+        return;
+    }
+
+    inline void KTSignalData::DataSlot::CallRef(KTDataPtr& arg) const
+    {
+        fRefFunc(arg);
+        return;
+    }
+
+    inline void KTSignalData::operator()(const KTDataPtr& arg)
+    {
+        const SlotList::List* slots = fSlots->Slots();
+        if (slots == NULL) return;
+        // value slots borrow the original pointer; the copy is only made once a reference slot needs it,
+        // and what the reference slots do to it isn't seen by the value slots
+        KTDataPtr refArg;
+        bool isRefArgSet = false;
+        SlotList::ListCIt it = slots->begin();
+        while (it != slots->end())
+        {
+            SlotList::ListCIt batchEnd = SlotList::EndOfBatch(it, slots->end());
+            bool isReference = it->fEntry.fKind == DataSlot::kReference;
+            if (isReference && ! isRefArgSet)
+            {
+                refArg = arg;
+                isRefArgSet = true;
+            }
+            if (batchEnd - it == 1)
+            {
+                if (isReference) it->fEntry.CallRef(refArg);
+                else it->fEntry.Call(arg);
+                it = batchEnd;
+                continue;
+            }
+            std::vector< KTThreadPool::Task > tasks;
+            tasks.reserve(batchEnd - it);
+            for (; it != batchEnd; ++it)
+            {
+                // each reference slot in a parallel batch gets its own copy of the pointer
+                if (isReference) tasks.push_back(boost::bind(&DataSlot::CallRef, &(it->fEntry), refArg));
+                else tasks.push_back(boost::bind(&DataSlot::Call, &(it->fEntry), boost::cref(arg)));
+            }
+            KTThreadPool::get_instance()->RunAll(tasks);
+        }
+        return;
+    }
+
+    inline bool KTSignalData::empty() const
+    {
+        return fSlots->Slots() == NULL;
+    }
+
+    inline unsigned KTSignalData::num_slots() const
+    {
+        const SlotList::List* slots = fSlots->Slots();
+        return slots == NULL ? 0 : slots->size();
+    }
+
+    inline KTSignalConnector< KTSignalData::signature >* KTSignalData::Signal()
+    {
+        return this;
+    }
+
+    inline KTSignalConnector< KTSignalData::ref_signature >* KTSignalData::RefSignal()
+    {
+        return this;
+    }
+
+
+    inline void KTSignalDataBatch::BatchSlot::Call(const KTDataPtrBatch& arg) const
+    {
+        switch (fKind)
+        {
+            case kBatch:
+                fFunc(arg);
+                break;
+            case kItem:
+                for (KTDataPtrBatch::const_iterator it = arg.begin(); it != arg.end(); ++it)
+                {
+                    fItemFunc(*it);
+                }
+                break;
+        }
+        return;
+    }
+
+    inline void KTSignalDataBatch::operator()(const KTDataPtrBatch& arg)
+    {
+        const SlotList::List* slots = fSlots->Slots();
+        if (slots == NULL) return;
+        SlotList::ListCIt it = slots->begin();
+        while (it != slots->end())
+        {
+            SlotList::ListCIt batchEnd = SlotList::EndOfBatch(it, slots->end());
+            if (batchEnd - it == 1)
+            {
+                it->fEntry.Call(arg);
+                it = batchEnd;
+                continue;
+            }
+            std::vector< KTThreadPool::Task > tasks;
+            tasks.reserve(batchEnd - it);
+            for (; it != batchEnd; ++it)
+            {
+                tasks.push_back(boost::bind(&BatchSlot::Call, &(it->fEntry), boost::cref(arg)));
+            }
+            KTThreadPool::get_instance()->RunAll(tasks);
+        }
+        return;
+    }
+
+    inline bool KTSignalDataBatch::empty() const
+    {
+        return fSlots->Slots() == NULL;
+    }
+
+    inline unsigned KTSignalDataBatch::num_slots() const
+    {
+        const SlotList::List* slots = fSlots->Slots();
+        return slots == NULL ? 0 : slots->size();
+    }
+
+    inline KTSignalConnector< KTSignalDataBatch::signature >* KTSignalDataBatch::Signal()
+    {
+        return this;
     }
 
-    inline typename KTSignalData::ref_boost_signal* KTSignalData::RefSignal()
+    inline KTSignalConnector< KTSignalDataBatch::item_signature >* KTSignalDataBatch::ItemSignal()
     {
-        return &fRefSignal;
+        return this;
     }
 
 } /* namespace Nymph */
@@ -0,0 +1,431 @@
+/*
+ * KTSignalDispatcher.hh
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: nsoblath
+ */
+
+#ifndef KTSIGNALDISPATCHER_HH_
+#define KTSIGNALDISPATCHER_HH_
+
+#include "KTConnection.hh"
+#include "KTThreadPool.hh"
+
+#include <boost/bind.hpp>
+#include <boost/function.hpp>
+#include <boost/ref.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/locks.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/utility.hpp>
+
+#include <atomic>
+#include <set>
+#include <vector>
+
+namespace Nymph
+{
+    /*!
+     @class KTSignalConnector
+     @author N. S. Oblath
+
+     @brief Interface for anything that slots with signature XSignature can be connected to.
+
+     @details
+     This is the type that KTSignalWrapper stores, so any object implementing it can be registered as a signal
+     with KTProcessor::RegisterSignal.
+    */
+    template< typename XSignature >
+    class KTSignalConnector
+    {
+        public:
+            typedef XSignature signature;
+
+        public:
+            KTSignalConnector() {}
+            virtual ~KTSignalConnector() {}
+
+            /// Connect a slot; if isGrouped is false, group is ignored
+            virtual KTConnection Connect(const boost::function< XSignature >& slot, int group, bool isGrouped) = 0;
+
+            /// If isParallel is true, the slots in the group are called concurrently (see KTSlotList)
+            virtual void SetParallelGroup(int group, bool isParallel) = 0;
+    };
+
+
+    /*!
+     @class KTSlotList
+     @author N. S. Oblath
+
+     @brief Ordered list of connected slots, handled with a read-copy-update scheme.
+
+     @details
+     - Reading the list (Slots()) is a single atomic load of a pointer to an immutable list.
+       There are no locks and no allocations on this path, so it's what signals use when they're emitted.
+     - Inserting and removing slots take a mutex, copy the current list, modify the copy, and atomically
+       publish it.  The superseded list is kept until the KTSlotList is destroyed, since a signal emitted
+       concurrently on another thread may still be iterating over it.
+
+     Connections are expected to change rarely (normally only while the processor toolbox is configured),
+     so the memory held by superseded lists is small.  A slot removed while another thread is emitting
+     may be called one last time by that emit.
+
+     An empty list is published as a NULL pointer.
+
+     Slots are ordered by rank first, and the slots of each rank are ordered as in boost::signals2:
+     - Slots inserted with a group number come first, in ascending group order;
+     - Slots inserted without a group number come afterwards;
+     - Within a group (or among the ungrouped slots), slots are ordered by the order they were inserted.
+     The rank allows a signal to keep different kinds of slots in one list, but call them as though they were separate signals,
+     one after the other; slots that don't give a rank all have the same one.
+
+     A group can be made parallel with SetParallelGroup().  The slots of one rank in a parallel group form a batch
+     that the signal runs concurrently on the KTThreadPool; the signal continues to the next slot once the whole batch has finished.
+     The slots in a batch share the signal's arguments (nothing is copied), so slots that run concurrently
+     must not modify an argument that another slot in the batch uses.
+     Use EndOfBatch() while iterating over the list to find the batches.
+
+     XEntry is whatever the owning signal needs to call a slot (e.g. a boost::function).
+    */
+    template< typename XEntry >
+    class KTSlotList : public KTConnectionTarget, public boost::noncopyable
+    {
+        public:
+            struct Node
+            {
+                XEntry fEntry;
+                int fGroup;
+                bool fIsGrouped;
+                int fRank;
+                bool fIsParallel;
+                unsigned long fID;
+            };
+            typedef std::vector< Node > List;
+            typedef typename List::const_iterator ListCIt;
+
+        public:
+            KTSlotList();
+            virtual ~KTSlotList();
+
+            /// Returns the ID of the new slot
+            unsigned long Insert(const XEntry& entry, int group, bool isGrouped, int rank=0);
+            void Disconnect(unsigned long id);
+            bool IsConnected(unsigned long id) const;
+            void DisconnectAll();
+
+            void SetParallelGroup(int group, bool isParallel);
+
+            /// Returns the current list of slots; NULL if there are no slots
+            const List* Slots() const;
+
+            /// Returns the end of the batch of slots that starts at first; for a slot that isn't parallel, that's simply first + 1
+            static ListCIt EndOfBatch(ListCIt first, ListCIt last);
+
+        private:
+            /// Must be called with fMutex locked; takes ownership of newList
+            void Publish(List* newList);
+
+            std::atomic< const List* > fList;
+            std::vector< const List* > fRetired;
+            std::set< int > fParallelGroups;
+            unsigned long fNextID;
+            mutable boost::mutex fMutex;
+    };
+
+
+    /*!
+     @class KTSignalDispatcher
+     @author N. S. Oblath
+
+     @brief Signal object that calls a list of connected slots; replaces boost::signals2::signal.
+
+     @details
+     The slots are stored in a KTSlotList, so emitting the signal (operator()) takes no locks and makes no allocations.
+     See KTSlotList for the details of the ordering of slots.
+
+     Return values of the slots are discarded.
+
+     Slots in parallel groups are called concurrently (see KTSlotList::SetParallelGroup()).
+    */
+    template< typename XSignature >
+    class KTSignalDispatcher;
+
+    template< typename XReturn, typename... XArgs >
+    class KTSignalDispatcher< XReturn (XArgs...) > : public KTSignalConnector< XReturn (XArgs...) >, public boost::noncopyable
+    {
+        public:
+            typedef XReturn (signature)(XArgs...);
+            typedef boost::function< signature > slot_type;
+
+        private:
+            typedef KTSlotList< slot_type > SlotList;
+
+        public:
+            KTSignalDispatcher();
+            virtual ~KTSignalDispatcher();
+
+            KTConnection Connect(const slot_type& slot, int group, bool isGrouped);
+
+            void SetParallelGroup(int group, bool isParallel);
+
+            /// Connect a slot that will be called after all grouped slots
+            KTConnection connect(const slot_type& slot);
+            /// Connect a slot in group number group
+            KTConnection connect(int group, const slot_type& slot);
+
+            void disconnect_all_slots();
+
+            bool empty() const;
+            unsigned num_slots() const;
+
+            /// Call all connected slots
+            void operator()(XArgs... args) const;
+
+        private:
+            boost::shared_ptr< SlotList > fSlots;
+    };
+
+
+    //**************************
+    // KTSlotList implementation
+    //**************************
+
+    template< typename XEntry >
+    KTSlotList< XEntry >::KTSlotList() :
+            KTConnectionTarget(),
+            fList(NULL),
+            fRetired(),
+            fParallelGroups(),
+            fNextID(1),
+            fMutex()
+    {}
+
+    template< typename XEntry >
+    KTSlotList< XEntry >::~KTSlotList()
+    {
+        delete fList.load();
+        for (typename std::vector< const List* >::iterator it = fRetired.begin(); it != fRetired.end(); ++it)
+        {
+            delete *it;
+        }
+    }
+
+    template< typename XEntry >
+    unsigned long KTSlotList< XEntry >::Insert(const XEntry& entry, int group, bool isGrouped, int rank)
+    {
+        boost::lock_guard< boost::mutex > lock(fMutex);
+
+        const List* current = fList.load(std::memory_order_relaxed);
+        List* newList = current == NULL ? new List() : new List(*current);
+
+        bool isParallel = isGrouped && fParallelGroups.count(group) != 0;
+        Node node = {entry, group, isGrouped, rank, isParallel, fNextID++};
+
+        // skip over all of the slots that should be called before the new one
+        typename List::iterator pos = newList->begin();
+        while (pos != newList->end())
+        {
+            bool callsBefore = false;
+            if (pos->fRank != rank) callsBefore = pos->fRank < rank;
+            else if (pos->fIsGrouped != isGrouped) callsBefore = pos->fIsGrouped;
+            else if (isGrouped && pos->fGroup != group) callsBefore = pos->fGroup < group;
+            else callsBefore = true;
+            if (! callsBefore) break;
+            ++pos;
+        }
+        newList->insert(pos, node);
+
+        Publish(newList);
+        return node.fID;
+    }
+
+    template< typename XEntry >
+    void KTSlotList< XEntry >::Disconnect(unsigned long id)
+    {
+        boost::lock_guard< boost::mutex > lock(fMutex);
+
+        const List* current = fList.load(std::memory_order_relaxed);
+        if (current == NULL) return;
+
+        List* newList = new List();
+        newList->reserve(current->size());
+        for (ListCIt it = current->begin(); it != current->end(); ++it)
+        {
+            if (it->fID != id) newList->push_back(*it);
+        }
+        if (newList->size() == current->size())
+        {
+            // nothing was removed
+            delete newList;
+            return;
+        }
+
+        Publish(newList);
+        return;
+    }
+
+    template< typename XEntry >
+    bool KTSlotList< XEntry >::IsConnected(unsigned long id) const
+    {
+        boost::lock_guard< boost::mutex > lock(fMutex);
+
+        const List* current = fList.load(std::memory_order_relaxed);
+        if (current == NULL) return false;
+        for (ListCIt it = current->begin(); it != current->end(); ++it)
+        {
+            if (it->fID == id) return true;
+        }
+        return false;
+    }
+
+    template< typename XEntry >
+    void KTSlotList< XEntry >::DisconnectAll()
+    {
+        boost::lock_guard< boost::mutex > lock(fMutex);
+        Publish(NULL);
+        return;
+    }
+
+    template< typename XEntry >
+    void KTSlotList< XEntry >::SetParallelGroup(int group, bool isParallel)
+    {
+        boost::lock_guard< boost::mutex > lock(fMutex);
+
+        if (isParallel) fParallelGroups.insert(group);
+        else fParallelGroups.erase(group);
+
+        const List* current = fList.load(std::memory_order_relaxed);
+        if (current == NULL) return;
+
+        List* newList = new List(*current);
+        for (typename List::iterator it = newList->begin(); it != newList->end(); ++it)
+        {
+            if (it->fIsGrouped && it->fGroup == group) it->fIsParallel = isParallel;
+        }
+
+        Publish(newList);
+        return;
+    }
+
+    template< typename XEntry >
+    inline const typename KTSlotList< XEntry >::List* KTSlotList< XEntry >::Slots() const
+    {
+        return fList.load(std::memory_order_acquire);
+    }
+
+    template< typename XEntry >
+    typename KTSlotList< XEntry >::ListCIt KTSlotList< XEntry >::EndOfBatch(ListCIt first, ListCIt last)
+    {
+        ListCIt end = first;
+        ++end;
+        if (! first->fIsParallel) return end;
+        while (end != last && end->fIsParallel && end->fGroup == first->fGroup && end->fRank == first->fRank)
+        {
+            ++end;
+        }
+        return end;
+    }
+
+    template< typename XEntry >
+    void KTSlotList< XEntry >::Publish(List* newList)
+    {
+        if (newList != NULL && newList->empty())
+        {
+            delete newList;
+            newList = NULL;
+        }
+        const List* oldList = fList.exchange(newList, std::memory_order_acq_rel);
+        if (oldList != NULL) fRetired.push_back(oldList);
+        return;
+    }
+
+
+    //*********************************
+    // KTSignalDispatcher implementation
+    //*********************************
+
+    template< typename XReturn, typename... XArgs >
+    KTSignalDispatcher< XReturn (XArgs...) >::KTSignalDispatcher() :
+            KTSignalConnector< XReturn (XArgs...) >(),
+            fSlots(new SlotList())
+    {}
+
+    template< typename XReturn, typename... XArgs >
+    KTSignalDispatcher< XReturn (XArgs...) >::~KTSignalDispatcher()
+    {}
+
+    template< typename XReturn, typename... XArgs >
+    KTConnection KTSignalDispatcher< XReturn (XArgs...) >::Connect(const slot_type& slot, int group, bool isGrouped)
+    {
+        return KTConnection(fSlots, fSlots->Insert(slot, group, isGrouped));
+    }
+
+    template< typename XReturn, typename... XArgs >
+    void KTSignalDispatcher< XReturn (XArgs...) >::SetParallelGroup(int group, bool isParallel)
+    {
+        fSlots->SetParallelGroup(group, isParallel);
+        return;
+    }
+
+    template< typename XReturn, typename... XArgs >
+    inline KTConnection KTSignalDispatcher< XReturn (XArgs...) >::connect(const slot_type& slot)
+    {
+        return Connect(slot, 0, false);
+    }
+
+    template< typename XReturn, typename... XArgs >
+    inline KTConnection KTSignalDispatcher< XReturn (XArgs...) >::connect(int group, const slot_type& slot)
+    {
+        return Connect(slot, group, true);
+    }
+
+    template< typename XReturn, typename... XArgs >
+    void KTSignalDispatcher< XReturn (XArgs...) >::disconnect_all_slots()
+    {
+        fSlots->DisconnectAll();
+        return;
+    }
+
+    template< typename XReturn, typename... XArgs >
+    inline bool KTSignalDispatcher< XReturn (XArgs...) >::empty() const
+    {
+        return fSlots->Slots() == NULL;
+    }
+
+    template< typename XReturn, typename... XArgs >
+    inline unsigned KTSignalDispatcher< XReturn (XArgs...) >::num_slots() const
+    {
+        const typename SlotList::List* slots = fSlots->Slots();
+        return slots == NULL ? 0 : slots->size();
+    }
+
+    template< typename XReturn, typename... XArgs >
+    inline void KTSignalDispatcher< XReturn (XArgs...) >::operator()(XArgs... args) const
+    {
+        const typename SlotList::List* slots = fSlots->Slots();
+        if (slots == NULL) return;
+        typename SlotList::ListCIt it = slots->begin();
+        while (it != slots->end())
+        {
+            typename SlotList::ListCIt batchEnd = SlotList::EndOfBatch(it, slots->end());
+            if (batchEnd - it == 1)
+            {
+                it->fEntry(args...);
+                it = batchEnd;
+                continue;
+            }
+            std::vector< KTThreadPool::Task > tasks;
+            tasks.reserve(batchEnd - it);
+            for (; it != batchEnd; ++it)
+            {
+                // bind by reference: the arguments and the slot outlive RunAll(), and copying them would lose
+                // changes made through reference arguments (and wouldn't compile for non-copyable types)
+                tasks.push_back(boost::bind(boost::ref(it->fEntry), boost::ref(args)...));
+            }
+            KTThreadPool::get_instance()->RunAll(tasks);
+        }
+        return;
+    }
+
+} /* namespace Nymph */
+#endif /* KTSIGNALDISPATCHER_HH_ */
@@ -8,19 +8,67 @@
 #ifndef KTSIGNALWRAPPER_HH_
 #define KTSIGNALWRAPPER_HH_
 
-#include <boost/signals2.hpp>
+#include "KTData.hh"
+#include "KTSignalDispatcher.hh"
+
 #include <boost/utility.hpp>
 
 #include <iostream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
 
 namespace Nymph
 {
+    /*!
+     @struct KTSlotArgument
+     @author N. S. Oblath
+
+     @brief Gives the type with which an argument is passed from a signal to its slots.
+
+     @details
+     Most arguments are passed as declared.  A KTDataPtr is passed as a const reference instead:
+     its reference count is shared between threads, so copying it for every slot call is expensive.
+     The reference count is only changed if a slot keeps a copy of the pointer (e.g. an asynchronous connection,
+     or a slot function that takes a KTDataPtr by value).
+
+     Signals and RegisterSlot() both use this, so slots declared with a KTDataPtr argument connect to data signals as before.
+    */
+    template< typename XArgument >
+    struct KTSlotArgument
+    {
+        typedef XArgument type;
+    };
+
+    template<>
+    struct KTSlotArgument< KTDataPtr >
+    {
+        typedef const KTDataPtr& type;
+    };
+
+    /// True for the signatures of signals that pass data objects to their slots
+    template< typename XSignature >
+    struct KTPassesData : std::false_type
+    {};
+
+    template<>
+    struct KTPassesData< void (const KTDataPtr&) > : std::true_type
+    {};
+
+    template<>
+    struct KTPassesData< void (KTDataPtr&) > : std::true_type
+    {};
+
+    template<>
+    struct KTPassesData< void (const KTDataPtrBatch&) > : std::true_type
+    {};
+
     template< typename Signature >
     struct KTSignalConcept
     {
         typedef Signature signature;
-        typedef boost::signals2::signal< Signature > signal;
-        typedef typename boost::signals2::signal< Signature >::slot_type slot_type;
+        typedef KTSignalDispatcher< Signature > signal;
+        typedef typename KTSignalDispatcher< Signature >::slot_type slot_type;
     };
 
     class SignalException : public std::logic_error
@@ -40,29 +88,63 @@ namespace Nymph
                 public:
                     KTInternalSignalWrapper() {}
                     virtual ~KTInternalSignalWrapper() {}
+
+                    virtual void SetParallelGroup(int group, bool isParallel) = 0;
+                    virtual bool PassesData() const = 0;
+                    virtual const void* GetSignalObject() const = 0;
             };
 
+            // XSignature is the function signature of the signal;
+            // the signal is stored through the interface that slots with that signature connect to
             template< typename XSignature >
             class KTSpecifiedInternalSignalWrapper : public KTInternalSignalWrapper, public boost::noncopyable
             {
                 public:
-                    KTSpecifiedInternalSignalWrapper(XSignature* signalPtr) : fSignal(signalPtr)
+                    KTSpecifiedInternalSignalWrapper(KTSignalConnector< XSignature >* signalPtr) : fSignal(signalPtr)
                     {}
                     virtual ~KTSpecifiedInternalSignalWrapper() {}
 
-                    XSignature* GetSignal() const
+                    virtual void SetParallelGroup(int group, bool isParallel)
+                    {
+                        fSignal->SetParallelGroup(group, isParallel);
+                        return;
+                    }
+
+                    virtual bool PassesData() const
+                    {
+                        return KTPassesData< XSignature >::value;
+                    }
+
+                    virtual const void* GetSignalObject() const
+                    {
+                        // the complete object, which is the same for each of the interfaces of a signal
+                        return dynamic_cast< const void* >(fSignal);
+                    }
+
+                    KTSignalConnector< XSignature >* GetSignal() const
                     {
                         return fSignal;
                     }
                 private:
-                    XSignature* fSignal; //not owned by this KTSignalWrapper
+                    KTSignalConnector< XSignature >* fSignal; //not owned by this KTSignalWrapper
             };
 
         public:
-            template< typename XSignature >
-            KTSignalWrapper(XSignature* signalPtr);
+            /// XSignal can be any type derived from KTSignalConnector< XSignal::signature >
+            template< typename XSignal >
+            KTSignalWrapper(XSignal* signalPtr);
             ~KTSignalWrapper();
 
+            /// Slots connected to the signal in a parallel group are called concurrently
+            void SetParallelGroup(int group, bool isParallel=true);
+
+            /// True if the signal passes data objects (KTDataPtr or KTDataPtrBatch) to its slots
+            bool PassesData() const;
+
+            /// Identifies the signal; a signal that's registered under more than one name (e.g. the [name] and ref-[name] signals of a KTSignalData)
+            /// gives the same object for each
+            const void* GetSignalObject() const;
+
         private:
             KTSignalWrapper();
 
@@ -72,11 +154,27 @@ namespace Nymph
 
     };
 
-    template< typename XSignature >
-    KTSignalWrapper::KTSignalWrapper(XSignature* signalPtr) :
+    template< typename XSignal >
+    KTSignalWrapper::KTSignalWrapper(XSignal* signalPtr) :
             fSignalWrapper(NULL)
     {
-        fSignalWrapper = new KTSpecifiedInternalSignalWrapper< XSignature >(signalPtr);
+        fSignalWrapper = new KTSpecifiedInternalSignalWrapper< typename XSignal::signature >(signalPtr);
+    }
+
+    inline void KTSignalWrapper::SetParallelGroup(int group, bool isParallel)
+    {
+        fSignalWrapper->SetParallelGroup(group, isParallel);
+        return;
+    }
+
+    inline bool KTSignalWrapper::PassesData() const
+    {
+        return fSignalWrapper->PassesData();
+    }
+
+    inline const void* KTSignalWrapper::GetSignalObject() const
+    {
+        return fSignalWrapper->GetSignalObject();
     }
 
     inline KTSignalWrapper::KTInternalSignalWrapper* KTSignalWrapper::GetInternal() const
@@ -16,6 +16,7 @@
 #include <boost/function.hpp>
 
 #include <string>
+#include <vector>
 
 namespace Nymph
 {
@@ -78,7 +79,8 @@ namespace Nymph
             KTSlotOneArg(const std::string& name, KTProcessor* proc, XFuncOwnerType* owner, return_type (XFuncOwnerType::*func)(argument_type));
             virtual ~KTSlotOneArg();
 
-            return_type operator()(argument_type arg);
+            /// A KTDataPtr argument is received by const reference (see KTSlotArgument)
+            return_type operator()(typename KTSlotArgument< argument_type >::type arg);
 
         protected:
             boost::function< Signature > fFunc;
@@ -164,7 +166,7 @@ namespace Nymph
     }
 
     template< typename Signature>
-    typename KTSlotOneArg< Signature >::return_type KTSlotOneArg< Signature >::operator()(argument_type arg)
+    typename KTSlotOneArg< Signature >::return_type KTSlotOneArg< Signature >::operator()(typename KTSlotArgument< argument_type >::type arg)
     {
         return fFunc(arg);
     }
@@ -213,7 +215,7 @@ namespace Nymph
 
      @details
      Usage:
-     This slot type adds the slot function (signature void (KTDataPtr).
+     This slot type adds the slot function (signature void (const KTDataPtr&)).
      Your processor (or, optionally, a different object) must have a member function with the signature bool (DataType&).
      The slot function checks that the provided KTData object contains data of type DataType, and then calls the member function.
 
@@ -230,7 +232,7 @@ namespace Nymph
     {
         public:
             typedef XDataType data_type;
-            typedef boost::function< void (KTDataPtr) > function_signature;
+            typedef boost::function< void (const KTDataPtr&) > function_signature;
             typedef typename function_signature::result_type return_type;
             typedef typename function_signature::argument_type argument_type;
 
@@ -243,7 +245,7 @@ namespace Nymph
             KTSlotDataOneType(const std::string& name, KTProcessor* proc, XFuncOwnerType* owner, bool (XFuncOwnerType::*func)(data_type&), KTSignalData* signalPtr=NULL);
             virtual ~KTSlotDataOneType();
 
-            void operator()(KTDataPtr data);
+            void operator()(const KTDataPtr& data);
 
         protected:
             boost::function< bool (data_type&) > fFunc;
@@ -258,7 +260,7 @@ namespace Nymph
         public:
             typedef XDataType1 first_data_type;
             typedef XDataType2 second_data_type;
-            typedef boost::function< void (KTDataPtr) > function_signature;
+            typedef boost::function< void (const KTDataPtr&) > function_signature;
             typedef typename function_signature::result_type return_type;
             typedef typename function_signature::argument_type argument_type;
 
@@ -271,7 +273,7 @@ namespace Nymph
             KTSlotDataTwoTypes(const std::string& name, KTProcessor* proc, XFuncOwnerType* owner, bool (XFuncOwnerType::*func)(first_data_type&, second_data_type&), KTSignalData* signalPtr=NULL);
             virtual ~KTSlotDataTwoTypes();
 
-            void operator()(KTDataPtr data);
+            void operator()(const KTDataPtr& data);
 
         protected:
             boost::function< bool (first_data_type&, second_data_type&) > fFunc;
@@ -287,7 +289,7 @@ namespace Nymph
             typedef XDataType1 first_data_type;
             typedef XDataType2 second_data_type;
             typedef XDataType3 third_data_type;
-            typedef boost::function< void (KTDataPtr) > function_signature;
+            typedef boost::function< void (const KTDataPtr&) > function_signature;
             typedef typename function_signature::result_type return_type;
             typedef typename function_signature::argument_type argument_type;
 
@@ -300,7 +302,7 @@ namespace Nymph
             KTSlotDataThreeTypes(const std::string& name, KTProcessor* proc, XFuncOwnerType* owner, bool (XFuncOwnerType::*func)(first_data_type&, second_data_type&, third_data_type&), KTSignalData* signalPtr=NULL);
             virtual ~KTSlotDataThreeTypes();
 
-            void operator()(KTDataPtr data);
+            void operator()(const KTDataPtr& data);
 
         protected:
             boost::function< bool (first_data_type&, second_data_type&, third_data_type&) > fFunc;
@@ -334,7 +336,7 @@ namespace Nymph
     }
 
     template< class XDataType >
-    void KTSlotDataOneType< XDataType >::operator()(KTDataPtr data)
+    void KTSlotDataOneType< XDataType >::operator()(const KTDataPtr& data)
     {
         // Standard data slot pattern:
         // Check to ensure that the required data type is present
@@ -383,7 +385,7 @@ namespace Nymph
     }
 
     template< class XDataType1, class XDataType2 >
-    void KTSlotDataTwoTypes< XDataType1, XDataType2 >::operator()(KTDataPtr data)
+    void KTSlotDataTwoTypes< XDataType1, XDataType2 >::operator()(const KTDataPtr& data)
     {
         // Standard data slot pattern:
         // Check to ensure that the required data type is present
@@ -436,7 +438,7 @@ namespace Nymph
     }
 
     template< class XDataType1, class XDataType2, class XDataType3 >
-    void KTSlotDataThreeTypes< XDataType1, XDataType2, XDataType3 >::operator()(KTDataPtr data)
+    void KTSlotDataThreeTypes< XDataType1, XDataType2, XDataType3 >::operator()(const KTDataPtr& data)
     {
         // Standard data slot pattern:
         // Check to ensure that the required data type is present
@@ -470,6 +472,123 @@ namespace Nymph
     }
 
 
+    /*!
+     @class KTSlotDataBatch
+     @author N. S. Oblath
+
+     @brief Creates a slot that takes a batch of KTDataPtr objects (KTDataPtrBatch); the function that gets called should take const std::vector< DataType* >& as its argument.
+
+     @details
+     Usage:
+     This slot type adds the slot function (signature void (const KTDataPtrBatch&)), which should be connected to a KTSignalDataBatch.
+     Your processor (or, optionally, a different object) must have a member function with the signature bool (const std::vector< DataType* >&).
+     The slot function collects the DataType objects from the data in the batch, and then calls the member function once for the whole batch.
+
+     Data objects that don't contain DataType are left out of the batch; a single error is reported for each batch in which that happens.
+
+     In your Processor's header add a member variable of type KTSlotDataBatch< DataType >.
+     The variable may be private.
+
+     Initialize the slot with the name of the slot, the address of the owner of the slot function, and the function pointer.
+     Optionally, if the Processor is separate from the owner of the slot function, the Processor address is specified as the second argument to the constructor.
+
+     Also optionally, a batch signal to be emitted after the return of the member function can be specified as the last argument.
+     The signal is emitted with the data objects that were passed to the member function.
+    */
+    template< class XDataType >
+    class KTSlotDataBatch
+    {
+        public:
+            typedef XDataType data_type;
+            typedef std::vector< data_type* > data_batch_type;
+            typedef boost::function< void (const KTDataPtrBatch&) > function_signature;
+            typedef typename function_signature::result_type return_type;
+            typedef typename function_signature::argument_type argument_type;
+
+        public:
+            /// Constructor for the case where the processor has the function that will be called by the slot
+            template< class XFuncOwnerType >
+            KTSlotDataBatch(const std::string& name, XFuncOwnerType* owner, bool (XFuncOwnerType::*func)(const data_batch_type&), KTSignalDataBatch* signalPtr=NULL);
+            /// Constructor for the case where the processor and the object with the function that will be called are different
+            template< class XFuncOwnerType >
+            KTSlotDataBatch(const std::string& name, KTProcessor* proc, XFuncOwnerType* owner, bool (XFuncOwnerType::*func)(const data_batch_type&), KTSignalDataBatch* signalPtr=NULL);
+            virtual ~KTSlotDataBatch();
+
+            void operator()(const KTDataPtrBatch& batch);
+
+        protected:
+            boost::function< bool (const data_batch_type&) > fFunc;
+
+            KTSignalDataBatch* fSignalPtr;
+    };
+
+    template< class XDataType >
+    template< class XFuncOwnerType >
+    KTSlotDataBatch< XDataType >::KTSlotDataBatch(const std::string& name, XFuncOwnerType* owner, bool (XFuncOwnerType::*func)(const data_batch_type&), KTSignalDataBatch* signalPtr) :
+            fFunc(boost::bind(func, owner, _1)),
+            fSignalPtr(signalPtr)
+    {
+        owner->RegisterSlot(name, this, &KTSlotDataBatch::operator());
+    }
+
+    template< class XDataType >
+    template< class XFuncOwnerType >
+    KTSlotDataBatch< XDataType >::KTSlotDataBatch(const std::string& name, KTProcessor* proc, XFuncOwnerType* owner, bool (XFuncOwnerType::*func)(const data_batch_type&), KTSignalDataBatch* signalPtr) :
+            fFunc(boost::bind(func, owner, _1)),
+            fSignalPtr(signalPtr)
+    {
+        proc->RegisterSlot(name, this, &KTSlotDataBatch::operator());
+    }
+
+    template< class XDataType >
+    KTSlotDataBatch< XDataType >::~KTSlotDataBatch()
+    {
+    }
+
+    template< class XDataType >
+    void KTSlotDataBatch< XDataType >::operator()(const KTDataPtrBatch& batch)
+    {
+        // Batch version of the standard data slot pattern:
+        // Collect the data objects that have the required type;
+        // the pointers to those data objects are only copied into a new batch if some are missing the type
+        data_batch_type typedData;
+        typedData.reserve(batch.size());
+        bool allHaveType = true;
+        KTDataPtrBatch passedData;
+        for (KTDataPtrBatch::const_iterator it = batch.begin(); it != batch.end(); ++it)
+        {
+            if (! (*it)->Has< data_type >())
+            {
+                if (allHaveType)
+                {
+                    passedData.assign(batch.begin(), it);
+                    allHaveType = false;
+                }
+                continue;
+            }
+            typedData.push_back(&(*it)->Of< data_type >());
+            if (! allHaveType) passedData.push_back(*it);
+        }
+        if (! allHaveType)
+        {
+            KTERROR(slotlog, batch.size() - typedData.size() << " of " << batch.size() << " data objects in the batch did not have type <" << typeid(data_type).name() << ">");
+            if (typedData.empty()) return;
+        }
+        // Call the function
+        if (! fFunc(typedData))
+        {
+            KTERROR(slotlog, "Something went wrong while analyzing a batch of data with type <" << typeid(data_type).name() << ">");
+            return;
+        }
+        // If there's a signal pointer, emit the signal
+        if (fSignalPtr != NULL)
+        {
+            (*fSignalPtr)(allHaveType ? batch : passedData);
+        }
+        return;
+    }
+
+
     /*!
      @class KTDoneSlot
      @author N. S. Oblath
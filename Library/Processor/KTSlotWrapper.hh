@@ -8,11 +8,13 @@
 #ifndef KTSLOTWRAPPER_HH_
 #define KTSLOTWRAPPER_HH_
 
+#include "KTAsyncStage.hh"
 #include "KTConnection.hh"
+#include "KTConnectionStats.hh"
+#include "KTDataPredicate.hh"
 #include "KTSignalWrapper.hh"
 
 #include <boost/function.hpp>
-#include <boost/signals2.hpp>
 
 namespace Nymph
 {
@@ -31,7 +33,10 @@ namespace Nymph
                     KTInternalSlotWrapper() {}
                     virtual ~KTInternalSlotWrapper() {}
 
-                    virtual KTConnection Connect(KTSignalWrapper* signalWrap, int groupNum=-1) = 0;
+                    /// If stage is set, calls to the slot are queued on that stage instead of being made directly
+                    /// If stats is set, each call to the slot is recorded in it
+                    /// If predicate is set, the slot is only called for data that satisfy it; this requires a data slot
+                    virtual KTConnection Connect(KTSignalWrapper* signalWrap, int groupNum=-1, boost::shared_ptr< KTAsyncStage > stage=boost::shared_ptr< KTAsyncStage >(), boost::shared_ptr< KTConnectionStats > stats=boost::shared_ptr< KTConnectionStats >(), const KTDataPredicate& predicate=KTDataPredicate()) = 0;
             };
 
             template< typename XSignature, typename XTypeContainer >
@@ -48,10 +53,11 @@ namespace Nymph
                         delete fSlot;
                     }
 
-                    virtual KTConnection Connect(KTSignalWrapper* signalWrap, int groupNum=-1)
+                    virtual KTConnection Connect(KTSignalWrapper* signalWrap, int groupNum=-1, boost::shared_ptr< KTAsyncStage > stage=boost::shared_ptr< KTAsyncStage >(), boost::shared_ptr< KTConnectionStats > stats=boost::shared_ptr< KTConnectionStats >(), const KTDataPredicate& predicate=KTDataPredicate())
                     {
+                        typedef typename XTypeContainer::signature Signature;
                         typedef KTSignalWrapper::KTInternalSignalWrapper SignalWrapperBase;
-                        typedef KTSignalWrapper::KTSpecifiedInternalSignalWrapper< typename XTypeContainer::signal > SignalWrapper;
+                        typedef KTSignalWrapper::KTSpecifiedInternalSignalWrapper< typename XTypeContainer::signature > SignalWrapper;
 
                         SignalWrapperBase* internalSignalWrap = signalWrap->GetInternal();
                         SignalWrapper* derivedSignalWrapper = dynamic_cast< SignalWrapper* >(internalSignalWrap);
@@ -59,11 +65,22 @@ namespace Nymph
                         {
                             throw SignalException("In KTSpecifiedInternalSlotWrapper::Connect:\nUnable to cast from KTInternalSignalWrapper* to derived type.");
                         }
-                        if (groupNum >= 0)
+                        // the profiling forwarder goes inside the asynchronous one, so that it times the slot itself
+                        boost::function< Signature > slot = *fSlot;
+                        if (stats)
                         {
-                            return derivedSignalWrapper->GetSignal()->connect(groupNum, *fSlot);
+                            slot = KTProfiledSlotForwarder< Signature >(slot, stats);
                         }
-                        return derivedSignalWrapper->GetSignal()->connect(*fSlot);
+                        // the predicate is checked before calls are queued, so that data that don't qualify are never queued
+                        if (predicate && ! KTFilterSlot(slot, predicate))
+                        {
+                            throw SlotException("In KTSpecifiedInternalSlotWrapper::Connect:\nA predicate was given for a slot that does not take a KTDataPtr.");
+                        }
+                        if (stage)
+                        {
+                            return derivedSignalWrapper->GetSignal()->Connect(KTAsyncSlotForwarder< Signature >(slot, stage), groupNum, groupNum >= 0);
+                        }
+                        return derivedSignalWrapper->GetSignal()->Connect(slot, groupNum, groupNum >= 0);
                     }
 
                 private:
@@ -82,7 +99,7 @@ namespace Nymph
 
         public:
             void SetConnection(KTConnection conn);
-            void SetConnection(KTSignalWrapper* signalWrap, int groupNum=-1);
+            void SetConnection(KTSignalWrapper* signalWrap, int groupNum=-1, boost::shared_ptr< KTAsyncStage > stage=boost::shared_ptr< KTAsyncStage >(), boost::shared_ptr< KTConnectionStats > stats=boost::shared_ptr< KTConnectionStats >(), const KTDataPredicate& predicate=KTDataPredicate());
             void Disconnect();
 
         private:
@@ -102,9 +119,9 @@ namespace Nymph
         return;
     }
 
-    inline void KTSlotWrapper::SetConnection(KTSignalWrapper* signalWrap, int groupNum)
+    inline void KTSlotWrapper::SetConnection(KTSignalWrapper* signalWrap, int groupNum, boost::shared_ptr< KTAsyncStage > stage, boost::shared_ptr< KTConnectionStats > stats, const KTDataPredicate& predicate)
     {
-        fConnection = this->fSlotWrapper->Connect(signalWrap, groupNum);
+        fConnection = this->fSlotWrapper->Connect(signalWrap, groupNum, stage, stats, predicate);
         return;
     }
 
@@ -0,0 +1,222 @@
+/**
+ @file KTStaticChain.hh
+ @brief Contains KTStaticChain
+ @details Runs a chain of processors that is fixed at compile time as a single processor
+ @author: N. S. Oblath
+ @date: Oct 18, 2026
+ */
+
+#ifndef KTSTATICCHAIN_HH_
+#define KTSTATICCHAIN_HH_
+
+#include "KTProcessor.hh"
+
+#include "KTData.hh"
+#include "KTLogger.hh"
+#include "KTSignal.hh"
+
+#include <string>
+#include <tuple>
+#include <typeinfo>
+
+namespace Nymph
+{
+    KTLOGGER(chainlog, "KTStaticChain.hh");
+
+    /*!
+     @class KTChainStage
+     @author N. S. Oblath
+
+     @brief Describes one step of a KTStaticChain: the processor type, the data type it works on, and the member function to call.
+
+     @details
+     The member function has the same form as the functions used with KTSlotDataOneType: bool (XDataType&).
+     Because the function is a template argument, the call is resolved at compile time and can be inlined.
+
+     Example:
+         typedef KTChainStage< KTMyProcessor, KTMyData, &KTMyProcessor::Analyze > MyStage;
+    */
+    template< class XProcessor, class XDataType, bool (XProcessor::*XFunction)(XDataType&) >
+    struct KTChainStage
+    {
+        typedef XProcessor processor_type;
+        typedef XDataType data_type;
+
+        static bool Run(processor_type& proc, KTData& data);
+    };
+
+    template< class XProcessor, class XDataType, bool (XProcessor::*XFunction)(XDataType&) >
+    inline bool KTChainStage< XProcessor, XDataType, XFunction >::Run(processor_type& proc, KTData& data)
+    {
+        if (! data.Has< data_type >())
+        {
+            KTERROR(chainlog, "Data not found with type <" << typeid(data_type).name() << ">");
+            return false;
+        }
+        if (! (proc.*XFunction)(data.Of< data_type >()))
+        {
+            KTERROR(chainlog, "Something went wrong in processor <" << proc.GetConfigName() << "> while analyzing data with type <" << typeid(data_type).name() << ">");
+            return false;
+        }
+        return true;
+    }
+
+
+    /// Recursion over the stages of a KTStaticChain; XIndex is the position of XFirst in the chain
+    template< unsigned XIndex, class... XStages >
+    struct KTStaticChainLink;
+
+    template< unsigned XIndex, class XFirst, class... XRest >
+    struct KTStaticChainLink< XIndex, XFirst, XRest... >
+    {
+        template< class XProcessors >
+        static bool Run(XProcessors& procs, KTData& data)
+        {
+            return XFirst::Run(std::get< XIndex >(procs), data) && KTStaticChainLink< XIndex + 1, XRest... >::Run(procs, data);
+        }
+
+        template< class XProcessors >
+        static bool Configure(XProcessors& procs, const scarab::param_node& node)
+        {
+            KTProcessor& proc = std::get< XIndex >(procs);
+            if (node.has(proc.GetConfigName()))
+            {
+                if (! proc.Configure(node[proc.GetConfigName()].as_node()))
+                {
+                    KTERROR(chainlog, "An error occurred while configuring processor <" << proc.GetConfigName() << ">");
+                    return false;
+                }
+            }
+            else
+            {
+                KTDEBUG(chainlog, "No configuration found for processor <" << proc.GetConfigName() << ">");
+            }
+            return KTStaticChainLink< XIndex + 1, XRest... >::Configure(procs, node);
+        }
+    };
+
+    template< unsigned XIndex >
+    struct KTStaticChainLink< XIndex >
+    {
+        template< class XProcessors >
+        static bool Run(XProcessors&, KTData&)
+        {
+            return true;
+        }
+
+        template< class XProcessors >
+        static bool Configure(XProcessors&, const scarab::param_node&)
+        {
+            return true;
+        }
+    };
+
+
+    /*!
+     @class KTStaticChain
+     @author N. S. Oblath
+
+     @brief Runs a fixed sequence of processors on each data object, without going through signals and slots between them.
+
+     @details
+     Connections made through the processor toolbox go through a KTSignalData and a boost::function for every step,
+     which keeps the compiler from inlining across processors.  For a chain of processors whose topology never changes,
+     KTStaticChain calls each stage's member function directly, in the order given (see KTChainStage).
+     If a stage fails (its data type is missing or its function returns false), the rest of the chain is skipped and the signal is not emitted.
+
+     The chain owns one instance of each processor, which is default-constructed.
+     The chain itself is a KTProcessor, so it can be registered and used in the toolbox like any other:
+         typedef KTStaticChain< KTChainStage< KTProcA, KTDataA, &KTProcA::Analyze >,
+                                KTChainStage< KTProcB, KTDataB, &KTProcB::Analyze > > KTMyChain;
+         KT_REGISTER_PROCESSOR(KTMyChain, "my-chain");
+
+     The slots and signals of the processors in the chain are not available to the toolbox.
+
+     Available configuration values:
+     - "[processor config name]": subtree -- configuration for the processor with that name; processors without a subtree are not configured
+
+     Slots:
+     - "data": void (KTDataPtr) -- Runs the chain on the data
+
+     Signals:
+     - "data": void (KTDataPtr) -- Emitted after all of the stages in the chain have succeeded
+    */
+    template< class... XStages >
+    class KTStaticChain : public KTProcessor
+    {
+        public:
+            typedef std::tuple< typename XStages::processor_type... > processors_type;
+
+            static const unsigned sNStages = sizeof...(XStages);
+
+        public:
+            KTStaticChain(const std::string& name = "static-chain");
+            virtual ~KTStaticChain();
+
+            bool Configure(const scarab::param_node& node);
+
+            /// Access to the processor in stage XIndex (counting from 0)
+            template< unsigned XIndex >
+            typename std::tuple_element< XIndex, processors_type >::type& GetProcessor();
+
+        public:
+            /// Runs the chain on the data; returns false if any stage failed
+            bool Process(KTData& data);
+
+            void ProcessData(const KTDataPtr& data);
+
+        private:
+            processors_type fProcessors;
+
+            //***************
+            // Signals
+            //***************
+
+        private:
+            KTSignalData fDataSignal;
+
+    };
+
+    template< class... XStages >
+    KTStaticChain< XStages... >::KTStaticChain(const std::string& name) :
+            KTProcessor(name),
+            fProcessors(),
+            fDataSignal("data", this)
+    {
+        RegisterSlot("data", this, &KTStaticChain::ProcessData);
+    }
+
+    template< class... XStages >
+    KTStaticChain< XStages... >::~KTStaticChain()
+    {
+    }
+
+    template< class... XStages >
+    bool KTStaticChain< XStages... >::Configure(const scarab::param_node& node)
+    {
+        return KTStaticChainLink< 0, XStages... >::Configure(fProcessors, node);
+    }
+
+    template< class... XStages >
+    template< unsigned XIndex >
+    inline typename std::tuple_element< XIndex, typename KTStaticChain< XStages... >::processors_type >::type& KTStaticChain< XStages... >::GetProcessor()
+    {
+        return std::get< XIndex >(fProcessors);
+    }
+
+    template< class... XStages >
+    inline bool KTStaticChain< XStages... >::Process(KTData& data)
+    {
+        return KTStaticChainLink< 0, XStages... >::Run(fProcessors, data);
+    }
+
+    template< class... XStages >
+    void KTStaticChain< XStages... >::ProcessData(const KTDataPtr& data)
+    {
+        if (! Process(*data)) return;
+        fDataSignal(data);
+        return;
+    }
+
+} /* namespace Nymph */
+#endif /* KTSTATICCHAIN_HH_ */
@@ -0,0 +1,103 @@
+/*
+ * KTArena.cc
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: nsoblath
+ */
+
+#include "KTArena.hh"
+
+#include <new>
+
+namespace Nymph
+{
+    namespace
+    {
+        const std::size_t sAlignment = alignof(std::max_align_t);
+
+        inline std::size_t AlignedSize(std::size_t size)
+        {
+            return (size + sAlignment - 1) & ~(sAlignment - 1);
+        }
+    }
+
+    KTArena::KTArena(std::size_t blockSize) :
+            fBlockSize(AlignedSize(blockSize)),
+            fBlocks(),
+            fCurrent(NULL),
+            fRemaining(0),
+            fBytesAllocated(0),
+            fNReferences(1)
+    {
+    }
+
+    KTArena::~KTArena()
+    {
+        for (std::vector< char* >::iterator it = fBlocks.begin(); it != fBlocks.end(); ++it)
+        {
+            ::operator delete(*it);
+        }
+    }
+
+    void* KTArena::Allocate(std::size_t size)
+    {
+        size = AlignedSize(size);
+        void* ptr = NULL;
+        if (size > fBlockSize)
+        {
+            // oversized objects get their own block, and the current block stays in use
+            char* block = static_cast< char* >(::operator new(size));
+            fBlocks.push_back(block);
+            ptr = block;
+        }
+        else
+        {
+            if (size > fRemaining)
+            {
+                fCurrent = static_cast< char* >(::operator new(fBlockSize));
+                fBlocks.push_back(fCurrent);
+                fRemaining = fBlockSize;
+            }
+            ptr = fCurrent;
+            fCurrent += size;
+            fRemaining -= size;
+        }
+        fBytesAllocated += size;
+        ++fNReferences;
+        return ptr;
+    }
+
+    void KTArena::Deallocate(void*)
+    {
+        RemoveReference();
+        return;
+    }
+
+    void KTArena::Release()
+    {
+        RemoveReference();
+        return;
+    }
+
+    void KTArena::Reset()
+    {
+        if (fBlocks.empty()) return;
+        for (std::vector< char* >::iterator it = fBlocks.begin() + 1; it != fBlocks.end(); ++it)
+        {
+            ::operator delete(*it);
+        }
+        fBlocks.resize(1);
+        // the first block might be an oversized one, but it's at least as big as a regular block
+        fCurrent = fBlocks.front();
+        fRemaining = fBlockSize;
+        fBytesAllocated = 0;
+        return;
+    }
+
+    void KTArena::RemoveReference()
+    {
+        if (--fNReferences == 0) delete this;
+        return;
+    }
+
+} /* namespace Nymph */
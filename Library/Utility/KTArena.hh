@@ -0,0 +1,100 @@
+/*
+ * KTArena.hh
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: nsoblath
+ */
+
+#ifndef KTARENA_HH_
+#define KTARENA_HH_
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+namespace Nymph
+{
+    /*!
+     @class KTArena
+     @author N. S. Oblath
+
+     @brief Bump allocator for a group of objects that are freed together.
+
+     @details
+     Memory is handed out sequentially from blocks of a fixed size; an allocation that doesn't fit in a block gets a block of its own.
+     Individual allocations are never freed: all of the blocks are freed at once when the arena is destroyed,
+     and Reset() rewinds the arena so that the first block can be used again.
+
+     The arena is reference counted: it's created with one reference, for its owner, and each allocation adds another.
+     Deallocate() and Release() remove one, and the arena deletes itself when the last one is removed.
+     This way objects allocated in the arena can safely outlive the owner.
+     Allocate() and Reset() are not thread-safe; Deallocate() and Release() are.
+
+     An arena can back the objects in a KTExtensibleStruct chain (see KTExtensibleStructCore::UseArena()).
+    */
+    class KTArena
+    {
+        public:
+            /// Creates an arena with one reference, which is removed with Release(); arenas must be created with new
+            KTArena(std::size_t blockSize = sDefaultBlockSize);
+
+        private:
+            KTArena(const KTArena&);
+            KTArena& operator=(const KTArena&);
+            ~KTArena();
+
+        public:
+            /// Returns memory for an object of the given size, suitably aligned for any type
+            void* Allocate(std::size_t size);
+            /// Signals that an object allocated in the arena has been destroyed; the memory is not reused until Reset()
+            void Deallocate(void* ptr);
+
+            /// Removes the owner's reference
+            void Release();
+
+            /// Returns true if no allocated objects are outstanding (i.e. only the owner's reference is left)
+            bool IsUnused() const;
+            /// Frees all but the first block and rewinds the arena; may only be called when IsUnused() is true
+            void Reset();
+
+            std::size_t GetBlockSize() const;
+            std::size_t GetNBlocks() const;
+            /// Number of bytes handed out since the arena was created or last reset
+            std::size_t GetBytesAllocated() const;
+
+            static const std::size_t sDefaultBlockSize = 4096;
+
+        private:
+            void RemoveReference();
+
+            std::size_t fBlockSize;
+            std::vector< char* > fBlocks;
+            char* fCurrent;
+            std::size_t fRemaining;
+            std::size_t fBytesAllocated;
+
+            std::atomic< unsigned > fNReferences;
+    };
+
+    inline bool KTArena::IsUnused() const
+    {
+        return fNReferences.load() == 1;
+    }
+
+    inline std::size_t KTArena::GetBlockSize() const
+    {
+        return fBlockSize;
+    }
+
+    inline std::size_t KTArena::GetNBlocks() const
+    {
+        return fBlocks.size();
+    }
+
+    inline std::size_t KTArena::GetBytesAllocated() const
+    {
+        return fBytesAllocated;
+    }
+
+} /* namespace Nymph */
+#endif /* KTARENA_HH_ */
@@ -21,6 +21,7 @@
 #include <boost/thread.hpp>
 
 #include <deque>
+#include <utility>
 
 namespace Nymph
 {
@@ -82,6 +83,17 @@ namespace Nymph
                 return;
             }
 
+            void push(XDataType&& data)
+            {
+                KTDEBUG(queuelog, "Attempting to push to queue");
+                ScopedLock lock(fMutex);
+                KTDEBUG(queuelog, "Pushing to concurrent queue; size: " << fQueue.size());
+                fQueue.push_back(std::move(data));
+                lock.unlock();
+                fConditionVar.notify_one();
+                return;
+            }
+
             bool empty() const
             {
                 ScopedLock lock(fMutex);
@@ -103,7 +115,7 @@ namespace Nymph
                     return false;
                 }
 
-                popped_value=fQueue.front();
+                popped_value = std::move(fQueue.front());
                 fQueue.pop_front();
                 return true;
             }
@@ -119,7 +131,7 @@ namespace Nymph
                     return false;
                 }
 
-                popped_value=fQueue.front();
+                popped_value = std::move(fQueue.front());
                 fQueue.pop_front();
                 KTDEBUG(queuelog, "Popping from concurrent queue; size: " << fQueue.size());
                 return true;
@@ -141,7 +153,7 @@ namespace Nymph
                     return false;
                 }
 
-                popped_value=fQueue.front();
+                popped_value = std::move(fQueue.front());
                 fQueue.pop_front();
                 KTDEBUG(queuelog, "Popping from concurrent queue; size: " << fQueue.size());
                 return true;
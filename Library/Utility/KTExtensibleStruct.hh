@@ -9,15 +9,108 @@
 #ifndef KTEXTENSIBLESTRUCT_HH_
 #define KTEXTENSIBLESTRUCT_HH_
 
+#include "KTArena.hh"
+#include "KTMemoryAccounting.hh"
+
+#include <boost/core/demangle.hpp>
+#include <boost/function.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/locks.hpp>
+#include <boost/thread/mutex.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <string>
+#include <typeinfo>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
 namespace Nymph
 {
 
     // *) operator= reallocates extended fields: to avoid this, use Pull().
 
     /**
+     * Each extension type (XInstanceType of a KTExtensibleStruct) is given a dense integer id the first time it's used;
+     * ids are shared by all of the extensible structs with the same base type.
+     * The first object in a chain keeps an index from type id to the first object of that type in the chain,
+     * so Of(), Has(), and Detatch() called on the first object are constant-time lookups without RTTI.
+     * When they're called on an object further down the chain, the chain is walked from that object, comparing type ids.
+     *
+     * The index is kept up to date as objects are added to and removed from the chain.
+     *
+     * Adding objects with Of() and Get() is thread-safe: several threads can add objects to the same chain at once (e.g. the slots of a
+     * parallel group, see KTSignalData), while others look up the objects that are already there with Has(), Find(), Of(), and Get()
+     * on the first object of the chain (e.g. a KTData).
+     * Adding an object locks the chain (chains share a fixed set of locks, so no memory is spent on them); looking an object up takes no lock.
+     * The functions that change a chain in other ways (Detatch(), Attach(), Splice(), Clear(), copying, assigning, moving, and making a private copy
+     * of a shared object) must not be used while anything else uses the chain, and neither must walking the chain with Next().
+     * Objects are looked up by their exact type, so XStructType in Of(), Get(), Has(), Detatch(), Attach(), and Splice() must be the instance type
+     * of an extensible struct (i.e. XInstanceType); a class derived from one isn't a type of its own, and is rejected at compile time.
+     *
+     * The objects in a chain can be allocated in an arena (see UseArena()) instead of individually on the heap,
+     * in which case the memory for all of them is freed at once when the first object is destroyed.
+     * Each object records where it was allocated, so an object detatched from a chain can still be deleted as usual.
+     *
+     * The state of the chain as a whole (the index, the arena, the shared objects, and the copy-on-write flag) is kept in a head
+     * that's allocated separately and only pointed to by the first object, so the other objects in the chain only pay for a pointer.
+     * The head is made the first time it's needed (e.g. when a second object is added to the chain).
+     * So that objects can be looked up while others are being added, the index is never resized in place: one that's too small for a new type
+     * is replaced with a bigger one, and the old one is kept until the chain is next changed by a function that can't be used concurrently.
+     *
+     * Copy-on-write: when a chain is copied and its first object has SetIsCopyOnWrite(true), the copy shares the objects of the original
+     * instead of cloning them.  The shared objects are immutable, and belong to both chains until one of them modifies them:
+     *  - A non-const Of() or Detatch() of a shared object makes a private copy of it first.  So that the order of the chain is preserved,
+     *    the shared objects in front of it are copied as well (the most recently added objects are in front).
+     *  - New objects are added after the private objects in the chain, and in front of the shared ones.
+     *  - Once no other chain uses a group of shared objects, the chain takes them back without copying them.
+     *  - Unshare() makes private copies of all of the shared objects in the chain.
+     * Shared objects are reached with Next() and const Of() like any other, but must not be modified, and their Prev() is not meaningful.
+     * Copies of a copy-on-write chain may be made concurrently, but not while the chain is being modified.
      *
+     * Moving the first object of a chain (with the move constructor or move assignment) splices the rest of the chain,
+     * along with its index, arena, and shared objects, onto the new object without copying anything; the object moved from is left as a chain by itself.
+     * An object that isn't the first in its chain can't give up the rest of the chain, so moving it copies the rest of the chain as usual.
+     *
+     * Objects can be moved between chains without copying them with Attach(), Splice(), and SpliceAll().  An object moved into a chain replaces
+     * the object of the same type that's already there, if there is one (other than the first object in the chain), and is otherwise added to the end.
+     * Objects allocated in another chain's arena keep that arena alive until they're deleted.  Shared objects are copied when they're moved out of a chain.
+     *
+     * Objects that are derived from others in the chain can be made on demand: a generator set for a type (with SetGenerator(), or
+     * KT_REGISTER_GENERATOR in KTExtensibleStructFactory.hh) is run by Get() the first time that type is requested from a chain that doesn't have it.
+     * The generator fills in a new object from the rest of the chain, which is then added to the chain, so it's only run once for each chain.
+     * The generator is run without the chain being locked; if two threads make the same object at once, the one that's added to the chain first is kept.
+     *
+     * When memory accounting is enabled (see KTMemoryAccounting), each object is recorded in the account for its type when it's constructed,
+     * and removed from it when it's destroyed.  The account is named with KTExtensibleStructName.
+     * Types that own memory outside of the object (e.g. the contents of a std::vector) should override OwnedBytes();
+     * the owned bytes of the objects in a chain are recorded when UpdateAccounts() is called on it.
      */
 
+    /// Name of an extensible struct type used for memory accounting: XType::sName if it has one, and otherwise the name of the C++ type
+    template< class XType, class = void >
+    struct KTExtensibleStructName
+    {
+        static std::string Get()
+        {
+            return boost::core::demangle(typeid(XType).name());
+        }
+    };
+
+    template< class XType >
+    struct KTExtensibleStructName< XType, decltype((void)XType::sName) >
+    {
+        static std::string Get()
+        {
+            return XType::sName;
+        }
+    };
+
     template< class XBaseType >
     struct KTExtensibleStructCore : public XBaseType
     {
@@ -26,19 +119,35 @@ namespace Nymph
             KTExtensibleStructCore(void);
             /// Copy constructor; duplicates the extended object
             KTExtensibleStructCore(const KTExtensibleStructCore&);
+            /// Move constructor; takes the rest of the chain if the object is the first in its chain
+            KTExtensibleStructCore(KTExtensibleStructCore&& object);
             virtual ~KTExtensibleStructCore();
             /// Duplicates the extended object
             KTExtensibleStructCore& operator=(const KTExtensibleStructCore&);
+            /// Replaces the extended object with the rest of the chain of the object, if both are the first in their chains
+            KTExtensibleStructCore& operator=(KTExtensibleStructCore&& object);
             /// Removes extended fields
             virtual void Clear(void);
             /// Returns a reference to the object of type XStructType; creates that object if it doesn't exist
             template< class XStructType > inline XStructType& Of(void);
             /// Returns a const reference to the object of type XStructType; creates that object if it doesn't exist
             template< class XStructType > inline const XStructType& Of(void) const;
+            /// Returns a pointer to the object of type XStructType; if it doesn't exist, it's made with the generator for XStructType.
+            /// Returns NULL if there's no generator, or if the generator fails.
+            template< class XStructType > inline XStructType* Get(void);
+            /// Returns a const pointer to the object of type XStructType; if it doesn't exist, it's made with the generator for XStructType.
+            /// Returns NULL if there's no generator, or if the generator fails.
+            template< class XStructType > inline const XStructType* Get(void) const;
             /// Returns true if XStructType is or is below this object
             template< class XStructType > inline bool Has(void) const;
             /// Extracts object of type XStructType
             template< class XStructType > inline XStructType* Detatch(void);
+            /// Adds an object that isn't in a chain (e.g. one returned by Detatch()) to this chain, and returns it; any objects after it are spliced in as well
+            template< class XStructType > inline XStructType& Attach(std::unique_ptr< XStructType > object);
+            /// Moves the object of type XStructType from the chain that the given object is in to this chain; returns NULL if there isn't one
+            template< class XStructType > inline XStructType* Splice(KTExtensibleStructCore& from);
+            /// Moves all of the objects after the first one from the chain that the given object is in to this chain
+            void SpliceAll(KTExtensibleStructCore& from);
             /// Duplicates the extended object
             virtual KTExtensibleStructCore* Clone(void) const = 0;
             /// Duplicates object only
@@ -51,10 +160,161 @@ namespace Nymph
             KTExtensibleStructCore* Last() const;
             /// Returns the pointer to the first field
             KTExtensibleStructCore* First() const;
+            /// Returns the type id of this object (see KTExtensibleStruct::TypeId())
+            unsigned GetTypeId() const;
+            /// Returns the first object of the type with the given id, starting with this object, or NULL if there isn't one
+            KTExtensibleStructCore* Find(unsigned typeId) const;
+            /// Like Find(), but a shared object is first replaced with a private copy, which can be modified
+            KTExtensibleStructCore* FindPrivate(unsigned typeId);
+
+            /// Allocates the objects added to this chain from now on in an arena, which is freed when the first object in the chain is destroyed.
+            /// Objects copied from another chain (in the copy constructor or operator=) are allocated on the heap.
+            void UseArena(std::size_t blockSize = KTArena::sDefaultBlockSize);
+            /// Returns the arena used by this chain, or NULL if objects are allocated on the heap
+            KTArena* GetArena() const;
+
+            /// If true, copies of this chain share its objects until either one modifies them (see above)
+            void SetIsCopyOnWrite(bool flag);
+            bool GetIsCopyOnWrite() const;
+            /// Returns true if this object is shared with other chains, in which case it must not be modified
+            bool IsShared() const;
+            /// Makes private copies of all of the shared objects in this chain
+            void Unshare();
+
+            /// Bytes of memory owned by this object beyond its own size (e.g. the contents of its containers); 0 unless overridden
+            virtual std::size_t OwnedBytes() const;
+            /// Records the current OwnedBytes() of each object in the chain that starts with this object in its memory account
+            void UpdateAccounts() const;
+
+            static void* operator new(std::size_t size);
+            static void* operator new(std::size_t size, KTArena& arena);
+            static void* operator new(std::size_t size, void* place);
+            /// Takes the size like the operator new it pairs with, which allocates a header in front of the object; it's the only usual operator delete,
+            /// so every delete of an object (from a base pointer too, through the virtual destructor) is routed through it
+            static void operator delete(void* ptr, std::size_t size);
+            static void operator delete(void* ptr, KTArena& arena);
+            static void operator delete(void* ptr, void* place);
+
         protected:
             void SetPrevPtrInNext();
+            /// Assigns the next type id
+            static unsigned NewTypeId();
+            static std::atomic< unsigned >& TypeIdCounter();
+            /// Adds the object to the end of the chain
+            void Append(KTExtensibleStructCore* object) const;
+            /// Adds the object, which has just been added to the chain that starts with this object, to the index
+            void AddToIndex(KTExtensibleStructCore* object) const;
+            /// Makes an object of type XStructType and adds it to the chain, unless another thread has just added one; returns the object of that type
+            template< class XStructType > XStructType* AddNew(void) const;
+            /// Lock held while an object is added to the chain that starts with the given object
+            static boost::mutex& AppendMutex(const KTExtensibleStructCore* first);
+            /// Number of type ids that have been assigned
+            static unsigned NTypeIds();
+            /// Rebuilds the index of the chain that starts with this object
+            void RebuildIndex() const;
+            /// Rebuilds the index of the chain that this object is in
+            void RebuildChainIndex() const;
+            /// Removes an object, which must not be the first one, from the chain it's in; the object is not deleted
+            void Unlink(KTExtensibleStructCore* object);
+
+            /// Duplicates object only, allocating the copy in the arena if one is given
+            virtual KTExtensibleStructCore* CloneObject(KTArena* arena) const = 0;
+            /// Records the current OwnedBytes() of this object in its memory account, if it's in one
+            virtual void UpdateAccount() const = 0;
+            /// Deletes the objects after this one that belong to it (i.e. that aren't shared), and ends the chain here
+            void DeleteNext();
+            /// Removes all of the objects after this one from the chain, deleting the private ones
+            void ClearNext();
+            /// Makes the rest of the chain after this object share the objects of another chain, whose first object is given
+            void ShareChain(const KTExtensibleStructCore& object);
+            /// Removes the shared objects from the chain that starts with this object
+            void DropShared();
+            /// Replaces a shared object, and the shared objects in front of it, with private copies in the chain that starts with this object
+            KTExtensibleStructCore* MakePrivate(KTExtensibleStructCore* object);
+            /// Last object that isn't shared in the chain that starts with this object
+            KTExtensibleStructCore* LastPrivate() const;
+            /// Returns true if the rest of the chain can be moved from the object to this one (i.e. both are the first in their chains)
+            bool CanTakeChain(const KTExtensibleStructCore& object) const;
+            /// Moves the rest of the chain, and everything kept by the first object, from the object to this one, which must have no objects after it
+            void TakeChain(KTExtensibleStructCore& object);
+            /// Adds an object that isn't in a chain to the chain that this object is in, replacing the object of the same type
+            void AttachObject(KTExtensibleStructCore* object);
+            /// Makes an object of type XStructType with its generator and adds it to the chain; returns NULL if that isn't possible
+            template< class XStructType > XStructType* Generate(void) const;
+
             mutable KTExtensibleStructCore* fNext;
             mutable KTExtensibleStructCore* fPrev;
+            static const unsigned sNoTypeId = ~0u;
+
+            // A group of objects that were private to one chain when it was copied, and are now shared.
+            // Each refers to the group that followed it, so the groups in a chain are kept in order.
+            struct SharedGroup
+            {
+                SharedGroup(KTExtensibleStructCore* first, const boost::shared_ptr< SharedGroup >& next);
+                ~SharedGroup();
+
+                KTExtensibleStructCore* fFirst;
+                boost::shared_ptr< SharedGroup > fNext;
+            };
+
+            /// Moves groups that no other chain uses back into the chain that starts with this object
+            void ReclaimShared();
+            /// Makes the private objects of the chain that starts with this object into a shared group
+            void Share() const;
+            /// Lock for making and reading shared groups
+            static boost::mutex& SharingMutex();
+
+            // group that this object belongs to, or NULL if it's private
+            mutable SharedGroup* fGroup;
+
+            // First object of each type in the chain, by type id
+            struct Index
+            {
+                explicit Index(unsigned size);
+
+                unsigned fSize;
+                // atomic, since objects can be looked up while others are added
+                std::unique_ptr< std::atomic< KTExtensibleStructCore* >[] > fEntries;
+            };
+
+            // State of the chain as a whole, which is only kept by its first object
+            struct ChainHead
+            {
+                ChainHead();
+                ~ChainHead();
+
+                /// Deletes the index and the ones it replaced
+                void ClearIndex();
+
+                // NULL if the chain has never had more than one object
+                std::atomic< Index* > fIndex;
+                // indexes that were replaced while they could have been in use
+                std::vector< Index* > fOldIndexes;
+                KTArena* fArena;
+                // the group of the first shared object in the chain
+                boost::shared_ptr< SharedGroup > fShared;
+                bool fIsCopyOnWrite;
+            };
+
+            /// Returns the head of the chain that starts with this object, making it if it doesn't exist yet
+            ChainHead& Head() const;
+            /// Returns the head of this object, or NULL if it doesn't have one
+            ChainHead* GetHead() const;
+            /// Deletes the head of this object, which is about to be added to a chain
+            void DeleteHead() const;
+
+            // NULL until it's needed, and in all but the first object of a chain; atomic because it's made while objects can be looked up
+            mutable std::atomic< ChainHead* > fHead;
+            // after the pointers, so that the members of the derived classes can fill the padding
+            unsigned fTypeId;
+
+        private:
+            // Precedes each object allocated with new, and records the arena it was allocated in (NULL for the heap)
+            union AllocationHeader
+            {
+                KTArena* fArena;
+                std::max_align_t fAlignment;
+            };
     };
 
 
@@ -67,136 +327,874 @@ namespace Nymph
             KTExtensibleStruct(void);
             /// Copy constructor; duplicates the extended object
             KTExtensibleStruct(const KTExtensibleStruct& object);
+            /// Move constructor; takes the rest of the chain if the object is the first in its chain, and otherwise duplicates it
+            KTExtensibleStruct(KTExtensibleStruct&& object);
             virtual ~KTExtensibleStruct();
             /// Duplicates the extended object
             KTExtensibleStruct& operator=(const KTExtensibleStruct& object);
+            /// Takes the rest of the chain if both objects are the first in their chains, and otherwise duplicates it
+            KTExtensibleStruct& operator=(KTExtensibleStruct&& object);
             /// Duplicates the extended object
             virtual KTExtensibleStructCore< XBaseType >* Clone(void) const;
             /// Duplicates object only
             virtual void Pull(const KTExtensibleStructCore< XBaseType >& object);
             void SetIsCopyDisabled(bool flag);
+        protected:
+            virtual KTExtensibleStructCore< XBaseType >* CloneObject(KTArena* arena) const;
+            virtual void UpdateAccount() const;
+        public:
+            /// Type id of XInstanceType; assigned the first time it's requested
+            static unsigned TypeId();
+
+            /// Fills in a new XInstanceType object from the chain it will be added to (given by its first object); returns false if that isn't possible
+            typedef boost::function< bool (XInstanceType&, const KTExtensibleStructCore< XBaseType >&) > Generator;
+            /// Sets the function used by Get() to make XInstanceType objects on demand; an empty function removes the generator
+            static void SetGenerator(const Generator& generator);
+            static const Generator& GetGenerator();
         private:
             bool fIsCopyDisabled;
+            static Generator& GeneratorInstance();
+
+            /// Records this object in the memory account for XInstanceType if accounting is enabled
+            void AddToAccount();
+            static KTMemoryAccount& Account();
+            // true if this object was recorded in the memory account
+            bool fIsAccounted;
+            // owned bytes last recorded in the memory account; atomic because shared objects can be recorded from more than one chain
+            mutable std::atomic< std::size_t > fAccountedOwnedBytes;
     };
 
 
 
+    /// True if XStructType is the XInstanceType of a KTExtensibleStruct with base type XBaseType, and can therefore be looked up in a chain
+    template< class XStructType, class XBaseType >
+    struct KTIsExtensibleStructInstance : std::is_base_of< KTExtensibleStruct< XStructType, XBaseType >, XStructType >
+    {};
+
+
+
     template<class XBaseType>
-    KTExtensibleStructCore<XBaseType>::KTExtensibleStructCore(void)
+    KTExtensibleStructCore<XBaseType>::KTExtensibleStructCore(void) :
+            fGroup(0),
+            fHead(0),
+            fTypeId(sNoTypeId)
     {
         fPrev = 0;
         fNext = 0;
     }
 
     template<class XBaseType>
-    KTExtensibleStructCore<XBaseType>::KTExtensibleStructCore(const KTExtensibleStructCore&)
+    KTExtensibleStructCore<XBaseType>::KTExtensibleStructCore(const KTExtensibleStructCore&) :
+            XBaseType(),
+            fGroup(0),
+            fHead(0),
+            fTypeId(sNoTypeId)
     {
         fPrev = 0;
         fNext = 0;
     }
 
     template<class XBaseType>
-    KTExtensibleStructCore<XBaseType>::~KTExtensibleStructCore()
+    KTExtensibleStructCore<XBaseType>::KTExtensibleStructCore(KTExtensibleStructCore&& object) :
+            XBaseType(),
+            fGroup(0),
+            fHead(0),
+            fTypeId(object.fTypeId)
     {
-        delete fNext;
+        fPrev = 0;
         fNext = 0;
+        // otherwise the derived class duplicates the rest of the chain
+        if (CanTakeChain(object)) TakeChain(object);
+    }
+
+    template<class XBaseType>
+    KTExtensibleStructCore<XBaseType>::~KTExtensibleStructCore()
+    {
+        DeleteNext();
+        delete GetHead();
     }
 
     template<class XBaseType>
     KTExtensibleStructCore<XBaseType>& KTExtensibleStructCore<XBaseType>::operator=(const KTExtensibleStructCore&)
     {
         fNext = 0;
+        // shared objects are only ever after the private ones, so none are left
+        ChainHead* head = First()->GetHead();
+        if (head) head->fShared.reset();
+        RebuildChainIndex();
+        return *this;
+    }
+
+    template<class XBaseType>
+    KTExtensibleStructCore<XBaseType>& KTExtensibleStructCore<XBaseType>::operator=(KTExtensibleStructCore&& object)
+    {
+        if (&object == this)
+        {
+            return *this;
+        }
+        ClearNext();
+        if (CanTakeChain(object))
+        {
+            TakeChain(object);
+        }
+        else
+        {
+            RebuildChainIndex();
+        }
         return *this;
     }
 
     template<class XBaseType>
     void KTExtensibleStructCore<XBaseType>::Clear(void)
     {
-        delete fNext;
-        fNext = 0;
+        ClearNext();
+        // the arena's memory can be reused once none of the objects in it are left
+        KTArena* arena = GetArena();
+        if (arena && arena->IsUnused()) arena->Reset();
+        RebuildChainIndex();
     }
 
     template<class XBaseType>
     template<class XStructType>
     inline XStructType& KTExtensibleStructCore<XBaseType>::Of(void)
     {
-        XStructType* target = dynamic_cast<XStructType*>(this);
+        static_assert(KTIsExtensibleStructInstance< XStructType, XBaseType >::value, "XStructType must be the XInstanceType of an extensible struct");
+        KTExtensibleStructCore* target = FindPrivate(XStructType::TypeId());
         if (target)
         {
-            return *target;
+            return static_cast< XStructType& >(*target);
         }
+        return *AddNew< XStructType >();
+    }
 
-        if (! fNext)
+    template<class XBaseType>
+    template<class XStructType>
+    inline const XStructType& KTExtensibleStructCore<XBaseType>::Of(void) const
+    {
+        static_assert(KTIsExtensibleStructInstance< XStructType, XBaseType >::value, "XStructType must be the XInstanceType of an extensible struct");
+        const KTExtensibleStructCore* target = Find(XStructType::TypeId());
+        if (target)
         {
-            fNext = new XStructType();
-            fNext->fPrev = this;
+            return static_cast< const XStructType& >(*target);
         }
+        return *AddNew< XStructType >();
+    }
+
 
-        return fNext->Of<XStructType>();
+
+    template<class XBaseType>
+    template<class XStructType>
+    inline XStructType* KTExtensibleStructCore<XBaseType>::Get(void)
+    {
+        static_assert(KTIsExtensibleStructInstance< XStructType, XBaseType >::value, "XStructType must be the XInstanceType of an extensible struct");
+        KTExtensibleStructCore* target = FindPrivate(XStructType::TypeId());
+        if (target)
+        {
+            return static_cast< XStructType* >(target);
+        }
+        return Generate< XStructType >();
     }
 
     template<class XBaseType>
     template<class XStructType>
-    inline const XStructType& KTExtensibleStructCore<XBaseType>::Of(void) const
+    inline const XStructType* KTExtensibleStructCore<XBaseType>::Get(void) const
     {
-        const XStructType* target = dynamic_cast<const XStructType*>(this);
+        static_assert(KTIsExtensibleStructInstance< XStructType, XBaseType >::value, "XStructType must be the XInstanceType of an extensible struct");
+        const KTExtensibleStructCore* target = Find(XStructType::TypeId());
         if (target)
         {
-            return *target;
+            return static_cast< const XStructType* >(target);
+        }
+        return Generate< XStructType >();
+    }
+
+    template<class XBaseType>
+    template<class XStructType>
+    XStructType* KTExtensibleStructCore<XBaseType>::Generate(void) const
+    {
+        const typename XStructType::Generator& generator = XStructType::GetGenerator();
+        if (! generator)
+        {
+            return 0;
         }
 
-        if (fNext == 0)
+        KTExtensibleStructCore* first = First();
+        std::unique_ptr< XStructType > newObject;
         {
-            fNext = new XStructType();
-            fNext->fPrev = const_cast< KTExtensibleStructCore< XBaseType >* >(this);
+            // the arena can only be used by one thread at a time
+            boost::lock_guard< boost::mutex > lock(AppendMutex(first));
+            KTArena* arena = GetArena();
+            newObject.reset(arena ? new (*arena) XStructType() : new XStructType());
+        }
+        // the generator can use Get() for other objects, which are added to the chain before this one
+        if (! generator(*newObject, *first))
+        {
+            return 0;
         }
 
-        return fNext->Of<XStructType>();
+        boost::lock_guard< boost::mutex > lock(AppendMutex(first));
+        KTExtensibleStructCore* existing = Find(XStructType::TypeId());
+        if (existing)
+        {
+            // made by another thread in the meantime
+            return static_cast< XStructType* >(existing);
+        }
+        Append(newObject.get());
+        return newObject.release();
     }
 
+    template<class XBaseType>
+    template<class XStructType>
+    XStructType* KTExtensibleStructCore<XBaseType>::AddNew(void) const
+    {
+        boost::lock_guard< boost::mutex > lock(AppendMutex(First()));
+        // another thread may have added one since this one looked
+        KTExtensibleStructCore* existing = Find(XStructType::TypeId());
+        if (existing)
+        {
+            return static_cast< XStructType* >(existing);
+        }
 
+        KTArena* arena = GetArena();
+        XStructType* newObject = arena ? new (*arena) XStructType() : new XStructType();
+        Append(newObject);
+        return newObject;
+    }
 
     template<class XBaseType>
     template<class XStructType>
     inline bool KTExtensibleStructCore<XBaseType>::Has(void) const
     {
-        if (dynamic_cast<const XStructType*>(this))
+        static_assert(KTIsExtensibleStructInstance< XStructType, XBaseType >::value, "XStructType must be the XInstanceType of an extensible struct");
+        return Find(XStructType::TypeId()) != 0;
+    }
+
+
+
+    template<class XBaseType>
+    template<class XStructType>
+    inline XStructType* KTExtensibleStructCore<XBaseType>::Detatch(void)
+    {
+        static_assert(KTIsExtensibleStructInstance< XStructType, XBaseType >::value, "XStructType must be the XInstanceType of an extensible struct");
+        // the search starts below this object
+        unsigned typeId = XStructType::TypeId();
+        KTExtensibleStructCore* next = 0;
+        if (fPrev == 0 && fTypeId != typeId)
         {
-            return true;
+            next = Find(typeId);
         }
-        if (fNext)
+        else if (fNext)
         {
-            return fNext->Has<XStructType>();
+            next = fNext->Find(typeId);
+        }
+        if (! next)
+        {
+            return 0;
         }
 
-        return false;
+        if (next->fGroup) next = First()->MakePrivate(next);
+        Unlink(next);
+        return static_cast< XStructType* >(next);
     }
 
-
+    template<class XBaseType>
+    template<class XStructType>
+    inline XStructType& KTExtensibleStructCore<XBaseType>::Attach(std::unique_ptr< XStructType > object)
+    {
+        static_assert(KTIsExtensibleStructInstance< XStructType, XBaseType >::value, "XStructType must be the XInstanceType of an extensible struct");
+        XStructType* attached = object.release();
+        AttachObject(attached);
+        return *attached;
+    }
 
     template<class XBaseType>
     template<class XStructType>
-    inline XStructType* KTExtensibleStructCore<XBaseType>::Detatch(void)
+    inline XStructType* KTExtensibleStructCore<XBaseType>::Splice(KTExtensibleStructCore& from)
     {
-        if (! fNext)
+        static_assert(KTIsExtensibleStructInstance< XStructType, XBaseType >::value, "XStructType must be the XInstanceType of an extensible struct");
+        KTExtensibleStructCore* source = from.First();
+        if (source == First())
         {
             return 0;
         }
-        XStructType* next = dynamic_cast<XStructType*>(fNext);
-        if (next)
+        XStructType* object = source->template Detatch< XStructType >();
+        if (object)
+        {
+            AttachObject(object);
+        }
+        return object;
+    }
+
+    template<class XBaseType>
+    void KTExtensibleStructCore<XBaseType>::SpliceAll(KTExtensibleStructCore& from)
+    {
+        KTExtensibleStructCore* source = from.First();
+        if (source == First())
+        {
+            return;
+        }
+        // shared objects belong to other chains as well
+        source->Unshare();
+
+        KTExtensibleStructCore* object = source->fNext;
+        source->fNext = 0;
+        source->RebuildIndex();
+        while (object)
+        {
+            KTExtensibleStructCore* next = object->fNext;
+            object->fPrev = 0;
+            object->fNext = 0;
+            AttachObject(object);
+            object = next;
+        }
+        return;
+    }
+
+    template<class XBaseType>
+    void KTExtensibleStructCore<XBaseType>::AttachObject(KTExtensibleStructCore* object)
+    {
+        // the rest of the object's chain goes first, so that the object isn't replaced by one of the same type
+        if (object->fNext)
+        {
+            SpliceAll(*object);
+        }
+        KTExtensibleStructCore* first = First();
+        KTExtensibleStructCore* existing = first->Find(object->fTypeId);
+        if (existing && existing != first && existing != this)
+        {
+            if (existing->fGroup) existing = first->MakePrivate(existing);
+            Unlink(existing);
+            delete existing;
+        }
+        first->Append(object);
+        return;
+    }
+
+    template<class XBaseType>
+    void KTExtensibleStructCore<XBaseType>::Unlink(KTExtensibleStructCore* object)
+    {
+        KTExtensibleStructCore* first = object->First();
+        KTExtensibleStructCore* after = object->fNext;
+        object->fPrev->fNext = after;
+        if (after && ! after->fGroup)
         {
-            if (next->fNext)
+            after->fPrev = object->fPrev;
+        }
+        object->fPrev = 0;
+        object->fNext = 0;
+
+        if (first->fNext == 0)
+        {
+            first->RebuildIndex();
+        }
+        else
+        {
+            Index* index = first->GetHead()->fIndex.load(std::memory_order_relaxed);
+            if (index->fEntries[object->fTypeId].load(std::memory_order_relaxed) == object)
             {
-                fNext = next->fNext;
-                fNext->fPrev = this;
-                next->fNext = 0;
+                // a later object of the same type, if there is one, takes its place
+                index->fEntries[object->fTypeId].store(after ? after->Find(object->fTypeId) : 0, std::memory_order_release);
             }
-            next->fPrev = 0;
-            return next;
         }
-        return fNext->Detatch<XStructType>();
+        object->RebuildIndex();
+        return;
+    }
+
+    template<class XBaseType>
+    inline unsigned KTExtensibleStructCore<XBaseType>::GetTypeId() const
+    {
+        return fTypeId;
+    }
+
+    template<class XBaseType>
+    void KTExtensibleStructCore<XBaseType>::UseArena(std::size_t blockSize)
+    {
+        ChainHead& head = First()->Head();
+        if (head.fArena == 0) head.fArena = new KTArena(blockSize);
+        return;
+    }
+
+    template<class XBaseType>
+    inline KTArena* KTExtensibleStructCore<XBaseType>::GetArena() const
+    {
+        const ChainHead* head = First()->GetHead();
+        return head ? head->fArena : 0;
     }
 
+    template<class XBaseType>
+    void* KTExtensibleStructCore<XBaseType>::operator new(std::size_t size)
+    {
+        AllocationHeader* header = static_cast< AllocationHeader* >(::operator new(sizeof(AllocationHeader) + size));
+        header->fArena = 0;
+        return header + 1;
+    }
+
+    template<class XBaseType>
+    void* KTExtensibleStructCore<XBaseType>::operator new(std::size_t size, KTArena& arena)
+    {
+        AllocationHeader* header = static_cast< AllocationHeader* >(arena.Allocate(sizeof(AllocationHeader) + size));
+        header->fArena = &arena;
+        return header + 1;
+    }
+
+    template<class XBaseType>
+    inline void* KTExtensibleStructCore<XBaseType>::operator new(std::size_t, void* place)
+    {
+        return place;
+    }
+
+    template<class XBaseType>
+    void KTExtensibleStructCore<XBaseType>::operator delete(void* ptr, std::size_t)
+    {
+        if (ptr == 0) return;
+        AllocationHeader* header = static_cast< AllocationHeader* >(ptr) - 1;
+        if (header->fArena) header->fArena->Deallocate(header);
+        else ::operator delete(header);
+        return;
+    }
+
+    template<class XBaseType>
+    void KTExtensibleStructCore<XBaseType>::operator delete(void* ptr, KTArena& arena)
+    {
+        arena.Deallocate(static_cast< AllocationHeader* >(ptr) - 1);
+        return;
+    }
+
+    template<class XBaseType>
+    inline void KTExtensibleStructCore<XBaseType>::operator delete(void*, void*)
+    {
+        return;
+    }
+
+    template<class XBaseType>
+    unsigned KTExtensibleStructCore<XBaseType>::NewTypeId()
+    {
+        return TypeIdCounter()++;
+    }
+
+    template<class XBaseType>
+    inline unsigned KTExtensibleStructCore<XBaseType>::NTypeIds()
+    {
+        return TypeIdCounter().load(std::memory_order_relaxed);
+    }
+
+    template<class XBaseType>
+    std::atomic< unsigned >& KTExtensibleStructCore<XBaseType>::TypeIdCounter()
+    {
+        static std::atomic< unsigned > sNextTypeId(0);
+        return sNextTypeId;
+    }
+
+    template<class XBaseType>
+    inline KTExtensibleStructCore<XBaseType>* KTExtensibleStructCore<XBaseType>::Find(unsigned typeId) const
+    {
+        if (fPrev == 0)
+        {
+            const ChainHead* head = GetHead();
+            const Index* index = head ? head->fIndex.load(std::memory_order_acquire) : 0;
+            // a chain that has only ever had one object doesn't have an index
+            if (index == 0) return fTypeId == typeId ? const_cast< KTExtensibleStructCore* >(this) : 0;
+            return typeId < index->fSize ? index->fEntries[typeId].load(std::memory_order_acquire) : 0;
+        }
+        for (KTExtensibleStructCore* object = const_cast< KTExtensibleStructCore* >(this); object != 0; object = object->fNext)
+        {
+            if (object->fTypeId == typeId) return object;
+        }
+        return 0;
+    }
+
+    template<class XBaseType>
+    inline KTExtensibleStructCore<XBaseType>* KTExtensibleStructCore<XBaseType>::FindPrivate(unsigned typeId)
+    {
+        KTExtensibleStructCore* target = Find(typeId);
+        if (target && target->fGroup) target = First()->MakePrivate(target);
+        return target;
+    }
+
+    template<class XBaseType>
+    void KTExtensibleStructCore<XBaseType>::Append(KTExtensibleStructCore* object) const
+    {
+        // goes in front of any shared objects
+        KTExtensibleStructCore* first = First();
+        KTExtensibleStructCore* last = first->LastPrivate();
+        object->DeleteHead();
+        object->fNext = last->fNext;
+        object->fPrev = last;
+        last->fNext = object;
+        first->AddToIndex(object);
+        return;
+    }
+
+    template<class XBaseType>
+    void KTExtensibleStructCore<XBaseType>::AddToIndex(KTExtensibleStructCore* object) const
+    {
+        ChainHead& head = Head();
+        Index* index = head.fIndex.load(std::memory_order_relaxed);
+        if (index == 0 || object->fTypeId >= index->fSize)
+        {
+            // other threads may be reading the index, so it's replaced with a bigger one rather than resized
+            Index* newIndex = new Index(std::max(object->fTypeId + 1, NTypeIds()));
+            if (index)
+            {
+                for (unsigned typeId = 0; typeId < index->fSize; ++typeId)
+                {
+                    newIndex->fEntries[typeId].store(index->fEntries[typeId].load(std::memory_order_relaxed), std::memory_order_relaxed);
+                }
+                head.fOldIndexes.push_back(index);
+            }
+            else if (fTypeId != sNoTypeId)
+            {
+                newIndex->fEntries[fTypeId].store(const_cast< KTExtensibleStructCore* >(this), std::memory_order_relaxed);
+            }
+            head.fIndex.store(newIndex, std::memory_order_release);
+            index = newIndex;
+        }
+        if (index->fEntries[object->fTypeId].load(std::memory_order_relaxed) == 0)
+        {
+            index->fEntries[object->fTypeId].store(object, std::memory_order_release);
+        }
+        return;
+    }
+
+    template<class XBaseType>
+    void KTExtensibleStructCore<XBaseType>::RebuildIndex() const
+    {
+        ChainHead* head = GetHead();
+        Index* index = head ? head->fIndex.load(std::memory_order_relaxed) : 0;
+        // a chain that has only ever had one object doesn't need an index
+        if (fNext == 0 && index == 0) return;
+
+        // nothing else is using the chain, so the index can be reused, and the ones it replaced deleted
+        unsigned size = NTypeIds();
+        if (index == 0 || index->fSize < size)
+        {
+            Head().ClearIndex();
+            index = new Index(size);
+        }
+        else
+        {
+            head->fIndex.store(0, std::memory_order_relaxed);
+            head->ClearIndex();
+            for (unsigned typeId = 0; typeId < index->fSize; ++typeId)
+            {
+                index->fEntries[typeId].store(0, std::memory_order_relaxed);
+            }
+        }
+        for (KTExtensibleStructCore* object = const_cast< KTExtensibleStructCore* >(this); object != 0; object = object->fNext)
+        {
+            if (object != this && ! object->fGroup) object->DeleteHead();
+            if (object->fTypeId == sNoTypeId) continue;
+            if (index->fEntries[object->fTypeId].load(std::memory_order_relaxed) == 0)
+            {
+                index->fEntries[object->fTypeId].store(object, std::memory_order_relaxed);
+            }
+        }
+        GetHead()->fIndex.store(index, std::memory_order_release);
+        return;
+    }
+
+    template<class XBaseType>
+    inline void KTExtensibleStructCore<XBaseType>::RebuildChainIndex() const
+    {
+        First()->RebuildIndex();
+        return;
+    }
+
+    template<class XBaseType>
+    inline void KTExtensibleStructCore<XBaseType>::SetIsCopyOnWrite(bool flag)
+    {
+        KTExtensibleStructCore* first = First();
+        if (flag || first->GetHead()) first->Head().fIsCopyOnWrite = flag;
+        return;
+    }
+
+    template<class XBaseType>
+    inline bool KTExtensibleStructCore<XBaseType>::GetIsCopyOnWrite() const
+    {
+        const ChainHead* head = First()->GetHead();
+        return head && head->fIsCopyOnWrite;
+    }
+
+    template<class XBaseType>
+    inline bool KTExtensibleStructCore<XBaseType>::IsShared() const
+    {
+        return fGroup != 0;
+    }
+
+    template<class XBaseType>
+    void KTExtensibleStructCore<XBaseType>::Unshare()
+    {
+        KTExtensibleStructCore* first = First();
+        first->ReclaimShared();
+        if (first->GetHead() && first->GetHead()->fShared)
+        {
+            first->MakePrivate(first->Last());
+        }
+        return;
+    }
+
+    template<class XBaseType>
+    std::size_t KTExtensibleStructCore<XBaseType>::OwnedBytes() const
+    {
+        return 0;
+    }
+
+    template<class XBaseType>
+    void KTExtensibleStructCore<XBaseType>::UpdateAccounts() const
+    {
+        for (const KTExtensibleStructCore* object = this; object != NULL; object = object->fNext)
+        {
+            object->UpdateAccount();
+        }
+        return;
+    }
+
+    template<class XBaseType>
+    inline void KTExtensibleStructCore<XBaseType>::DeleteNext()
+    {
+        if (fNext && fNext->fGroup == fGroup) delete fNext;
+        fNext = 0;
+        return;
+    }
+
+    template<class XBaseType>
+    void KTExtensibleStructCore<XBaseType>::ClearNext()
+    {
+        DeleteNext();
+        // shared objects are only ever after the private ones, so none are left
+        ChainHead* head = First()->GetHead();
+        if (head) head->fShared.reset();
+        return;
+    }
+
+    template<class XBaseType>
+    void KTExtensibleStructCore<XBaseType>::ShareChain(const KTExtensibleStructCore& object)
+    {
+        boost::lock_guard< boost::mutex > lock(SharingMutex());
+        object.Share();
+        fNext = object.fNext;
+        First()->Head().fShared = object.GetHead()->fShared;
+        return;
+    }
+
+    template<class XBaseType>
+    void KTExtensibleStructCore<XBaseType>::DropShared()
+    {
+        LastPrivate()->fNext = 0;
+        if (GetHead()) GetHead()->fShared.reset();
+        RebuildIndex();
+        return;
+    }
+
+    template<class XBaseType>
+    KTExtensibleStructCore<XBaseType>* KTExtensibleStructCore<XBaseType>::MakePrivate(KTExtensibleStructCore* object)
+    {
+        ReclaimShared();
+        if (! object->fGroup) return object;
+
+        // copy the shared objects up to and including the one requested; the chain then continues with the shared objects after it
+        KTExtensibleStructCore* last = LastPrivate();
+        KTExtensibleStructCore* original = last->fNext;
+        KTExtensibleStructCore* copy = 0;
+        while (true)
+        {
+            copy = original->CloneObject(GetHead()->fArena);
+            copy->fPrev = last;
+            last->fNext = copy;
+            last = copy;
+            if (original == object) break;
+            original = original->fNext;
+        }
+        KTExtensibleStructCore* after = object->fNext;
+        last->fNext = after;
+
+        // groups that are no longer part of this chain are let go
+        boost::shared_ptr< SharedGroup >& shared = GetHead()->fShared;
+        while (shared && (after == 0 || shared.get() != after->fGroup))
+        {
+            shared = boost::shared_ptr< SharedGroup >(shared->fNext);
+        }
+        RebuildIndex();
+        return copy;
+    }
+
+    template<class XBaseType>
+    KTExtensibleStructCore<XBaseType>* KTExtensibleStructCore<XBaseType>::LastPrivate() const
+    {
+        KTExtensibleStructCore* last = const_cast< KTExtensibleStructCore* >(this);
+        while (last->fNext != 0 && ! last->fNext->fGroup)
+        {
+            last = last->fNext;
+        }
+        return last;
+    }
+
+    template<class XBaseType>
+    inline bool KTExtensibleStructCore<XBaseType>::CanTakeChain(const KTExtensibleStructCore& object) const
+    {
+        // shared objects don't know which chain they're in
+        return fPrev == 0 && object.fPrev == 0 && ! object.fGroup;
+    }
+
+    template<class XBaseType>
+    void KTExtensibleStructCore<XBaseType>::TakeChain(KTExtensibleStructCore& object)
+    {
+        fNext = object.fNext;
+        object.fNext = 0;
+        // Prev() of shared objects isn't used, and the private objects after the first still point to the one before them
+        if (fNext && ! fNext->fGroup) SetPrevPtrInNext();
+
+        // this object has nothing after it, so its head (if it has one) only has an arena, which the object is left with
+        bool isCopyOnWrite = object.GetIsCopyOnWrite();
+        ChainHead* head = GetHead();
+        fHead.store(object.GetHead(), std::memory_order_release);
+        object.fHead.store(head, std::memory_order_release);
+        object.SetIsCopyOnWrite(isCopyOnWrite);
+        object.RebuildIndex();
+
+        Index* index = GetHead() ? GetHead()->fIndex.load(std::memory_order_relaxed) : 0;
+        if (index && fTypeId == object.fTypeId)
+        {
+            // the object was the first of its type in its own index
+            if (fTypeId < index->fSize) index->fEntries[fTypeId].store(this, std::memory_order_release);
+        }
+        else
+        {
+            RebuildIndex();
+        }
+        return;
+    }
+
+    template<class XBaseType>
+    KTExtensibleStructCore<XBaseType>::SharedGroup::SharedGroup(KTExtensibleStructCore* first, const boost::shared_ptr< SharedGroup >& next) :
+            fFirst(first),
+            fNext(next)
+    {
+    }
+
+    template<class XBaseType>
+    KTExtensibleStructCore<XBaseType>::SharedGroup::~SharedGroup()
+    {
+        // deletes the objects that still belong to the group; each deletes the ones after it in the same group
+        if (fFirst && fFirst->fGroup == this) delete fFirst;
+    }
+
+    template<class XBaseType>
+    KTExtensibleStructCore<XBaseType>::Index::Index(unsigned size) :
+            fSize(size),
+            fEntries(new std::atomic< KTExtensibleStructCore* >[size])
+    {
+        for (unsigned typeId = 0; typeId < fSize; ++typeId)
+        {
+            fEntries[typeId].store(0, std::memory_order_relaxed);
+        }
+    }
+
+    template<class XBaseType>
+    KTExtensibleStructCore<XBaseType>::ChainHead::ChainHead() :
+            fIndex(0),
+            fOldIndexes(),
+            fArena(0),
+            fShared(),
+            fIsCopyOnWrite(false)
+    {
+    }
+
+    template<class XBaseType>
+    KTExtensibleStructCore<XBaseType>::ChainHead::~ChainHead()
+    {
+        ClearIndex();
+        if (fArena) fArena->Release();
+    }
+
+    template<class XBaseType>
+    void KTExtensibleStructCore<XBaseType>::ChainHead::ClearIndex()
+    {
+        delete fIndex.exchange(0, std::memory_order_relaxed);
+        for (typename std::vector< Index* >::iterator it = fOldIndexes.begin(); it != fOldIndexes.end(); ++it)
+        {
+            delete *it;
+        }
+        fOldIndexes.clear();
+        return;
+    }
+
+    template<class XBaseType>
+    inline typename KTExtensibleStructCore<XBaseType>::ChainHead& KTExtensibleStructCore<XBaseType>::Head() const
+    {
+        ChainHead* head = fHead.load(std::memory_order_relaxed);
+        if (head == 0)
+        {
+            head = new ChainHead();
+            fHead.store(head, std::memory_order_release);
+        }
+        return *head;
+    }
+
+    template<class XBaseType>
+    inline typename KTExtensibleStructCore<XBaseType>::ChainHead* KTExtensibleStructCore<XBaseType>::GetHead() const
+    {
+        return fHead.load(std::memory_order_acquire);
+    }
+
+    template<class XBaseType>
+    inline void KTExtensibleStructCore<XBaseType>::DeleteHead() const
+    {
+        delete fHead.exchange(0, std::memory_order_relaxed);
+        return;
+    }
+
+    template<class XBaseType>
+    void KTExtensibleStructCore<XBaseType>::ReclaimShared()
+    {
+        if (GetHead() == 0) return;
+        boost::shared_ptr< SharedGroup >& shared = GetHead()->fShared;
+        KTExtensibleStructCore* last = LastPrivate();
+        while (shared && shared.unique())
+        {
+            // the objects of the group that are in this chain come right after the private ones
+            SharedGroup* group = shared.get();
+            for (KTExtensibleStructCore* object = last->fNext; object != 0 && object->fGroup == group; object = object->fNext)
+            {
+                object->fGroup = 0;
+                object->fPrev = last;
+                last = object;
+            }
+            // objects of the group that are no longer in this chain are deleted with it
+            shared = boost::shared_ptr< SharedGroup >(group->fNext);
+        }
+        return;
+    }
+
+    template<class XBaseType>
+    void KTExtensibleStructCore<XBaseType>::Share() const
+    {
+        if (fNext == 0 || fNext->fGroup) return;
+        boost::shared_ptr< SharedGroup >& shared = Head().fShared;
+        SharedGroup* group = new SharedGroup(fNext, shared);
+        for (KTExtensibleStructCore* object = fNext; object != 0 && ! object->fGroup; object = object->fNext)
+        {
+            object->fGroup = group;
+        }
+        shared.reset(group);
+        return;
+    }
+
+    template<class XBaseType>
+    boost::mutex& KTExtensibleStructCore<XBaseType>::SharingMutex()
+    {
+        static boost::mutex sMutex;
+        return sMutex;
+    }
+
+    template<class XBaseType>
+    boost::mutex& KTExtensibleStructCore<XBaseType>::AppendMutex(const KTExtensibleStructCore* first)
+    {
+        // a lock in each chain would make every object bigger, and a single lock would make unrelated chains wait for each other
+        static const std::size_t sNMutexes = 61;
+        static boost::mutex sMutexes[sNMutexes];
+        return sMutexes[(reinterpret_cast< std::uintptr_t >(first) >> 4) % sNMutexes];
+    }
 
     template<class XBaseType>
     inline KTExtensibleStructCore<XBaseType>* KTExtensibleStructCore<XBaseType>::Next() const
@@ -213,14 +1211,14 @@ namespace Nymph
     template<class XBaseType>
     inline KTExtensibleStructCore<XBaseType>* KTExtensibleStructCore<XBaseType>::Last() const
     {
-        if (fNext == 0) return this;
+        if (fNext == 0) return const_cast< KTExtensibleStructCore* >(this);
         return fNext->Last();
     }
 
     template<class XBaseType>
     inline KTExtensibleStructCore<XBaseType>* KTExtensibleStructCore<XBaseType>::First() const
     {
-        if (fPrev == 0) return this;
+        if (fPrev == 0) return const_cast< KTExtensibleStructCore* >(this);
         return fPrev->First();
     }
 
@@ -237,12 +1235,15 @@ namespace Nymph
     KTExtensibleStruct<XInstanceType, XBaseType>::KTExtensibleStruct(void)
     {
         fIsCopyDisabled = false;
+        this->fTypeId = TypeId();
+        AddToAccount();
     }
 
     template<class XInstanceType, class XBaseType>
     KTExtensibleStruct<XInstanceType, XBaseType>::~KTExtensibleStruct()
     {
         fIsCopyDisabled = false;
+        if (fIsAccounted) Account().Remove(fAccountedOwnedBytes.load(std::memory_order_relaxed));
     }
 
     template<class XInstanceType, class XBaseType>
@@ -251,10 +1252,43 @@ namespace Nymph
     {
         // should this check fIsCopyDisabled in object?
         fIsCopyDisabled = false;
+        this->fTypeId = TypeId();
+        AddToAccount();
+        // only the first object of a chain has a head
+        const typename KTExtensibleStructCore< XBaseType >::ChainHead* head = object.GetHead();
+        bool isCopyOnWrite = head && head->fIsCopyOnWrite;
+        if (head && head->fArena) this->UseArena(head->fArena->GetBlockSize());
+        this->SetIsCopyOnWrite(isCopyOnWrite);
+
+        if (object.fNext)
+        {
+            if (isCopyOnWrite)
+            {
+                this->ShareChain(object);
+            }
+            else
+            {
+                this->fNext = object.fNext->Clone();
+                this->KTExtensibleStructCore< XBaseType >::SetPrevPtrInNext();
+            }
+        }
+        this->RebuildIndex();
+    }
+
+    template<class XInstanceType, class XBaseType>
+    KTExtensibleStruct<XInstanceType, XBaseType>::KTExtensibleStruct(KTExtensibleStruct<XInstanceType, XBaseType>&& object) :
+            KTExtensibleStructCore<XBaseType>(std::move(object))
+    {
+        fIsCopyDisabled = false;
+        this->fTypeId = TypeId();
+        AddToAccount();
 
+        // the rest of the chain is still there if the object isn't the first in its chain
         if (object.fNext)
         {
             this->fNext = object.fNext->Clone();
+            this->KTExtensibleStructCore< XBaseType >::SetPrevPtrInNext();
+            this->RebuildIndex();
         }
     }
 
@@ -267,16 +1301,40 @@ namespace Nymph
             return *this;
         }
 
-        delete this->fNext;
-        this->fNext = 0;
+        this->ClearNext();
 
         if (object.fNext)
         {
-            this->fNext = object.fNext->Clone();
-            this->KTExtensibleStructCore< XBaseType >::SetPrevPtrInNext();
-            //this->fNext->fPrev = this;
+            if (object.GetHead() && object.GetHead()->fIsCopyOnWrite)
+            {
+                this->ShareChain(object);
+            }
+            else
+            {
+                this->fNext = object.fNext->Clone();
+                this->KTExtensibleStructCore< XBaseType >::SetPrevPtrInNext();
+                //this->fNext->fPrev = this;
+            }
+        }
+        this->RebuildChainIndex();
+
+        return *this;
+    }
+
+    template<class XInstanceType, class XBaseType>
+    KTExtensibleStruct<XInstanceType, XBaseType>& KTExtensibleStruct<XInstanceType, XBaseType>::operator=(KTExtensibleStruct<XInstanceType, XBaseType>&& object)
+    {
+        // Pull() disables copying, so that only the fields of the derived classes are assigned
+        if ((&object == this) || fIsCopyDisabled)
+        {
+            return *this;
         }
 
+        if (! this->CanTakeChain(object))
+        {
+            return operator=(static_cast< const KTExtensibleStruct& >(object));
+        }
+        KTExtensibleStructCore< XBaseType >::operator=(std::move(object));
         return *this;
     }
 
@@ -286,11 +1344,13 @@ namespace Nymph
         // assume CRTP is used properly,
         // otherwise compiling fails here (intended behavior)
         XInstanceType* instance = new XInstanceType(dynamic_cast<const XInstanceType&>(*this));
-        if (this->fNext)
+        // the copy constructor has already cloned the rest of the chain, unless XInstanceType's copy constructor doesn't copy its base
+        if (this->fNext && ! instance->fNext)
         {
             instance->fNext = this->fNext->Clone();
             instance->SetPrevPtrInNext();
             //instance->fNext->fPrev = instance->fNext;
+            instance->RebuildIndex();
         }
         return instance;
     }
@@ -302,6 +1362,8 @@ namespace Nymph
         {
             return;
         }
+        // the objects in this chain are modified
+        if (this->fPrev == 0) this->Unshare();
 
         fIsCopyDisabled = true;
         XInstanceType* instance = dynamic_cast<XInstanceType*>(this);
@@ -321,6 +1383,14 @@ namespace Nymph
         }
     }
 
+    template<class XInstanceType, class XBaseType>
+    KTExtensibleStructCore<XBaseType>* KTExtensibleStruct<XInstanceType, XBaseType>::CloneObject(KTArena* arena) const
+    {
+        XInstanceType* instance = arena ? new (*arena) XInstanceType() : new XInstanceType();
+        instance->Pull(*this);
+        return instance;
+    }
+
     template<class XInstanceType, class XBaseType>
     inline void KTExtensibleStruct<XInstanceType, XBaseType>::SetIsCopyDisabled(bool flag)
     {
@@ -328,5 +1398,60 @@ namespace Nymph
         return;
     }
 
+    template<class XInstanceType, class XBaseType>
+    inline unsigned KTExtensibleStruct<XInstanceType, XBaseType>::TypeId()
+    {
+        static const unsigned sTypeId = KTExtensibleStructCore< XBaseType >::NewTypeId();
+        return sTypeId;
+    }
+
+    template<class XInstanceType, class XBaseType>
+    void KTExtensibleStruct<XInstanceType, XBaseType>::SetGenerator(const Generator& generator)
+    {
+        GeneratorInstance() = generator;
+        return;
+    }
+
+    template<class XInstanceType, class XBaseType>
+    inline const typename KTExtensibleStruct<XInstanceType, XBaseType>::Generator& KTExtensibleStruct<XInstanceType, XBaseType>::GetGenerator()
+    {
+        return GeneratorInstance();
+    }
+
+    template<class XInstanceType, class XBaseType>
+    typename KTExtensibleStruct<XInstanceType, XBaseType>::Generator& KTExtensibleStruct<XInstanceType, XBaseType>::GeneratorInstance()
+    {
+        // a function-local static avoids static initialization order problems when generators are registered
+        static Generator sGenerator;
+        return sGenerator;
+    }
+
+    template<class XInstanceType, class XBaseType>
+    inline void KTExtensibleStruct<XInstanceType, XBaseType>::AddToAccount()
+    {
+        fAccountedOwnedBytes.store(0, std::memory_order_relaxed);
+        fIsAccounted = KTMemoryAccounting::GetIsEnabled();
+        if (fIsAccounted) Account().Add();
+        return;
+    }
+
+    template<class XInstanceType, class XBaseType>
+    void KTExtensibleStruct<XInstanceType, XBaseType>::UpdateAccount() const
+    {
+        if (! fIsAccounted) return;
+        std::size_t ownedBytes = this->OwnedBytes();
+        std::size_t previous = fAccountedOwnedBytes.exchange(ownedBytes, std::memory_order_relaxed);
+        if (ownedBytes != previous) Account().ChangeOwnedBytes(previous, ownedBytes);
+        return;
+    }
+
+    template<class XInstanceType, class XBaseType>
+    KTMemoryAccount& KTExtensibleStruct<XInstanceType, XBaseType>::Account()
+    {
+        // made the first time an object is recorded, so the name is only looked up once accounting is in use
+        static KTMemoryAccount& sAccount = KTMemoryAccounting::GetAccount(KTExtensibleStructName< XInstanceType >::Get(), sizeof(XInstanceType));
+        return sAccount;
+    }
+
 } /* namespace Nymph */
 #endif /* KTEXTENSIBLESTRUCT_HH_ */
@@ -36,6 +36,7 @@ namespace Nymph
         protected:
             virtual KTExtensibleStructCore< XBaseType >* Create() const = 0;
             virtual KTExtensibleStructCore< XBaseType >* Create(KTExtensibleStructCore< XBaseType >* object) const = 0;
+            virtual KTExtensibleStructCore< XBaseType >* Get(KTExtensibleStructCore< XBaseType >* object) const = 0;
 
     };
 
@@ -51,9 +52,19 @@ namespace Nymph
 
             KTExtensibleStructCore< XBaseType >* Create() const;
             KTExtensibleStructCore< XBaseType >* Create(KTExtensibleStructCore< XBaseType >* object) const;
+            KTExtensibleStructCore< XBaseType >* Get(KTExtensibleStructCore< XBaseType >* object) const;
 
     };
 
+    /// Sets the generator for XDerivedType (see KTExtensibleStruct::SetGenerator()); use with the macro KT_REGISTER_GENERATOR
+    template< class XDerivedType >
+    class KTExtensibleStructGeneratorRegistrar
+    {
+        public:
+            KTExtensibleStructGeneratorRegistrar(const typename XDerivedType::Generator& generator);
+            ~KTExtensibleStructGeneratorRegistrar();
+    };
+
 
     template< class XBaseType >
     class KTExtensibleStructFactory : public scarab::singleton< KTExtensibleStructFactory< XBaseType > >
@@ -71,6 +82,9 @@ namespace Nymph
             KTExtensibleStructCore< XBaseType >* Create(const std::string& className, KTExtensibleStructCore< XBaseType >* object);
             KTExtensibleStructCore< XBaseType >* Create(const FactoryCIt& iter, KTExtensibleStructCore< XBaseType >* object);
 
+            /// Returns the object of the named class from the chain, making it with its generator if necessary (see KTExtensibleStruct::Get())
+            KTExtensibleStructCore< XBaseType >* Get(const std::string& className, KTExtensibleStructCore< XBaseType >* object);
+
             void Register(const std::string& className, const KTExtensibleStructRegistrarBase< XBaseType >* registrar);
 
             FactoryCIt GetFactoryMapBegin() const;
@@ -125,6 +139,19 @@ namespace Nymph
         return it->second->Create(object);
     }
 
+    template< class XBaseType >
+    KTExtensibleStructCore< XBaseType >* KTExtensibleStructFactory< XBaseType >::Get(const std::string& className, KTExtensibleStructCore< XBaseType >* object)
+    {
+        FactoryCIt it = fMap->find(className);
+        if (it == fMap->end())
+        {
+            KTERROR(utillog_esfactory, "Did not find factory for <" << className << ">.");
+            return NULL;
+        }
+
+        return it->second->Get(object);
+    }
+
     template< class XBaseType >
     void KTExtensibleStructFactory< XBaseType >::Register(const std::string& className, const KTExtensibleStructRegistrarBase< XBaseType >* registrar)
     {
@@ -197,5 +224,26 @@ namespace Nymph
         return dynamic_cast< KTExtensibleStructCore< XBaseType >* >(&object->template Of< XDerivedType >());
     }
 
+    template< class XBaseType, class XDerivedType >
+    KTExtensibleStructCore< XBaseType >* KTExtensibleStructRegistrar< XBaseType, XDerivedType >::Get(KTExtensibleStructCore< XBaseType >* object) const
+    {
+        return object->template Get< XDerivedType >();
+    }
+
+
+
+    template< class XDerivedType >
+    KTExtensibleStructGeneratorRegistrar< XDerivedType >::KTExtensibleStructGeneratorRegistrar(const typename XDerivedType::Generator& generator)
+    {
+        XDerivedType::SetGenerator(generator);
+    }
+
+    template< class XDerivedType >
+    KTExtensibleStructGeneratorRegistrar< XDerivedType >::~KTExtensibleStructGeneratorRegistrar()
+    {}
+
+#define KT_REGISTER_GENERATOR(struct_class, generator) \
+        static ::Nymph::KTExtensibleStructGeneratorRegistrar< struct_class > s##struct_class##GeneratorRegistrar( generator );
+
 } /* namespace Nymph */
 #endif /* KTEXTENSIBLESTRUCTFACTORY_HH_ */
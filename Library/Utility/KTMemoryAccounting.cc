@@ -0,0 +1,140 @@
+/*
+ * KTMemoryAccounting.cc
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: nsoblath
+ */
+
+#include "KTMemoryAccounting.hh"
+
+#include <boost/thread/locks.hpp>
+#include <boost/thread/mutex.hpp>
+
+#include <algorithm>
+#include <iomanip>
+#include <map>
+
+namespace Nymph
+{
+    namespace
+    {
+        struct AccountRegistry
+        {
+            boost::mutex fMutex;
+            std::vector< KTMemoryAccount* > fAccounts;
+            std::map< std::string, KTMemoryAccount* > fAccountsByName;
+        };
+
+        AccountRegistry& Registry()
+        {
+            // never deleted, so that objects destroyed during static destruction can still be removed from their accounts
+            static AccountRegistry* sRegistry = new AccountRegistry();
+            return *sRegistry;
+        }
+
+        bool MorePeakBytes(const KTMemoryAccount* lhs, const KTMemoryAccount* rhs)
+        {
+            return lhs->GetPeakBytes() > rhs->GetPeakBytes();
+        }
+    }
+
+    KTMemoryAccount::KTMemoryAccount(const std::string& name, std::size_t objectSize) :
+            fName(name),
+            fObjectSize(objectSize),
+            fNLive(0),
+            fPeakNLive(0),
+            fNCreated(0),
+            fOwnedBytes(0),
+            fPeakBytes(0)
+    {
+    }
+
+    KTMemoryAccount::~KTMemoryAccount()
+    {
+    }
+
+    void KTMemoryAccount::ResetPeak()
+    {
+        fPeakNLive.store(fNLive.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        fPeakBytes.store(GetLiveBytes(), std::memory_order_relaxed);
+        return;
+    }
+
+
+    std::atomic< bool > KTMemoryAccounting::sIsEnabled(false);
+
+    KTMemoryAccount& KTMemoryAccounting::GetAccount(const std::string& name, std::size_t objectSize)
+    {
+        AccountRegistry& registry = Registry();
+        boost::unique_lock< boost::mutex > lock(registry.fMutex);
+        std::map< std::string, KTMemoryAccount* >::const_iterator it = registry.fAccountsByName.find(name);
+        if (it != registry.fAccountsByName.end())
+        {
+            return *it->second;
+        }
+        KTMemoryAccount* account = new KTMemoryAccount(name, objectSize);
+        registry.fAccounts.push_back(account);
+        registry.fAccountsByName.insert(std::make_pair(name, account));
+        return *account;
+    }
+
+    std::vector< const KTMemoryAccount* > KTMemoryAccounting::GetAccounts()
+    {
+        AccountRegistry& registry = Registry();
+        boost::unique_lock< boost::mutex > lock(registry.fMutex);
+        return std::vector< const KTMemoryAccount* >(registry.fAccounts.begin(), registry.fAccounts.end());
+    }
+
+    std::size_t KTMemoryAccounting::GetLiveBytes()
+    {
+        std::vector< const KTMemoryAccount* > accounts = GetAccounts();
+        std::size_t bytes = 0;
+        for (std::vector< const KTMemoryAccount* >::const_iterator it = accounts.begin(); it != accounts.end(); ++it)
+        {
+            bytes += (*it)->GetLiveBytes();
+        }
+        return bytes;
+    }
+
+    void KTMemoryAccounting::ResetPeaks()
+    {
+        AccountRegistry& registry = Registry();
+        boost::unique_lock< boost::mutex > lock(registry.fMutex);
+        for (std::vector< KTMemoryAccount* >::iterator it = registry.fAccounts.begin(); it != registry.fAccounts.end(); ++it)
+        {
+            (*it)->ResetPeak();
+        }
+        return;
+    }
+
+    void KTMemoryAccounting::PrintReport(std::ostream& out)
+    {
+        std::vector< const KTMemoryAccount* > accounts;
+        std::size_t nameWidth = 10;
+        std::vector< const KTMemoryAccount* > allAccounts = GetAccounts();
+        for (std::vector< const KTMemoryAccount* >::const_iterator it = allAccounts.begin(); it != allAccounts.end(); ++it)
+        {
+            if ((*it)->GetNCreated() == 0) continue;
+            accounts.push_back(*it);
+            nameWidth = std::max(nameWidth, (*it)->GetName().size() + 2);
+        }
+        std::stable_sort(accounts.begin(), accounts.end(), MorePeakBytes);
+
+        out << std::left << std::setw(nameWidth) << "Type" << std::right
+                << std::setw(10) << "Size (B)" << std::setw(12) << "Live" << std::setw(14) << "Owned (B)" << std::setw(14) << "Live (B)"
+                << std::setw(12) << "Peak" << std::setw(14) << "Peak (B)" << std::setw(14) << "Created" << '\n';
+        std::size_t liveBytes = 0;
+        for (std::vector< const KTMemoryAccount* >::const_iterator it = accounts.begin(); it != accounts.end(); ++it)
+        {
+            const KTMemoryAccount& account = **it;
+            out << std::left << std::setw(nameWidth) << account.GetName() << std::right
+                    << std::setw(10) << account.GetObjectSize() << std::setw(12) << account.GetNLive() << std::setw(14) << account.GetOwnedBytes() << std::setw(14) << account.GetLiveBytes()
+                    << std::setw(12) << account.GetPeakNLive() << std::setw(14) << account.GetPeakBytes() << std::setw(14) << account.GetNCreated() << '\n';
+            liveBytes += account.GetLiveBytes();
+        }
+        out << std::left << std::setw(nameWidth) << "Total" << std::right
+                << std::setw(10) << "" << std::setw(12) << "" << std::setw(14) << "" << std::setw(14) << liveBytes << '\n';
+        return;
+    }
+
+} /* namespace Nymph */
@@ -0,0 +1,218 @@
+/*
+ * KTMemoryAccounting.hh
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: nsoblath
+ */
+
+#ifndef KTMEMORYACCOUNTING_HH_
+#define KTMEMORYACCOUNTING_HH_
+
+#include <atomic>
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace Nymph
+{
+    /*!
+     @class KTMemoryAccount
+     @author N. S. Oblath
+
+     @brief Number of live objects of one type and the bytes they use, and the most that were alive at once.
+
+     @details
+     All of the objects of a type have the same size, so the bytes taken up by the objects themselves are the number of objects times the object size.
+     The live bytes add to that the memory owned by the objects (e.g. the contents of their containers), as last recorded with ChangeOwnedBytes().
+     The peak bytes are the most live bytes seen when an object was added or its owned bytes changed; with several threads recording, it's approximate.
+     Add(), Remove(), and ChangeOwnedBytes() are lock-free, and can be called from any thread.
+
+     Accounts are made and kept by KTMemoryAccounting.
+    */
+    class KTMemoryAccount
+    {
+        public:
+            KTMemoryAccount(const std::string& name, std::size_t objectSize);
+            ~KTMemoryAccount();
+
+        private:
+            KTMemoryAccount(const KTMemoryAccount&);
+            KTMemoryAccount& operator=(const KTMemoryAccount&);
+
+        public:
+            /// Records the construction of an object
+            void Add();
+            /// Records the destruction of an object that was recorded with Add(), which owned the given bytes the last time they were recorded
+            void Remove(std::size_t ownedBytes = 0);
+            /// Records a change in the bytes owned by a live object
+            void ChangeOwnedBytes(std::size_t previous, std::size_t current);
+
+            const std::string& GetName() const;
+            std::size_t GetObjectSize() const;
+
+            std::size_t GetNLive() const;
+            std::size_t GetPeakNLive() const;
+            /// Bytes owned by the live objects, beyond the objects themselves
+            std::size_t GetOwnedBytes() const;
+            /// Bytes of the live objects themselves, plus the bytes they own
+            std::size_t GetLiveBytes() const;
+            std::size_t GetPeakBytes() const;
+            /// Total number of objects recorded
+            std::size_t GetNCreated() const;
+
+            /// Sets the high-water marks to the current number of live objects and live bytes
+            void ResetPeak();
+
+        private:
+            void UpdatePeakBytes();
+
+            std::string fName;
+            std::size_t fObjectSize;
+
+            std::atomic< std::size_t > fNLive;
+            std::atomic< std::size_t > fPeakNLive;
+            std::atomic< std::size_t > fNCreated;
+            std::atomic< std::size_t > fOwnedBytes;
+            std::atomic< std::size_t > fPeakBytes;
+    };
+
+    /*!
+     @class KTMemoryAccounting
+     @author N. S. Oblath
+
+     @brief Opt-in accounting of the memory used by the objects in extensible structs (e.g. data and cut results), by type.
+
+     @details
+     When accounting is enabled, each KTExtensibleStruct object that's constructed is recorded in the account for its type,
+     which is named after the type's sName (e.g. "test-data") or, if it doesn't have one, after its C++ type.
+     Objects are removed from the account when they're destroyed; objects that were constructed while accounting was disabled are never recorded.
+
+     The bytes recorded are the sizes of the objects themselves, plus the memory that they own (e.g. the contents of a std::vector member)
+     for types that override KTExtensibleStructCore::OwnedBytes().  The bookkeeping of the allocator isn't included.
+     Owned memory can change at any time, so it's recorded when it's sampled: when a data object is reset (e.g. when KTDataPool recycles it)
+     and when it's destroyed, the owned bytes of every object in its chain are recorded (see KTExtensibleStructCore::UpdateAccounts()).
+     The peaks therefore include what each data object owned at the end of its use, but not memory that it owned only in between.
+     Samples aren't taken while the data are being processed, since the slots of a parallel group (see KTSignalData) can be modifying them.
+
+     There's no cost beyond checking a flag when accounting is disabled.  When it's enabled, constructing and destroying an object
+     updates a few atomic counters, and sampling a data object calls OwnedBytes() for each object in its chain.
+
+     PrintReport() writes a table of the accounts, ordered by the peak bytes; KTProcessorToolbox prints it at the end of a run
+     when accounting is enabled (see its "account-memory" option), and KTPrintDataStructure can print it for each data object.
+    */
+    class KTMemoryAccounting
+    {
+        public:
+            static bool GetIsEnabled();
+            /// Objects constructed after accounting is enabled are recorded
+            static void SetIsEnabled(bool flag);
+
+            /// Returns the account with the given name, which is made if it doesn't exist; the account lasts for the rest of the program
+            static KTMemoryAccount& GetAccount(const std::string& name, std::size_t objectSize);
+
+            /// Returns all of the accounts, in the order in which they were made
+            static std::vector< const KTMemoryAccount* > GetAccounts();
+
+            /// Total bytes of the objects currently alive, including the bytes they own
+            static std::size_t GetLiveBytes();
+
+            /// Sets the high-water marks of all of the accounts to their current values
+            static void ResetPeaks();
+
+            /// Writes a table of the accounts that have recorded any objects, ordered by peak bytes
+            static void PrintReport(std::ostream& out);
+
+        private:
+            static std::atomic< bool > sIsEnabled;
+    };
+
+
+    inline void KTMemoryAccount::Add()
+    {
+        std::size_t nLive = fNLive.fetch_add(1, std::memory_order_relaxed) + 1;
+        fNCreated.fetch_add(1, std::memory_order_relaxed);
+        std::size_t peak = fPeakNLive.load(std::memory_order_relaxed);
+        while (nLive > peak && ! fPeakNLive.compare_exchange_weak(peak, nLive, std::memory_order_relaxed))
+        {}
+        UpdatePeakBytes();
+        return;
+    }
+
+    inline void KTMemoryAccount::Remove(std::size_t ownedBytes)
+    {
+        fNLive.fetch_sub(1, std::memory_order_relaxed);
+        if (ownedBytes != 0) fOwnedBytes.fetch_sub(ownedBytes, std::memory_order_relaxed);
+        return;
+    }
+
+    inline void KTMemoryAccount::ChangeOwnedBytes(std::size_t previous, std::size_t current)
+    {
+        // unsigned arithmetic wraps, so this also works when the owned bytes shrink
+        fOwnedBytes.fetch_add(current - previous, std::memory_order_relaxed);
+        if (current > previous) UpdatePeakBytes();
+        return;
+    }
+
+    inline void KTMemoryAccount::UpdatePeakBytes()
+    {
+        std::size_t bytes = GetLiveBytes();
+        std::size_t peak = fPeakBytes.load(std::memory_order_relaxed);
+        while (bytes > peak && ! fPeakBytes.compare_exchange_weak(peak, bytes, std::memory_order_relaxed))
+        {}
+        return;
+    }
+
+    inline const std::string& KTMemoryAccount::GetName() const
+    {
+        return fName;
+    }
+
+    inline std::size_t KTMemoryAccount::GetObjectSize() const
+    {
+        return fObjectSize;
+    }
+
+    inline std::size_t KTMemoryAccount::GetNLive() const
+    {
+        return fNLive.load(std::memory_order_relaxed);
+    }
+
+    inline std::size_t KTMemoryAccount::GetPeakNLive() const
+    {
+        return fPeakNLive.load(std::memory_order_relaxed);
+    }
+
+    inline std::size_t KTMemoryAccount::GetOwnedBytes() const
+    {
+        return fOwnedBytes.load(std::memory_order_relaxed);
+    }
+
+    inline std::size_t KTMemoryAccount::GetLiveBytes() const
+    {
+        return GetNLive() * fObjectSize + GetOwnedBytes();
+    }
+
+    inline std::size_t KTMemoryAccount::GetPeakBytes() const
+    {
+        return fPeakBytes.load(std::memory_order_relaxed);
+    }
+
+    inline std::size_t KTMemoryAccount::GetNCreated() const
+    {
+        return fNCreated.load(std::memory_order_relaxed);
+    }
+
+    inline bool KTMemoryAccounting::GetIsEnabled()
+    {
+        return sIsEnabled.load(std::memory_order_relaxed);
+    }
+
+    inline void KTMemoryAccounting::SetIsEnabled(bool flag)
+    {
+        sIsEnabled.store(flag, std::memory_order_relaxed);
+        return;
+    }
+
+} /* namespace Nymph */
+#endif /* KTMEMORYACCOUNTING_HH_ */
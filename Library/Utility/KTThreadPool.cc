@@ -0,0 +1,159 @@
+/*
+ * KTThreadPool.cc
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: nsoblath
+ */
+
+#include "KTThreadPool.hh"
+
+#include "KTLogger.hh"
+
+#include <boost/bind.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+
+namespace Nymph
+{
+    KTLOGGER(poollog, "KTThreadPool");
+
+    // Tasks are claimed by index, so each is run exactly once, by whichever thread gets to it first.
+    // The task vector belongs to the thread in RunAll(), which doesn't return until every task has finished;
+    // a worker that picks up the batch afterwards finds nothing left to claim and never touches the vector.
+    struct KTThreadPool::Batch
+    {
+        const std::vector< Task >* fTasks;
+        unsigned fNTasks;
+        std::atomic< unsigned > fNextTask;
+
+        boost::mutex fMutex;
+        boost::condition_variable fDoneCondition;
+        unsigned fNRemaining;
+        std::exception_ptr fException;
+
+        Batch(const std::vector< Task >* tasks) :
+                fTasks(tasks),
+                fNTasks(tasks->size()),
+                fNextTask(0),
+                fMutex(),
+                fDoneCondition(),
+                fNRemaining(tasks->size()),
+                fException()
+        {}
+    };
+
+    KTThreadPool::KTThreadPool() :
+            fQueue(),
+            fIsStopping(false),
+            fMutex(),
+            fCondition(),
+            fWorkers(),
+            fNWorkers(0)
+    {
+#ifndef SINGLETHREADED
+        unsigned nHardwareThreads = boost::thread::hardware_concurrency();
+        fNWorkers = nHardwareThreads > 1 ? nHardwareThreads - 1 : 1;
+        for (unsigned iWorker = 0; iWorker < fNWorkers; ++iWorker)
+        {
+            fWorkers.create_thread(boost::bind(&KTThreadPool::Work, this));
+        }
+        KTDEBUG(poollog, "Started thread pool with " << fNWorkers << " workers");
+#endif
+    }
+
+    KTThreadPool::~KTThreadPool()
+    {
+        boost::unique_lock< boost::mutex > lock(fMutex);
+        fIsStopping = true;
+        lock.unlock();
+        fCondition.notify_all();
+        fWorkers.join_all();
+    }
+
+    void KTThreadPool::RunAll(const std::vector< Task >& tasks)
+    {
+        if (tasks.empty()) return;
+
+        if (fNWorkers == 0 || tasks.size() == 1)
+        {
+            for (std::vector< Task >::const_iterator it = tasks.begin(); it != tasks.end(); ++it)
+            {
+                (*it)();
+            }
+            return;
+        }
+
+        BatchPtr batch(new Batch(&tasks));
+
+        // one worker per task beyond the one this thread will start with
+        unsigned nHelpers = std::min< unsigned >(fNWorkers, tasks.size() - 1);
+        boost::unique_lock< boost::mutex > poolLock(fMutex);
+        for (unsigned iHelper = 0; iHelper < nHelpers; ++iHelper)
+        {
+            fQueue.push_back(batch);
+        }
+        poolLock.unlock();
+        fCondition.notify_all();
+
+        Help(*batch);
+
+        boost::unique_lock< boost::mutex > batchLock(batch->fMutex);
+        while (batch->fNRemaining != 0)
+        {
+            batch->fDoneCondition.wait(batchLock);
+        }
+        if (batch->fException)
+        {
+            std::rethrow_exception(batch->fException);
+        }
+        return;
+    }
+
+    void KTThreadPool::Help(Batch& batch)
+    {
+        unsigned iTask = batch.fNextTask.fetch_add(1);
+        while (iTask < batch.fNTasks)
+        {
+            std::exception_ptr exception;
+            try
+            {
+                (*batch.fTasks)[iTask]();
+            }
+            catch (...)
+            {
+                exception = std::current_exception();
+            }
+
+            boost::unique_lock< boost::mutex > lock(batch.fMutex);
+            if (exception && ! batch.fException) batch.fException = exception;
+            if (--batch.fNRemaining == 0) batch.fDoneCondition.notify_all();
+            lock.unlock();
+
+            iTask = batch.fNextTask.fetch_add(1);
+        }
+        return;
+    }
+
+    void KTThreadPool::Work()
+    {
+        while (true)
+        {
+            boost::unique_lock< boost::mutex > lock(fMutex);
+            while (fQueue.empty() && ! fIsStopping)
+            {
+                fCondition.wait(lock);
+            }
+            if (fIsStopping) break;
+
+            BatchPtr batch = fQueue.front();
+            fQueue.pop_front();
+            lock.unlock();
+
+            Help(*batch);
+        }
+        return;
+    }
+
+} /* namespace Nymph */
@@ -0,0 +1,81 @@
+/*
+ * KTThreadPool.hh
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: nsoblath
+ */
+
+#ifndef KTTHREADPOOL_HH_
+#define KTTHREADPOOL_HH_
+
+#include "singleton.hh"
+
+#include <boost/function.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread.hpp>
+
+#include <deque>
+#include <vector>
+
+namespace Nymph
+{
+    /*!
+     @class KTThreadPool
+     @author N. S. Oblath
+
+     @brief Shared pool of worker threads used to run sets of independent tasks concurrently.
+
+     @details
+     RunAll() executes a set of tasks and returns once all of them have finished.
+     The calling thread works on the tasks too, so a task may itself call RunAll() without any risk of
+     the pool's threads all waiting on one another.
+
+     The pool is created on first use, with one worker thread fewer than the number of hardware threads.
+
+     In single-threaded mode there are no worker threads, and the tasks are run sequentially on the calling thread.
+    */
+    class KTThreadPool : public scarab::singleton< KTThreadPool >
+    {
+        public:
+            typedef boost::function< void () > Task;
+
+        private:
+            friend class scarab::singleton< KTThreadPool >;
+            friend class scarab::destroyer< KTThreadPool >;
+
+            KTThreadPool();
+            virtual ~KTThreadPool();
+
+        public:
+            /// Runs all of the tasks and returns when they have finished.
+            /// If any of the tasks throws an exception, the first exception thrown is rethrown once all of the tasks have finished.
+            void RunAll(const std::vector< Task >& tasks);
+
+            /// Number of worker threads (not counting the threads that call RunAll())
+            unsigned GetNWorkers() const;
+
+        private:
+            struct Batch;
+            typedef boost::shared_ptr< Batch > BatchPtr;
+
+            /// Claims and runs tasks from the batch until none are left unclaimed
+            static void Help(Batch& batch);
+
+            void Work();
+
+            std::deque< BatchPtr > fQueue;
+            bool fIsStopping;
+            boost::mutex fMutex;
+            boost::condition_variable fCondition;
+
+            boost::thread_group fWorkers;
+            unsigned fNWorkers;
+    };
+
+    inline unsigned KTThreadPool::GetNWorkers() const
+    {
+        return fNWorkers;
+    }
+
+} /* namespace Nymph */
+#endif /* KTTHREADPOOL_HH_ */